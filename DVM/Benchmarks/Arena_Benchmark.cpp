@@ -0,0 +1,69 @@
+#include <cstdint>
+
+#include "Benchmark.h"
+#include "../Headers/Arena.h"
+#include "../Headers/DynMatrix_Math.h"
+
+//Scratch memory from the heap against ThreadArena(): four work vectors per call, the pattern of the solvers and
+//decompositions, then Solve on a small DynMatrix whose LU workspace comes from the arena
+namespace
+{
+	constexpr size_t ScratchCount = 256;
+
+	const DVM::DynMatrixd& Operand()
+	{
+		static DVM::DynMatrixd matrix = []
+		{
+			DVM::DynMatrixd result(8, 8);
+			uint32_t seed = 5u;
+			for (size_t i = 0; i < result.Size(); ++i)
+				result.Data()[i] = DVM::Bench::Random<double>(seed, -1., 1.);
+			for (size_t i = 0; i < 8; ++i)
+				result[i][i] += 8.;
+			return result;
+		}();
+
+		return matrix;
+	}
+}
+
+DVM_BENCHMARK(BM_Arena_Scratch_Heap)
+{
+	state.SetItemsPerIteration(4);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		double* vectors[4];
+		for (double*& vector : vectors)
+		{
+			vector = static_cast<double*>(DVTL::AlignedAlloc(ScratchCount * sizeof(double)));
+			vector[0] = 1.;
+		}
+		DVM::Bench::DoNotOptimize(vectors[3][0]);
+		for (double* vector : vectors)
+			DVTL::AlignedFree(vector);
+	}
+}
+
+DVM_BENCHMARK_BASELINE(BM_Arena_Scratch_Arena, BM_Arena_Scratch_Heap)
+{
+	state.SetItemsPerIteration(4);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::ArenaScope scratch;
+		double* vectors[4];
+		for (double*& vector : vectors)
+		{
+			vector = scratch.Allocate<double>(ScratchCount);
+			vector[0] = 1.;
+		}
+		DVM::Bench::DoNotOptimize(vectors[3][0]);
+	}
+}
+
+DVM_BENCHMARK(BM_Arena_Solve_DynMatrix_8)
+{
+	DVM::DynVectord vec(8, 1.);
+	state.SetItemsPerIteration(1);
+	for (size_t i = 0; i < state.iterations; ++i)
+		DVM::Bench::DoNotOptimize(DVM::Solve(Operand(), vec)[0]);
+}
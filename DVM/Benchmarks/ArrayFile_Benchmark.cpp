@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/ArrayFile.h"
+
+//ArrayFile against the text round trip of DVM.cpp's printMat, 1 << 18 Vec3f (3 MB) per run.
+//Files go to the working directory and are removed afterwards, so the timings include the page cache but not the disk
+namespace
+{
+	constexpr size_t ElementCount = size_t(1) << 18;
+	const char* const TextPath = "DVM_ArrayFile_Benchmark.txt";
+	const char* const BinaryPath = "DVM_ArrayFile_Benchmark.dvma";
+
+	const std::vector<DVM::Vec3f>& Elements()
+	{
+		static std::vector<DVM::Vec3f> elements = []
+		{
+			std::vector<DVM::Vec3f> result(ElementCount);
+			uint32_t seed = 7u;
+			for (DVM::Vec3f& element : result)
+				for (size_t j = 0; j < 3; ++j)
+					element[j] = DVM::Bench::Random<float>(seed, -100.f, 100.f);
+			return result;
+		}();
+
+		return elements;
+	}
+
+	void WriteText(const char* path)
+	{
+		std::ofstream file(path);
+		file.precision(9);
+		for (const DVM::Vec3f& element : Elements())
+			file << element[0] << " " << element[1] << " " << element[2] << "\n";
+	}
+
+	float ReadText(const char* path)
+	{
+		std::ifstream file(path);
+		std::vector<DVM::Vec3f> elements(ElementCount);
+		for (DVM::Vec3f& element : elements)
+			file >> element[0] >> element[1] >> element[2];
+		return elements.back()[2];
+	}
+}
+
+DVM_BENCHMARK(BM_ArrayFile_Write_Text)
+{
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+		WriteText(TextPath);
+	std::remove(TextPath);
+}
+
+DVM_BENCHMARK_BASELINE(BM_ArrayFile_Write_Binary, BM_ArrayFile_Write_Text)
+{
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+		DVM::Bench::DoNotOptimize(DVM::WriteArrayFile(BinaryPath, Elements().data(), ElementCount));
+	std::remove(BinaryPath);
+}
+
+DVM_BENCHMARK(BM_ArrayFile_Read_Text)
+{
+	WriteText(TextPath);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+		DVM::Bench::DoNotOptimize(ReadText(TextPath));
+	std::remove(TextPath);
+}
+
+//Open, touch every element and close, the pages come from the page cache
+DVM_BENCHMARK_BASELINE(BM_ArrayFile_Read_Mapped, BM_ArrayFile_Read_Text)
+{
+	DVM::WriteArrayFile(BinaryPath, Elements().data(), ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::MappedArray<DVM::Vec3f> mapped;
+		mapped.Open(BinaryPath);
+
+		float sum = 0.f;
+		for (const DVM::Vec3f& element : mapped)
+			sum += element[2];
+		DVM::Bench::DoNotOptimize(sum);
+	}
+	std::remove(BinaryPath);
+}
+
+//Chunks of 4096 elements into one reused buffer
+DVM_BENCHMARK_BASELINE(BM_ArrayFile_Read_Streaming, BM_ArrayFile_Read_Text)
+{
+	DVM::WriteArrayFile(BinaryPath, Elements().data(), ElementCount);
+	std::vector<DVM::Vec3f> buffer(4096);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::ArrayFileReader<DVM::Vec3f> reader;
+		reader.Open(BinaryPath);
+
+		float sum = 0.f;
+		size_t count;
+		while ((count = reader.Read(buffer.data(), buffer.size())) != 0)
+			for (size_t j = 0; j < count; ++j)
+				sum += buffer[j][2];
+		DVM::Bench::DoNotOptimize(sum);
+	}
+	std::remove(BinaryPath);
+}
@@ -0,0 +1,161 @@
+#ifndef DVM_BENCHMARK_H
+#define DVM_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DVM
+{
+	namespace Bench
+	{
+		struct State
+		{
+			size_t iterations = 1;
+			size_t itemsPerIteration = 1;
+			std::vector<std::pair<std::string, double>> counters;
+
+			void SetItemsPerIteration(size_t items) { itemsPerIteration = items; }
+
+			//Extra values reported next to the timing, e.g. accuracy
+			void Counter(const std::string& name, double value)
+			{
+				for (auto& counter : counters)
+					if (counter.first == name) { counter.second = value; return; }
+
+				counters.emplace_back(name, value);
+			}
+		};
+
+		using Function = std::function<void(State&)>;
+
+		struct Benchmark
+		{
+			std::string name;
+			Function function;
+			//Name of an earlier benchmark the speedup is reported against, empty for none
+			std::string baseline;
+		};
+
+		inline std::vector<Benchmark>& Registry()
+		{
+			static std::vector<Benchmark> benchmarks;
+			return benchmarks;
+		}
+
+		struct Registrar
+		{
+			Registrar(const char* name, Function function) { Registry().push_back({ name, function, "" }); }
+
+			Registrar(const std::string& name, Function function, const std::string& baseline) { Registry().push_back({ name, function, baseline }); }
+		};
+
+		//Uniform value in [low, high) from a linear congruential generator, so operands are the same on every run
+		template<typename T>
+		inline T Random(uint32_t& seed, double low, double high)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			return static_cast<T>(low + (high - low) * (seed / 4294967296.));
+		}
+
+		//Suffix of the DVM typedefs for element type T, e.g. "f" for Vec3f and Mat3f
+		template<typename T> const char* TypeSuffix();
+		template<> inline const char* TypeSuffix<int>()						{ return "i"; }
+		template<> inline const char* TypeSuffix<char>()					{ return "c"; }
+		template<> inline const char* TypeSuffix<float>()					{ return "f"; }
+		template<> inline const char* TypeSuffix<double>()					{ return "d"; }
+		template<> inline const char* TypeSuffix<short int>()				{ return "si"; }
+		template<> inline const char* TypeSuffix<long double>()				{ return "ld"; }
+		template<> inline const char* TypeSuffix<unsigned int>()			{ return "ui"; }
+		template<> inline const char* TypeSuffix<unsigned char>()			{ return "uc"; }
+		template<> inline const char* TypeSuffix<long long int>()			{ return "lli"; }
+		template<> inline const char* TypeSuffix<unsigned short int>()		{ return "usi"; }
+		template<> inline const char* TypeSuffix<unsigned long long int>()	{ return "ulli"; }
+
+		template<typename T> struct Type { using type = T; };
+
+		//Calls function(Type<T>()) for every element type with DVM typedefs, for templated registrations
+		template<typename F>
+		inline void ForEachElementType(F function)
+		{
+			function(Type<int>());
+			function(Type<char>());
+			function(Type<float>());
+			function(Type<double>());
+			function(Type<short int>());
+			function(Type<long double>());
+			function(Type<unsigned int>());
+			function(Type<unsigned char>());
+			function(Type<long long int>());
+			function(Type<unsigned short int>());
+			function(Type<unsigned long long int>());
+		}
+
+		//Keeps the compiler from discarding a result that is never used
+		template<typename T>
+		inline void DoNotOptimize(const T& value)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "r,m"(value) : "memory");
+#else
+			static volatile const T* sink;
+			sink = &value;
+#endif
+		}
+
+		struct Result
+		{
+			std::string name;
+			size_t iterations;
+			double nsPerIteration;
+			double nsPerItem;
+			double itemsPerSecond;
+			std::vector<std::pair<std::string, double>> counters;
+		};
+
+		//Grows the iteration count until one run takes at least minTime seconds
+		inline Result Run(const Benchmark& benchmark, double minTime)
+		{
+			State state;
+			double seconds = 0.;
+
+			while (true)
+			{
+				auto start = std::chrono::steady_clock::now();
+				benchmark.function(state);
+				seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				if (seconds >= minTime || state.iterations >= (size_t(1) << 40)) break;
+
+				double scale = seconds > 0. ? 1.4 * minTime / seconds : 10.;
+				scale = scale < 10. ? (scale > 1.5 ? scale : 1.5) : 10.;
+				state.iterations = static_cast<size_t>(state.iterations * scale) + 1;
+			}
+
+			Result result;
+			result.name = benchmark.name;
+			result.iterations = state.iterations;
+			result.nsPerIteration = seconds * 1e9 / state.iterations;
+			result.nsPerItem = result.nsPerIteration / state.itemsPerIteration;
+			result.itemsPerSecond = 1e9 / result.nsPerItem;
+			result.counters = state.counters;
+			return result;
+		}
+	}
+}
+
+#define DVM_BENCHMARK(name)																\
+	static void name(DVM::Bench::State& state);											\
+	static DVM::Bench::Registrar name##_registrar(#name, name);							\
+	static void name(DVM::Bench::State& state)
+
+//Same as DVM_BENCHMARK, the speedup over the benchmark named baseline is reported next to the result
+#define DVM_BENCHMARK_BASELINE(name, baseline)											\
+	static void name(DVM::Bench::State& state);											\
+	static DVM::Bench::Registrar name##_registrar(#name, name, #baseline);				\
+	static void name(DVM::Bench::State& state)
+
+#endif // !DVM_BENCHMARK_H
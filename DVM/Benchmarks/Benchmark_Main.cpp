@@ -0,0 +1,177 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Math.h"
+#include "../Headers/SIMD.h"
+
+namespace
+{
+	struct Report
+	{
+		DVM::Bench::Result result;
+		std::string baseline;
+		double speedup;
+	};
+
+	std::string JsonString(const std::string& text)
+	{
+		std::string result = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\') result += '\\';
+			result += c;
+		}
+		return result + "\"";
+	}
+
+	const char* SimdLevel()
+	{
+#if defined(DVM_SIMD_AVX2)
+		return "AVX2";
+#elif defined(DVM_SIMD_AVX)
+		return "AVX";
+#elif defined(DVM_SIMD_SSE2)
+		return "SSE2";
+#else
+		return "none";
+#endif
+	}
+
+	const char* Compiler()
+	{
+#if defined(__clang__)
+		return "clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc";
+#else
+		return "unknown";
+#endif
+	}
+
+	//Same layout for every run, so two files can be diffed or compared by name between releases
+	void WriteJson(std::FILE* file, const std::vector<Report>& reports, double minTime)
+	{
+		char date[32];
+		std::time_t now = std::time(nullptr);
+		std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+		std::fprintf(file, "{\n  \"context\": {\n");
+		std::fprintf(file, "    \"date\": \"%s\",\n", date);
+		std::fprintf(file, "    \"compiler\": %s,\n", JsonString(Compiler()).c_str());
+		std::fprintf(file, "    \"simd\": \"%s\",\n", SimdLevel());
+#if defined(NDEBUG)
+		std::fprintf(file, "    \"assertions\": false,\n");
+#else
+		std::fprintf(file, "    \"assertions\": true,\n");
+#endif
+		std::fprintf(file, "    \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+		std::fprintf(file, "    \"min_time\": %g\n  },\n  \"benchmarks\": [", minTime);
+
+		for (size_t i = 0; i < reports.size(); ++i)
+		{
+			const DVM::Bench::Result& result = reports[i].result;
+
+			std::fprintf(file, "%s\n    {\n", i ? "," : "");
+			std::fprintf(file, "      \"name\": %s,\n", JsonString(result.name).c_str());
+			std::fprintf(file, "      \"iterations\": %zu,\n", result.iterations);
+			std::fprintf(file, "      \"ns_per_iteration\": %.6g,\n", result.nsPerIteration);
+			std::fprintf(file, "      \"ns_per_op\": %.6g,\n", result.nsPerItem);
+			std::fprintf(file, "      \"items_per_second\": %.6g", result.itemsPerSecond);
+
+			for (const auto& counter : result.counters)
+				std::fprintf(file, ",\n      %s: %.6g", JsonString(counter.first).c_str(), counter.second);
+
+			if (reports[i].speedup > 0.)
+				std::fprintf(file, ",\n      \"baseline\": %s,\n      \"speedup\": %.4g", JsonString(reports[i].baseline).c_str(), reports[i].speedup);
+
+			std::fprintf(file, "\n    }");
+		}
+
+		std::fprintf(file, "\n  ]\n}\n");
+	}
+}
+
+//Build: the DVM_Benchmarks target of the CMake project, or g++ -std=c++17 -O2 -pthread Benchmarks/*.cpp -o DVM_Benchmarks (from the DVM directory)
+//Usage: DVM_Benchmarks [--filter=substring] [--min_time=seconds] [--format=console|json] [--out=file.json]
+//--format=json prints JSON instead of the table, --out writes JSON to a file next to the table.
+//Built with DVM_INSTRUMENTATION the counters of Instrumentation.h are printed to stderr at the end
+int main(int argc, char** argv)
+{
+	const char* filter = "";
+	const char* outPath = nullptr;
+	double minTime = 0.2;
+	bool json = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!std::strncmp(argv[i], "--filter=", 9)) filter = argv[i] + 9;
+		else if (!std::strncmp(argv[i], "--min_time=", 11)) minTime = std::atof(argv[i] + 11);
+		else if (!std::strcmp(argv[i], "--format=json")) json = true;
+		else if (!std::strcmp(argv[i], "--format=console")) json = false;
+		else if (!std::strncmp(argv[i], "--out=", 6)) outPath = argv[i] + 6;
+		else
+		{
+			std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	if (!json)
+		std::printf("%-48s %14s %12s %14s\n", "Benchmark", "Iterations", "ns/op", "items/s");
+
+	std::vector<Report> reports;
+
+	for (const DVM::Bench::Benchmark& benchmark : DVM::Bench::Registry())
+	{
+		if (!std::strstr(benchmark.name.c_str(), filter)) continue;
+
+		Report report{ DVM::Bench::Run(benchmark, minTime), benchmark.baseline, 0. };
+		const DVM::Bench::Result& result = report.result;
+
+		//The baseline has to run first, a filter that skips it skips the speedup too
+		for (const Report& previous : reports)
+			if (previous.result.name == benchmark.baseline)
+				report.speedup = previous.result.nsPerIteration / result.nsPerIteration;
+
+		if (!json)
+		{
+			std::printf("%-48s %14zu %12.3f %14.4g", result.name.c_str(), result.iterations, result.nsPerItem, result.itemsPerSecond);
+			for (const auto& counter : result.counters)
+				std::printf("  %s=%g", counter.first.c_str(), counter.second);
+			if (report.speedup > 0.)
+				std::printf("  speedup=%.2f", report.speedup);
+			std::printf("\n");
+		}
+
+		reports.push_back(report);
+	}
+
+	if (json)
+		WriteJson(stdout, reports, minTime);
+
+	if (outPath)
+	{
+		std::FILE* file = std::fopen(outPath, "w");
+		if (!file)
+		{
+			std::fprintf(stderr, "cannot write %s\n", outPath);
+			return 1;
+		}
+		WriteJson(file, reports, minTime);
+		std::fclose(file);
+	}
+
+#if defined(DVM_INSTRUMENTATION)
+	DVM::Instrumentation::Report(std::cerr);
+#endif
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+#include "../Headers/Matrix_Math.h"
+
+//A table of rotations computed by the compiler. It is constant initialized, so it is stored in the
+//binary and nothing runs at startup
+namespace
+{
+	constexpr size_t RotationCount = 4096;
+
+	struct RotationTable
+	{
+		DVM::Mat4f rotations[RotationCount];
+	};
+
+	constexpr DVM::Vec3f RotationAxis(1.f / 3.f, 2.f / 3.f, 2.f / 3.f);
+
+	constexpr float RotationAngle(size_t index) { return 2.f * DVM::getPi<float>() * static_cast<float>(index) / static_cast<float>(RotationCount); }
+
+	constexpr RotationTable MakeRotationTable()
+	{
+		RotationTable table{};
+
+		for (size_t i = 0; i < RotationCount; ++i)
+			table.rotations[i] = DVM::Rotation(RotationAngle(i), RotationAxis);
+
+		return table;
+	}
+
+	constexpr RotationTable rotationTable = MakeRotationTable();
+
+	constexpr float MaxDifference(const DVM::Mat4f& matX, const DVM::Mat4f& matY)
+	{
+		float result = 0.f;
+		for (size_t i = 0; i < matX.Size(); ++i)
+			result = DVM::Max(result, DVM::Abs(matX.data[i] - matY.data[i]));
+		return result;
+	}
+
+	//Rotations are orthonormal, checked on one entry while compiling
+	constexpr DVM::Mat4f rotation = rotationTable.rotations[1000];
+	static_assert(rotationTable.rotations[0][0][0] == 1.f, "Rotation by zero must be the identity");
+	static_assert(DVM::Abs(DVM::Determinant(rotation) - 1.f) < 1e-5f, "Rotation must keep volume");
+	static_assert(MaxDifference(DVM::Inverse(rotation), DVM::Transpose(rotation)) < 1e-5f, "Inverse of a rotation must be its transpose");
+	static_assert(MaxDifference(DVM::matrixMultiplication(rotation, DVM::Transpose(rotation)), DVM::Mat4f(1.f)) < 1e-5f, "Rotation times its transpose must be the identity");
+
+	//Items are rotated vectors
+	template<typename F>
+	void RunRotations(DVM::Bench::State& state, F rotation)
+	{
+		DVM::Vec4f vec(1.f, 0.f, 0.f, 1.f);
+		state.SetItemsPerIteration(RotationCount);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+			for (size_t j = 0; j < RotationCount; ++j)
+				DVM::Bench::DoNotOptimize(DVM::linearTransformation(rotation(j), vec));
+	}
+}
+
+DVM_BENCHMARK(BM_Rotation_Runtime)
+{
+	RunRotations(state, [](size_t index) { return DVM::Rotation(RotationAngle(index), RotationAxis); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Rotation_ConstexprTable, BM_Rotation_Runtime)
+{
+	RunRotations(state, [](size_t index) -> const DVM::Mat4f& { return rotationTable.rotations[index]; });
+}
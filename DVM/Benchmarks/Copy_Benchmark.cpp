@@ -0,0 +1,63 @@
+#include <cstring>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Matrix.h"
+#include "../Headers/Vector.h"
+
+//Array copies of trivially copyable vectors and matrices against a raw memcpy of the same bytes.
+//A speedup near 1 means the copy compiled down to memcpy
+namespace
+{
+	constexpr size_t CopyCount = 4096;
+
+	template<typename V>
+	struct CopyOperands
+	{
+		std::vector<V> source = std::vector<V>(CopyCount);
+		std::vector<V> destination = std::vector<V>(CopyCount);
+	};
+
+	template<typename V>
+	CopyOperands<V>& GetCopyOperands()
+	{
+		static CopyOperands<V> operands;
+		return operands;
+	}
+
+	template<typename V, typename F>
+	void RunCopy(DVM::Bench::State& state, F copy)
+	{
+		CopyOperands<V>& operands = GetCopyOperands<V>();
+		state.SetItemsPerIteration(CopyCount);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			copy(operands.source, operands.destination);
+			DVM::Bench::DoNotOptimize(operands.destination.data());
+		}
+	}
+}
+
+#define DVM_COPY_BENCHMARK(V)																					\
+	DVM_BENCHMARK(BM_Copy_##V##_memcpy)																			\
+	{																											\
+		RunCopy<DVM::V>(state, [](const auto& source, auto& destination)										\
+			{ std::memcpy(destination.data(), source.data(), source.size() * sizeof(DVM::V)); });				\
+	}																											\
+	DVM_BENCHMARK_BASELINE(BM_Copy_##V##_Loop, BM_Copy_##V##_memcpy)											\
+	{																											\
+		RunCopy<DVM::V>(state, [](const auto& source, auto& destination)										\
+			{ for (size_t i = 0; i < source.size(); ++i) destination[i] = source[i]; });						\
+	}																											\
+	DVM_BENCHMARK_BASELINE(BM_Copy_##V##_VectorAssign, BM_Copy_##V##_memcpy)									\
+	{																											\
+		RunCopy<DVM::V>(state, [](const auto& source, auto& destination) { destination = source; });			\
+	}
+
+DVM_COPY_BENCHMARK(Vec3f)
+DVM_COPY_BENCHMARK(Vec4f)
+DVM_COPY_BENCHMARK(Vec4d)
+DVM_COPY_BENCHMARK(Mat3f)
+DVM_COPY_BENCHMARK(Mat4f)
+DVM_COPY_BENCHMARK(Mat4d)
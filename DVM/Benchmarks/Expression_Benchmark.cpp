@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Matrix.h"
+#include "../Headers/Vector.h"
+
+//a * s + b * t - c over arrays of operands. Build once as is and once with -DDVM_EXPRESSION_TEMPLATES
+//to compare the eager operators with the fused expression
+namespace
+{
+	template<typename V>
+	struct ChainOperands
+	{
+		std::vector<V> a, b, c, result;
+	};
+
+	template<typename V, typename T>
+	ChainOperands<V>& GetChainOperands(size_t count)
+	{
+		static ChainOperands<V> operands = [count]
+		{
+			ChainOperands<V> result{ std::vector<V>(count), std::vector<V>(count), std::vector<V>(count), std::vector<V>(count) };
+			uint32_t seed = 99u;
+
+			for (size_t i = 0; i < count; ++i)
+				for (size_t j = 0; j < result.a[i].Size(); ++j)
+				{
+					seed = seed * 1664525u + 1013904223u;
+					result.a[i].data[j] = static_cast<T>(seed / 4294967296.);
+					result.b[i].data[j] = static_cast<T>(seed / 8589934592.);
+					result.c[i].data[j] = static_cast<T>(seed / 17179869184.);
+				}
+			return result;
+		}();
+
+		return operands;
+	}
+
+	//Items are vectors or matrices written
+	template<typename V, typename T>
+	void RunChain(DVM::Bench::State& state)
+	{
+		ChainOperands<V>& operands = GetChainOperands<V, T>(1024);
+		T s = static_cast<T>(1.5);
+		T t = static_cast<T>(0.5);
+		state.SetItemsPerIteration(operands.result.size());
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			for (size_t j = 0; j < operands.result.size(); ++j)
+				operands.result[j] = operands.a[j] * s + operands.b[j] * t - operands.c[j];
+			DVM::Bench::DoNotOptimize(operands.result.data());
+		}
+	}
+}
+
+DVM_BENCHMARK(BM_Chain_Vec3f)
+{
+	RunChain<DVM::Vec3f, float>(state);
+}
+
+DVM_BENCHMARK(BM_Chain_Vec4f)
+{
+	RunChain<DVM::Vec4f, float>(state);
+}
+
+DVM_BENCHMARK(BM_Chain_Vec4d)
+{
+	RunChain<DVM::Vec4d, double>(state);
+}
+
+DVM_BENCHMARK(BM_Chain_Mat4f)
+{
+	RunChain<DVM::Mat4f, float>(state);
+}
+
+DVM_BENCHMARK(BM_Chain_Mat4d)
+{
+	RunChain<DVM::Mat4d, double>(state);
+}
@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Half.h"
+
+//Element by element conversion against the batch functions, 1 << 16 floats per run
+namespace
+{
+	constexpr size_t ElementCount = size_t(1) << 16;
+
+	const std::vector<float>& Floats()
+	{
+		static std::vector<float> floats = []
+		{
+			std::vector<float> result(ElementCount);
+			uint32_t seed = 11u;
+			for (float& value : result)
+				value = DVM::Bench::Random<float>(seed, -1000.f, 1000.f);
+			return result;
+		}();
+
+		return floats;
+	}
+
+	template<typename T>
+	const std::vector<T>& Converted()
+	{
+		static std::vector<T> converted(Floats().begin(), Floats().end());
+		return converted;
+	}
+}
+
+DVM_BENCHMARK(BM_Half_ToHalf_Scalar)
+{
+	std::vector<DVM::Half> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		for (size_t j = 0; j < ElementCount; ++j)
+			out[j] = DVM::Half(Floats()[j]);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1].bits);
+	}
+}
+
+DVM_BENCHMARK_BASELINE(BM_Half_ToHalf_Batch, BM_Half_ToHalf_Scalar)
+{
+	std::vector<DVM::Half> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::ToHalfBatch(Floats().data(), out.data(), ElementCount);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1].bits);
+	}
+}
+
+DVM_BENCHMARK(BM_Half_ToFloat_Scalar)
+{
+	const std::vector<DVM::Half>& in = Converted<DVM::Half>();
+	std::vector<float> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		for (size_t j = 0; j < ElementCount; ++j)
+			out[j] = float(in[j]);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1]);
+	}
+}
+
+DVM_BENCHMARK_BASELINE(BM_Half_ToFloat_Batch, BM_Half_ToFloat_Scalar)
+{
+	const std::vector<DVM::Half>& in = Converted<DVM::Half>();
+	std::vector<float> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::ToFloatBatch(in.data(), out.data(), ElementCount);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1]);
+	}
+}
+
+DVM_BENCHMARK(BM_Half_ToBFloat16_Scalar)
+{
+	std::vector<DVM::BFloat16> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		for (size_t j = 0; j < ElementCount; ++j)
+			out[j] = DVM::BFloat16(Floats()[j]);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1].bits);
+	}
+}
+
+DVM_BENCHMARK_BASELINE(BM_Half_ToBFloat16_Batch, BM_Half_ToBFloat16_Scalar)
+{
+	std::vector<DVM::BFloat16> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::ToBFloat16Batch(Floats().data(), out.data(), ElementCount);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1].bits);
+	}
+}
+
+DVM_BENCHMARK(BM_Half_BFloat16ToFloat_Scalar)
+{
+	const std::vector<DVM::BFloat16>& in = Converted<DVM::BFloat16>();
+	std::vector<float> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		for (size_t j = 0; j < ElementCount; ++j)
+			out[j] = float(in[j]);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1]);
+	}
+}
+
+DVM_BENCHMARK_BASELINE(BM_Half_BFloat16ToFloat_Batch, BM_Half_BFloat16ToFloat_Scalar)
+{
+	const std::vector<DVM::BFloat16>& in = Converted<DVM::BFloat16>();
+	std::vector<float> out(ElementCount);
+	state.SetItemsPerIteration(ElementCount);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		DVM::ToFloatBatch(in.data(), out.data(), ElementCount);
+		DVM::Bench::DoNotOptimize(out[ElementCount - 1]);
+	}
+}
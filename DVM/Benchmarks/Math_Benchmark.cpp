@@ -0,0 +1,524 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Math.h"
+#include "../Headers/Math_Batch.h"
+
+namespace
+{
+	//The Newton loop Sqrt used before the hardware path, kept as the baseline
+	template <typename T>
+	T LegacySqrt(T value)
+	{
+		if (value < T(0)) return T(0);
+		if (value < T(1)) return T(1) / LegacySqrt(T(1) / value);
+
+		T result = value;
+		T epsilon = DVM::getEpsilon<T>() * value;
+
+		for (int i = 0; i < 520 && (result * result - value) > epsilon; ++i)
+			result = T(0.5) * (result + value / result);
+
+		return result;
+	}
+
+	//Floor and Round before the branch free versions, truncation through long long, kept as the baseline
+	template<typename T>
+	T LegacyFloor(T value) { return static_cast<T>(static_cast<long long>(value)); }
+
+	template<typename T>
+	T LegacyRound(T value)
+	{
+		T floor = LegacyFloor(value);
+		if (value - floor > T(0.5)) return static_cast<T>(static_cast<long long>(value + 1));
+		else return floor;
+	}
+
+	//Pow and Exp2 before exponentiation by squaring, one multiply per unit of exponent, kept as the baseline
+	template<typename T>
+	T LegacyPow(T base, int exp)
+	{
+		T result = 1;
+		for (; exp > 0; --exp)
+			result *= base;
+		return result;
+	}
+
+	inline int LegacyExp2(int x)
+	{
+		if (x < 0) return 0;
+
+		int result = 1;
+		for (int i = 0; i < x; ++i)
+			result *= 2;
+		return result;
+	}
+
+	//Log-uniform inputs over most of the exponent range of T
+	template<typename T>
+	const std::vector<T>& Inputs()
+	{
+		static std::vector<T> values = []
+		{
+			std::vector<T> result(4096);
+			double maxExponent = std::numeric_limits<T>::max_exponent10 - 1;
+			uint32_t seed = 12345u;
+
+			for (T& value : result)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				double exponent = (seed / 4294967296.0 * 2. - 1.) * maxExponent;
+				value = static_cast<T>(std::pow(10., exponent));
+			}
+			return result;
+		}();
+
+		return values;
+	}
+
+	inline int64_t OrderedBits(float value) { int32_t bits; std::memcpy(&bits, &value, 4); return bits; }
+	inline int64_t OrderedBits(double value) { int64_t bits; std::memcpy(&bits, &value, 8); return bits; }
+
+	//Bit pattern of the smallest positive normal and of infinity
+	template<typename T>
+	constexpr uint64_t NormalBits() { return sizeof(T) == 4 ? 0x00800000ull : 0x0010000000000000ull; }
+
+	template<typename T>
+	constexpr uint64_t InfinityBits() { return sizeof(T) == 4 ? 0x7F800000ull : 0x7FF0000000000000ull; }
+
+	//Max distance in units in the last place from the correctly rounded result over the positive inputs with bit
+	//patterns in [first, last), all finite ones by default
+	template<typename T, typename F>
+	double MaxUlpError(F function, uint64_t first = 1, uint64_t last = InfinityBits<T>())
+	{
+		double maxError = 0.;
+		uint64_t step = (last - first) / 200003u + 1;
+
+		for (uint64_t bits = first; bits < last; bits += step)
+		{
+			T value;
+			if constexpr (sizeof(T) == 4) { uint32_t narrow = static_cast<uint32_t>(bits); std::memcpy(&value, &narrow, 4); }
+			else std::memcpy(&value, &bits, 8);
+
+			//float is rounded once from the exact double result, double sqrt is correctly rounded itself
+			T reference = static_cast<T>(std::sqrt(static_cast<double>(value)));
+			double error = static_cast<double>(OrderedBits(function(value)) - OrderedBits(reference));
+			maxError = std::fmax(maxError, std::fabs(error));
+		}
+
+		return maxError;
+	}
+
+	//Uniform inputs in [-80, 80], inside the finite range of Exp for float and double
+	template<typename T>
+	const std::vector<T>& ExpInputs()
+	{
+		static std::vector<T> values = []
+		{
+			std::vector<T> result(4096);
+			uint32_t seed = 54321u;
+
+			for (T& value : result)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				value = static_cast<T>((seed / 4294967296. * 2. - 1.) * 80.);
+			}
+			return result;
+		}();
+
+		return values;
+	}
+
+	//Uniform in [0.999, 1.001], powers up to 1000 stay normal
+	template<typename T>
+	const std::vector<T>& NearOneInputs()
+	{
+		static std::vector<T> values = []
+		{
+			std::vector<T> result(4096);
+			uint32_t seed = 24680u;
+
+			for (T& value : result)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				value = static_cast<T>(1. + (seed / 4294967296. * 2. - 1.) * 0.001);
+			}
+			return result;
+		}();
+
+		return values;
+	}
+
+	//Exponents in [0, 30], every power of two fits an int
+	inline const std::vector<int>& ShiftInputs()
+	{
+		static std::vector<int> values = []
+		{
+			std::vector<int> result(4096);
+			uint32_t seed = 13579u;
+
+			for (int& value : result)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				value = static_cast<int>(seed % 31u);
+			}
+			return result;
+		}();
+
+		return values;
+	}
+
+	template<typename T, typename F>
+	void RunScalar(DVM::Bench::State& state, const std::vector<T>& values, F function)
+	{
+		std::vector<T> output(values.size());
+		state.SetItemsPerIteration(values.size());
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			for (size_t j = 0; j < values.size(); ++j)
+				output[j] = function(values[j]);
+			DVM::Bench::DoNotOptimize(output.data());
+		}
+	}
+
+	template<typename T, typename F>
+	void RunBatch(DVM::Bench::State& state, const std::vector<T>& values, F batch)
+	{
+		std::vector<T> output(values.size());
+		state.SetItemsPerIteration(values.size());
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			batch(values.data(), output.data(), values.size());
+			DVM::Bench::DoNotOptimize(output.data());
+		}
+	}
+
+	//Log-uniform positive subnormals, from the smallest one up to the smallest normal
+	template<typename T>
+	const std::vector<T>& SubnormalInputs()
+	{
+		static std::vector<T> values = []
+		{
+			std::vector<T> result(4096);
+			double bits = static_cast<double>(std::numeric_limits<T>::digits - 1);
+			uint32_t seed = 97531u;
+
+			for (T& value : result)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				value = std::numeric_limits<T>::denorm_min() * static_cast<T>(std::exp2(seed / 4294967296. * bits));
+			}
+			return result;
+		}();
+
+		return values;
+	}
+
+	template<typename T, typename F>
+	void RunSqrt(DVM::Bench::State& state, F function, const std::vector<T>& values = Inputs<T>())
+	{
+		state.SetItemsPerIteration(values.size());
+
+		for (size_t i = 0; i < state.iterations; ++i)
+			for (T value : values)
+				DVM::Bench::DoNotOptimize(function(value));
+	}
+}
+
+DVM_BENCHMARK(BM_Sqrt_float)
+{
+	RunSqrt<float>(state, [](float x) { return DVM::Sqrt(x); });
+	static double ulp = MaxUlpError<float>([](float x) { return DVM::Sqrt(x); });
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_float_ConstexprPath)
+{
+	RunSqrt<float>(state, [](float x) { return DVM::Detail::SqrtNewton(x); });
+	static double ulp = MaxUlpError<float>([](float x) { return DVM::Detail::SqrtNewton(x); });
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_float_Legacy)
+{
+	RunSqrt<float>(state, [](float x) { return LegacySqrt(x); });
+	static double ulp = MaxUlpError<float>([](float x) { return LegacySqrt(x); });
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_float_std)
+{
+	RunSqrt<float>(state, [](float x) { return std::sqrt(x); });
+}
+
+DVM_BENCHMARK(BM_Sqrt_double)
+{
+	RunSqrt<double>(state, [](double x) { return DVM::Sqrt(x); });
+	static double ulp = MaxUlpError<double>([](double x) { return DVM::Sqrt(x); });
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_double_ConstexprPath)
+{
+	RunSqrt<double>(state, [](double x) { return DVM::Detail::SqrtNewton(x); });
+	static double ulp = MaxUlpError<double>([](double x) { return DVM::Detail::SqrtNewton(x); });
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_double_Legacy)
+{
+	RunSqrt<double>(state, [](double x) { return LegacySqrt(x); });
+	static double ulp = MaxUlpError<double>([](double x) { return LegacySqrt(x); });
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_double_std)
+{
+	RunSqrt<double>(state, [](double x) { return std::sqrt(x); });
+}
+
+//Subnormal inputs, where the exponent bit seed of the scalar path is meaningless. Most telling with DVM_NO_SIMD
+DVM_BENCHMARK(BM_Sqrt_float_Subnormal)
+{
+	RunSqrt<float>(state, [](float x) { return DVM::Sqrt(x); }, SubnormalInputs<float>());
+	static double ulp = MaxUlpError<float>([](float x) { return DVM::Sqrt(x); }, 1, NormalBits<float>());
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Sqrt_double_Subnormal)
+{
+	RunSqrt<double>(state, [](double x) { return DVM::Sqrt(x); }, SubnormalInputs<double>());
+	static double ulp = MaxUlpError<double>([](double x) { return DVM::Sqrt(x); }, 1, NormalBits<double>());
+	state.Counter("max_ulp", ulp);
+}
+
+DVM_BENCHMARK(BM_Inversesqrt_float)
+{
+	RunSqrt<float>(state, [](float x) { return DVM::Inversesqrt(x); });
+}
+
+DVM_BENCHMARK(BM_Inversesqrt_double)
+{
+	RunSqrt<double>(state, [](double x) { return DVM::Inversesqrt(x); });
+}
+
+DVM_BENCHMARK(BM_Exp_float_Scalar)
+{
+	RunScalar(state, ExpInputs<float>(), [](float x) { return DVM::Exp(x); });
+}
+
+DVM_BENCHMARK(BM_ExpBatch_float)
+{
+	RunBatch(state, ExpInputs<float>(), DVM::ExpBatch<float>);
+}
+
+DVM_BENCHMARK(BM_Exp2_float_Scalar)
+{
+	RunScalar(state, ExpInputs<float>(), [](float x) { return DVM::Exp2(x); });
+}
+
+DVM_BENCHMARK(BM_Exp2Batch_float)
+{
+	RunBatch(state, ExpInputs<float>(), DVM::Exp2Batch<float>);
+}
+
+DVM_BENCHMARK(BM_Log_float_Scalar)
+{
+	RunScalar(state, Inputs<float>(), [](float x) { return DVM::Log(x); });
+}
+
+DVM_BENCHMARK(BM_LogBatch_float)
+{
+	RunBatch(state, Inputs<float>(), DVM::LogBatch<float>);
+}
+
+DVM_BENCHMARK(BM_Log2_float_Scalar)
+{
+	RunScalar(state, Inputs<float>(), [](float x) { return DVM::Log2(x); });
+}
+
+DVM_BENCHMARK(BM_Log2Batch_float)
+{
+	RunBatch(state, Inputs<float>(), DVM::Log2Batch<float>);
+}
+
+DVM_BENCHMARK(BM_Sqrt_float_Scalar)
+{
+	RunScalar(state, Inputs<float>(), [](float x) { return DVM::Sqrt(x); });
+}
+
+DVM_BENCHMARK(BM_SqrtBatch_float)
+{
+	RunBatch(state, Inputs<float>(), DVM::SqrtBatch<float>);
+}
+
+DVM_BENCHMARK(BM_Exp_double_Scalar)
+{
+	RunScalar(state, ExpInputs<double>(), [](double x) { return DVM::Exp(x); });
+}
+
+DVM_BENCHMARK(BM_ExpBatch_double)
+{
+	RunBatch(state, ExpInputs<double>(), DVM::ExpBatch<double>);
+}
+
+DVM_BENCHMARK(BM_Exp2_double_Scalar)
+{
+	RunScalar(state, ExpInputs<double>(), [](double x) { return DVM::Exp2(x); });
+}
+
+DVM_BENCHMARK(BM_Exp2Batch_double)
+{
+	RunBatch(state, ExpInputs<double>(), DVM::Exp2Batch<double>);
+}
+
+DVM_BENCHMARK(BM_Log_double_Scalar)
+{
+	RunScalar(state, Inputs<double>(), [](double x) { return DVM::Log(x); });
+}
+
+DVM_BENCHMARK(BM_LogBatch_double)
+{
+	RunBatch(state, Inputs<double>(), DVM::LogBatch<double>);
+}
+
+DVM_BENCHMARK(BM_Log2_double_Scalar)
+{
+	RunScalar(state, Inputs<double>(), [](double x) { return DVM::Log2(x); });
+}
+
+DVM_BENCHMARK(BM_Log2Batch_double)
+{
+	RunBatch(state, Inputs<double>(), DVM::Log2Batch<double>);
+}
+
+DVM_BENCHMARK(BM_Sqrt_double_Scalar)
+{
+	RunScalar(state, Inputs<double>(), [](double x) { return DVM::Sqrt(x); });
+}
+
+DVM_BENCHMARK(BM_SqrtBatch_double)
+{
+	RunBatch(state, Inputs<double>(), DVM::SqrtBatch<double>);
+}
+
+DVM_BENCHMARK(BM_Floor_float_Legacy)
+{
+	RunScalar(state, ExpInputs<float>(), [](float x) { return LegacyFloor(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Floor_float_Scalar, BM_Floor_float_Legacy)
+{
+	RunScalar(state, ExpInputs<float>(), [](float x) { return DVM::Floor(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_FloorBatch_float, BM_Floor_float_Scalar)
+{
+	RunBatch(state, ExpInputs<float>(), DVM::FloorBatch<float>);
+}
+
+DVM_BENCHMARK(BM_Round_float_Legacy)
+{
+	RunScalar(state, ExpInputs<float>(), [](float x) { return LegacyRound(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Round_float_Scalar, BM_Round_float_Legacy)
+{
+	RunScalar(state, ExpInputs<float>(), [](float x) { return DVM::Round(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_RoundBatch_float, BM_Round_float_Scalar)
+{
+	RunBatch(state, ExpInputs<float>(), DVM::RoundBatch<float>);
+}
+
+DVM_BENCHMARK(BM_ModBatch_float)
+{
+	RunBatch(state, ExpInputs<float>(), [](const float* in, float* out, size_t count) { DVM::ModBatch(in, float(2.5), out, count); });
+}
+
+DVM_BENCHMARK(BM_Floor_double_Legacy)
+{
+	RunScalar(state, ExpInputs<double>(), [](double x) { return LegacyFloor(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Floor_double_Scalar, BM_Floor_double_Legacy)
+{
+	RunScalar(state, ExpInputs<double>(), [](double x) { return DVM::Floor(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_FloorBatch_double, BM_Floor_double_Scalar)
+{
+	RunBatch(state, ExpInputs<double>(), DVM::FloorBatch<double>);
+}
+
+DVM_BENCHMARK(BM_Round_double_Legacy)
+{
+	RunScalar(state, ExpInputs<double>(), [](double x) { return LegacyRound(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Round_double_Scalar, BM_Round_double_Legacy)
+{
+	RunScalar(state, ExpInputs<double>(), [](double x) { return DVM::Round(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_RoundBatch_double, BM_Round_double_Scalar)
+{
+	RunBatch(state, ExpInputs<double>(), DVM::RoundBatch<double>);
+}
+
+DVM_BENCHMARK(BM_ModBatch_double)
+{
+	RunBatch(state, ExpInputs<double>(), [](const double* in, double* out, size_t count) { DVM::ModBatch(in, double(2.5), out, count); });
+}
+
+DVM_BENCHMARK(BM_Pow_double_Legacy)
+{
+	RunScalar(state, NearOneInputs<double>(), [](double x) { return LegacyPow(x, 1000); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Pow_double_Squaring, BM_Pow_double_Legacy)
+{
+	RunScalar(state, NearOneInputs<double>(), [](double x) { return DVM::Pow(x, 1000); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Pow_double_Static, BM_Pow_double_Legacy)
+{
+	RunScalar(state, NearOneInputs<double>(), [](double x) { return DVM::Pow<1000>(x); });
+}
+
+DVM_BENCHMARK(BM_Pow5_double_ExpLog)
+{
+	RunScalar(state, NearOneInputs<double>(), [](double x) { return DVM::Pow(x, 5.); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Pow5_double_Static, BM_Pow5_double_ExpLog)
+{
+	RunScalar(state, NearOneInputs<double>(), [](double x) { return DVM::Pow<5>(x); });
+}
+
+//Short exponents, the squaring loop gains little over a few multiplies here
+DVM_BENCHMARK(BM_Pow_int_Legacy)
+{
+	RunScalar(state, ShiftInputs(), [](int x) { return static_cast<int>(LegacyPow(3u, x)); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Pow_int_Squaring, BM_Pow_int_Legacy)
+{
+	RunScalar(state, ShiftInputs(), [](int x) { return static_cast<int>(DVM::Pow(3u, x)); });
+}
+
+DVM_BENCHMARK(BM_Exp2_int_Legacy)
+{
+	RunScalar(state, ShiftInputs(), [](int x) { return LegacyExp2(x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Exp2_int_Shift, BM_Exp2_int_Legacy)
+{
+	RunScalar(state, ShiftInputs(), [](int x) { return DVM::Exp2(x); });
+}
@@ -0,0 +1,244 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Matrix_Math.h"
+
+namespace
+{
+	//The i-j-k loop matrixMultiplication used before the blocked kernel, kept as the baseline
+	template<typename T, size_t M, size_t N, size_t K>
+	DVM::MatTemplate<T, M, K> LegacyMultiplication(const DVM::MatTemplate<T, M, N>& matX, const DVM::MatTemplate<T, N, K>& matY)
+	{
+		DVM::MatTemplate<T, M, K> result;
+
+		for (size_t i = 0; i < M; ++i)
+			for (size_t j = 0; j < K; ++j)
+			{
+				T sum = 0;
+				for (size_t k = 0; k < N; ++k)
+					sum += matX[i][k] * matY[k][j];
+				result[i][j] = sum;
+			}
+
+		return result;
+	}
+
+	template<typename T, size_t S>
+	struct Operands
+	{
+		DVM::MatTemplate<T, S, S> x;
+		DVM::MatTemplate<T, S, S> y;
+		DVM::MatTemplate<T, S, S> result;
+	};
+
+	//Kept on the heap, 256x256 double operands do not fit a default stack
+	template<typename T, size_t S>
+	Operands<T, S>& GetOperands()
+	{
+		static std::unique_ptr<Operands<T, S>> operands = []
+		{
+			auto result = std::make_unique<Operands<T, S>>();
+			uint32_t seed = 777u;
+
+			for (size_t i = 0; i < S * S; ++i)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				result->x.data[i] = static_cast<T>(seed / 4294967296. * 2. - 1.);
+				seed = seed * 1664525u + 1013904223u;
+				result->y.data[i] = static_cast<T>(seed / 4294967296. * 2. - 1.);
+			}
+			return result;
+		}();
+
+		return *operands;
+	}
+
+	//Items are floating point operations, so items/s is FLOP/s
+	template<typename T, size_t S, typename F>
+	void RunMultiplication(DVM::Bench::State& state, F function)
+	{
+		Operands<T, S>& operands = GetOperands<T, S>();
+		state.SetItemsPerIteration(2 * S * S * S);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			operands.result = function(operands.x, operands.y);
+			DVM::Bench::DoNotOptimize(operands.result.data);
+		}
+	}
+}
+
+#define DVM_MATRIX_BENCHMARK(T, S)																				\
+	DVM_BENCHMARK(BM_matrixMultiplication_##T##_##S)															\
+	{																											\
+		RunMultiplication<T, S>(state, [](const auto& x, const auto& y) { return DVM::matrixMultiplication(x, y); });	\
+	}																											\
+	DVM_BENCHMARK(BM_matrixMultiplication_##T##_##S##_Legacy)													\
+	{																											\
+		RunMultiplication<T, S>(state, [](const auto& x, const auto& y) { return LegacyMultiplication(x, y); });	\
+	}
+
+DVM_MATRIX_BENCHMARK(float, 4)
+DVM_MATRIX_BENCHMARK(float, 16)
+DVM_MATRIX_BENCHMARK(float, 64)
+DVM_MATRIX_BENCHMARK(float, 256)
+DVM_MATRIX_BENCHMARK(double, 4)
+DVM_MATRIX_BENCHMARK(double, 16)
+DVM_MATRIX_BENCHMARK(double, 64)
+DVM_MATRIX_BENCHMARK(double, 256)
+
+//Determinant, Inverse, matrixMultiplication and Transpose for every Mat typedef, registered as
+//BM_Matrix_<function>_Mat<S><suffix>. ns/op is the time of one call
+namespace
+{
+	constexpr size_t MatrixCount = 256;
+
+	//Dominant diagonal, so floating point inverses exist and integral ones do not divide by zero
+	template<typename T, size_t S>
+	const std::vector<DVM::MatTemplate<T, S, S>>& MatrixOperands(size_t index)
+	{
+		static std::vector<DVM::MatTemplate<T, S, S>> pools[2];
+		std::vector<DVM::MatTemplate<T, S, S>>& pool = pools[index];
+
+		if (pool.empty())
+		{
+			uint32_t seed = static_cast<uint32_t>(41u + 101u * index);
+			pool.resize(MatrixCount);
+
+			for (DVM::MatTemplate<T, S, S>& mat : pool)
+				for (size_t i = 0; i < S; ++i)
+					for (size_t j = 0; j < S; ++j)
+						mat[i][j] = DVM::Bench::Random<T>(seed, 0., 3.) + (i == j ? T(5) : T(0));
+		}
+
+		return pool;
+	}
+
+	template<typename T, size_t S, typename F>
+	void RegisterMatrixFunction(const char* function, F operation)
+	{
+		std::string name = std::string("BM_Matrix_") + function + "_Mat" + std::to_string(S) + DVM::Bench::TypeSuffix<T>();
+
+		DVM::Bench::Registrar(name, [operation](DVM::Bench::State& state)
+		{
+			const auto& x = MatrixOperands<T, S>(0);
+			const auto& y = MatrixOperands<T, S>(1);
+
+			using R = decltype(operation(x[0], y[0]));
+			std::vector<R> output(MatrixCount);
+			state.SetItemsPerIteration(MatrixCount);
+
+			for (size_t i = 0; i < state.iterations; ++i)
+			{
+				for (size_t j = 0; j < MatrixCount; ++j)
+					output[j] = operation(x[j], y[j]);
+				DVM::Bench::DoNotOptimize(output.data());
+			}
+		}, "");
+	}
+
+	template<typename T, size_t S>
+	void RegisterMatrixFunctions()
+	{
+		using M = DVM::MatTemplate<T, S, S>;
+
+		RegisterMatrixFunction<T, S>("Determinant", [](const M& x, const M&) { return DVM::Determinant(x); });
+		RegisterMatrixFunction<T, S>("Inverse", [](const M& x, const M&) { return DVM::Inverse(x); });
+		RegisterMatrixFunction<T, S>("matrixMultiplication", [](const M& x, const M& y) { return DVM::matrixMultiplication(x, y); });
+		RegisterMatrixFunction<T, S>("Transpose", [](const M& x, const M&) { return DVM::Transpose(x); });
+	}
+
+	const bool registered = []
+	{
+		DVM::Bench::ForEachElementType([](auto type)
+		{
+			using T = typename decltype(type)::type;
+			RegisterMatrixFunctions<T, 2>();
+			RegisterMatrixFunctions<T, 3>();
+			RegisterMatrixFunctions<T, 4>();
+		});
+		return true;
+	}();
+}
+
+//Cholesky, QR and SymmetricEigen against the cofactor Inverse they replace for normal equations, registered as
+//BM_Decomposition_<function>_Mat<S><suffix>. ns/op is the time of one call
+namespace
+{
+	//Symmetric positive definite, x * x^T plus S on the diagonal
+	template<typename T, size_t S>
+	const std::vector<DVM::MatTemplate<T, S, S>>& SymmetricOperands()
+	{
+		static std::vector<DVM::MatTemplate<T, S, S>> pool = []
+		{
+			std::vector<DVM::MatTemplate<T, S, S>> result(MatrixCount);
+			uint32_t seed = 313u;
+
+			for (DVM::MatTemplate<T, S, S>& mat : result)
+			{
+				DVM::MatTemplate<T, S, S> x;
+				for (T& value : x.data)
+					value = DVM::Bench::Random<T>(seed, -1., 1.);
+
+				mat = DVM::matrixMultiplication(x, DVM::Transpose(x));
+				for (size_t i = 0; i < S; ++i)
+					mat[i][i] += T(S);
+			}
+			return result;
+		}();
+
+		return pool;
+	}
+
+	template<typename T, size_t S, typename F>
+	void RegisterDecomposition(const char* function, F operation)
+	{
+		std::string name = std::string("BM_Decomposition_") + function + "_Mat" + std::to_string(S) + DVM::Bench::TypeSuffix<T>();
+
+		DVM::Bench::Registrar(name, [operation](DVM::Bench::State& state)
+		{
+			const auto& x = SymmetricOperands<T, S>();
+			DVM::VecTemplate<T, S> vec(T(1));
+
+			using R = decltype(operation(x[0], vec));
+			std::vector<R> output(MatrixCount);
+			state.SetItemsPerIteration(MatrixCount);
+
+			for (size_t i = 0; i < state.iterations; ++i)
+			{
+				for (size_t j = 0; j < MatrixCount; ++j)
+					output[j] = operation(x[j], vec);
+				DVM::Bench::DoNotOptimize(output.data());
+			}
+		}, "");
+	}
+
+	template<typename T, size_t S>
+	void RegisterDecompositions()
+	{
+		using M = DVM::MatTemplate<T, S, S>;
+		using V = DVM::VecTemplate<T, S>;
+
+		RegisterDecomposition<T, S>("InverseSolve", [](const M& x, const V& b) { return DVM::linearTransformation(DVM::Inverse(x), b); });
+		RegisterDecomposition<T, S>("Solve", [](const M& x, const V& b) { return DVM::Solve(x, b); });
+		RegisterDecomposition<T, S>("CholeskySolve", [](const M& x, const V& b) { return DVM::CholeskySolve(x, b); });
+		RegisterDecomposition<T, S>("LeastSquares", [](const M& x, const V& b) { return DVM::LeastSquares(x, b); });
+		RegisterDecomposition<T, S>("Cholesky", [](const M& x, const V&) { M lower; DVM::Cholesky(x, lower); return lower; });
+		RegisterDecomposition<T, S>("QRDecompose", [](const M& x, const V&) { M q, r; DVM::QRDecompose(x, q, r); return r + q; });
+		RegisterDecomposition<T, S>("SymmetricEigen", [](const M& x, const V&) { V values; M vectors; DVM::SymmetricEigen(x, values, vectors); return vectors[0][0] + values[0]; });
+	}
+
+	const bool decompositionsRegistered = []
+	{
+		RegisterDecompositions<float, 3>();
+		RegisterDecompositions<float, 4>();
+		RegisterDecompositions<float, 8>();
+		RegisterDecompositions<double, 3>();
+		RegisterDecompositions<double, 4>();
+		RegisterDecompositions<double, 8>();
+		return true;
+	}();
+}
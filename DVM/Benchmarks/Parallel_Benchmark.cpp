@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Benchmark.h"
+#include "../Headers/DynMatrix_Parallel.h"
+
+namespace
+{
+	constexpr size_t Size = 512;
+
+	//Random operands with a heavy diagonal, so Solve and Inverse stay well conditioned
+	const DVM::DynMatrixd& Operand()
+	{
+		static DVM::DynMatrixd matrix = []
+		{
+			DVM::DynMatrixd result(Size, Size);
+			uint32_t seed = 4242u;
+
+			for (size_t i = 0; i < Size * Size; ++i)
+			{
+				seed = seed * 1664525u + 1013904223u;
+				result.Data()[i] = seed / 4294967296. * 2. - 1.;
+			}
+			for (size_t i = 0; i < Size; ++i)
+				result[i][i] += double(Size);
+
+			return result;
+		}();
+
+		return matrix;
+	}
+
+	const DVM::DynVectord& Vector()
+	{
+		static DVM::DynVectord vector(Size, 1.);
+		return vector;
+	}
+
+	//Items are elements of the result
+	template<typename F>
+	DVM::Bench::Function Parallel(size_t threads, F function)
+	{
+		return [threads, function](DVM::Bench::State& state)
+		{
+			static std::unique_ptr<DVM::ThreadPool> pool;
+			if (!pool || pool->ThreadCount() != threads) pool.reset(new DVM::ThreadPool(threads));
+
+			state.SetItemsPerIteration(Size * Size);
+			for (size_t i = 0; i < state.iterations; ++i)
+				DVM::Bench::DoNotOptimize(function(*pool));
+		};
+	}
+
+	template<typename F>
+	void RegisterScaling(const std::string& name, F function)
+	{
+		size_t maxThreads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+		std::string baseline = name + "/threads:1";
+
+		//Powers of two up to every hardware thread, which is always the last run
+		for (size_t threads = 1; ; threads = DVM::Min(threads * 2, maxThreads))
+		{
+			DVM::Bench::Registrar(name + "/threads:" + std::to_string(threads), Parallel(threads, function), threads == 1 ? "" : baseline);
+			if (threads == maxThreads) break;
+		}
+	}
+
+	//Speedup on every run is measured against the single thread pool, which runs the same split serially
+	const bool registered = []
+	{
+		RegisterScaling("BM_Parallel_matrixMultiplication_512", [](DVM::ThreadPool& pool)
+		{
+			return DVM::matrixMultiplication(pool, Operand(), Operand()).Data()[0];
+		});
+		RegisterScaling("BM_Parallel_Inverse_512", [](DVM::ThreadPool& pool)
+		{
+			return DVM::Inverse(pool, Operand()).Data()[0];
+		});
+		RegisterScaling("BM_Parallel_Solve_512", [](DVM::ThreadPool& pool)
+		{
+			return DVM::Solve(pool, Operand(), Vector())[0];
+		});
+		RegisterScaling("BM_Parallel_Transpose_512", [](DVM::ThreadPool& pool)
+		{
+			return DVM::Transpose(pool, Operand()).Data()[0];
+		});
+		RegisterScaling("BM_Parallel_linearTransformation_512", [](DVM::ThreadPool& pool)
+		{
+			return DVM::linearTransformation(pool, Operand(), Vector())[0];
+		});
+		return true;
+	}();
+}
@@ -0,0 +1,122 @@
+#include <cstdint>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Matrix_Math.h"
+#include "../Headers/Quaternion_Math.h"
+#include "../Headers/Vector_Math.h"
+
+//Rotating arrays of Vec3f, as in skinning: by one rotation and by one rotation per vector.
+//The baselines build a Mat3f and call linearTransformation per vector
+namespace
+{
+	constexpr size_t RotateCount = 4096;
+
+	struct RotateOperands
+	{
+		std::vector<DVM::Vec3f> vectors, result;
+		std::vector<DVM::Quatf> rotations, targets;
+	};
+
+	RotateOperands& GetRotateOperands()
+	{
+		static RotateOperands operands = []
+		{
+			RotateOperands result{ std::vector<DVM::Vec3f>(RotateCount), std::vector<DVM::Vec3f>(RotateCount),
+				std::vector<DVM::Quatf>(RotateCount), std::vector<DVM::Quatf>(RotateCount) };
+			uint32_t seed = 7u;
+			auto random = [&seed] { seed = seed * 1664525u + 1013904223u; return static_cast<float>(seed / 4294967296.) * 2.f - 1.f; };
+
+			for (size_t i = 0; i < RotateCount; ++i)
+			{
+				result.vectors[i] = DVM::Vec3f(random(), random(), random());
+				result.rotations[i] = DVM::Normalize(DVM::Quatf(random(), random(), random(), random()));
+				result.targets[i] = DVM::Normalize(DVM::Quatf(random(), random(), random(), random()));
+			}
+			return result;
+		}();
+
+		return operands;
+	}
+
+	//Items are rotated vectors or interpolated quaternions
+	template<typename F>
+	void RunRotate(DVM::Bench::State& state, F rotate)
+	{
+		RotateOperands& operands = GetRotateOperands();
+		state.SetItemsPerIteration(RotateCount);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			rotate(operands);
+			DVM::Bench::DoNotOptimize(operands.result.data());
+		}
+	}
+}
+
+DVM_BENCHMARK(BM_Rotate_Vec3f_Mat3)
+{
+	RunRotate(state, [](RotateOperands& operands)
+	{
+		DVM::Mat3f mat = DVM::Mat3Cast(operands.rotations[0]);
+		for (size_t i = 0; i < RotateCount; ++i)
+			operands.result[i] = DVM::linearTransformation(mat, operands.vectors[i]);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_RotateBatch_Vec3f, BM_Rotate_Vec3f_Mat3)
+{
+	RunRotate(state, [](RotateOperands& operands)
+	{
+		DVM::RotateBatch(operands.rotations[0], operands.vectors.data(), operands.result.data(), RotateCount);
+	});
+}
+
+DVM_BENCHMARK(BM_Rotate_Vec3f_Stream_Mat3)
+{
+	RunRotate(state, [](RotateOperands& operands)
+	{
+		for (size_t i = 0; i < RotateCount; ++i)
+			operands.result[i] = DVM::linearTransformation(DVM::Mat3Cast(operands.rotations[i]), operands.vectors[i]);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_Rotate_Vec3f_Stream_Quat, BM_Rotate_Vec3f_Stream_Mat3)
+{
+	RunRotate(state, [](RotateOperands& operands)
+	{
+		for (size_t i = 0; i < RotateCount; ++i)
+			operands.result[i] = DVM::Rotate(operands.rotations[i], operands.vectors[i]);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_RotateBatch_Vec3f_Stream, BM_Rotate_Vec3f_Stream_Mat3)
+{
+	RunRotate(state, [](RotateOperands& operands)
+	{
+		DVM::RotateBatch(operands.rotations.data(), operands.vectors.data(), operands.result.data(), RotateCount);
+	});
+}
+
+DVM_BENCHMARK(BM_SlerpBatch_Quatf)
+{
+	std::vector<DVM::Quatf> result(RotateCount);
+
+	RunRotate(state, [&result](RotateOperands& operands)
+	{
+		DVM::SlerpBatch(operands.rotations.data(), operands.targets.data(), 0.3f, result.data(), RotateCount);
+		DVM::Bench::DoNotOptimize(result.data());
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_NlerpBatch_Quatf, BM_SlerpBatch_Quatf)
+{
+	std::vector<DVM::Quatf> result(RotateCount);
+
+	RunRotate(state, [&result](RotateOperands& operands)
+	{
+		for (size_t i = 0; i < RotateCount; ++i)
+			result[i] = DVM::Nlerp(operands.rotations[i], operands.targets[i], 0.3f);
+		DVM::Bench::DoNotOptimize(result.data());
+	});
+}
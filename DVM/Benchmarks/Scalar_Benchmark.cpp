@@ -0,0 +1,148 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Math.h"
+
+//Every scalar function of Math.h over arrays of operands, registered as BM_Math_<function>_<type>.
+//ns/op is the time of one call
+namespace
+{
+	constexpr size_t OperandCount = 1024;
+
+	//Signed covers zero, Positive stays inside the domain of Log, Sqrt and Pow, Unit is [-1, 1] for Asin and Acos
+	enum Range { Signed, Positive, Unit };
+
+	template<typename T>
+	const std::vector<T>& Operands(Range range, size_t index)
+	{
+		static std::vector<T> pools[3][3];
+		std::vector<T>& pool = pools[range][index];
+
+		if (pool.empty())
+		{
+			uint32_t seed = static_cast<uint32_t>(17u + 3u * range + 101u * index);
+			bool integral = !DVTL::Is_floating_point_v<T>;
+			double low = range == Signed ? (integral ? -100. : -8.) : range == Positive ? (integral ? 1. : 0.125) : -1.;
+			double high = range == Signed ? (integral ? 100. : 8.) : range == Positive ? (integral ? 100. : 8.) : 1.;
+
+			for (size_t i = 0; i < OperandCount; ++i)
+				pool.push_back(DVM::Bench::Random<T>(seed, low, high));
+		}
+
+		return pool;
+	}
+
+	template<typename T> const char* ScalarName();
+	template<> const char* ScalarName<int>() { return "int"; }
+	template<> const char* ScalarName<float>() { return "float"; }
+	template<> const char* ScalarName<double>() { return "double"; }
+
+	//function(j) computes the result for operand j
+	template<typename F>
+	void RunOperands(DVM::Bench::State& state, F function)
+	{
+		using R = decltype(function(size_t(0)));
+		std::unique_ptr<R[]> output(new R[OperandCount]);
+		state.SetItemsPerIteration(OperandCount);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			for (size_t j = 0; j < OperandCount; ++j)
+				output[j] = function(j);
+			DVM::Bench::DoNotOptimize(output.get());
+		}
+	}
+
+	template<typename T, typename F>
+	void Unary(const char* name, Range range, F function)
+	{
+		DVM::Bench::Registrar(std::string("BM_Math_") + name + "_" + ScalarName<T>(), [range, function](DVM::Bench::State& state)
+		{
+			const std::vector<T>& x = Operands<T>(range, 0);
+			RunOperands(state, [&](size_t j) { return function(x[j]); });
+		}, "");
+	}
+
+	template<typename T, typename F>
+	void Binary(const char* name, Range range, Range range2, F function)
+	{
+		DVM::Bench::Registrar(std::string("BM_Math_") + name + "_" + ScalarName<T>(), [range, range2, function](DVM::Bench::State& state)
+		{
+			const std::vector<T>& x = Operands<T>(range, 0);
+			const std::vector<T>& y = Operands<T>(range2, 1);
+			RunOperands(state, [&](size_t j) { return function(x[j], y[j]); });
+		}, "");
+	}
+
+	template<typename T, typename F>
+	void Ternary(const char* name, Range range, F function)
+	{
+		DVM::Bench::Registrar(std::string("BM_Math_") + name + "_" + ScalarName<T>(), [range, function](DVM::Bench::State& state)
+		{
+			const std::vector<T>& x = Operands<T>(range, 0);
+			const std::vector<T>& y = Operands<T>(range, 1);
+			const std::vector<T>& z = Operands<T>(range, 2);
+			RunOperands(state, [&](size_t j) { return function(x[j], y[j], z[j]); });
+		}, "");
+	}
+
+	//Functions defined for every arithmetic type
+	template<typename T>
+	void RegisterArithmetic()
+	{
+		Unary<T>("Abs", Signed, [](T x) { return DVM::Abs(x); });
+		Binary<T>("Min", Signed, Signed, [](T x, T y) { return DVM::Min(x, y); });
+		Binary<T>("Max", Signed, Signed, [](T x, T y) { return DVM::Max(x, y); });
+		Binary<T>("Clamp", Signed, Positive, [](T x, T y) { return DVM::Clamp(x, T(-y), y); });
+		Binary<T>("Mod", Signed, Positive, [](T x, T y) { return DVM::Mod(x, y); });
+		Unary<T>("Sign", Signed, [](T x) { return DVM::Sign(x); });
+		Binary<T>("Step", Signed, Signed, [](T x, T y) { return DVM::Step(x, y); });
+	}
+
+	template<typename T>
+	void RegisterFloating()
+	{
+		RegisterArithmetic<T>();
+
+		Unary<T>("Ceil", Signed, [](T x) { return DVM::Ceil(x); });
+		Unary<T>("Floor", Signed, [](T x) { return DVM::Floor(x); });
+		Unary<T>("Round", Signed, [](T x) { return DVM::Round(x); });
+		Unary<T>("Fract", Signed, [](T x) { return DVM::Fract(x); });
+		Ternary<T>("Fma", Signed, [](T x, T y, T z) { return DVM::Fma(x, y, z); });
+		Unary<T>("Isinf", Signed, [](T x) { return DVM::Isinf(x); });
+		Unary<T>("Isnan", Signed, [](T x) { return DVM::Isnan(x); });
+		Binary<T>("Mix", Signed, Signed, [](T x, T y) { return DVM::Mix(x, y, T(0.25)); });
+		Unary<T>("Smoothstep", Signed, [](T x) { return DVM::Smoothstep(T(-4), T(4), x); });
+		Unary<T>("Exp", Signed, [](T x) { return DVM::Exp(x); });
+		Unary<T>("Exp2", Signed, [](T x) { return DVM::Exp2(x); });
+		Unary<T>("Log", Positive, [](T x) { return DVM::Log(x); });
+		Unary<T>("Log2", Positive, [](T x) { return DVM::Log2(x); });
+		Binary<T>("Pow", Positive, Signed, [](T x, T y) { return DVM::Pow(x, y); });
+		Unary<T>("PowStatic", Signed, [](T x) { return DVM::Pow<5>(x); });
+		Unary<T>("Sqrt", Positive, [](T x) { return DVM::Sqrt(x); });
+		Unary<T>("Inversesqrt", Positive, [](T x) { return DVM::Inversesqrt(x); });
+		Unary<T>("Sin", Signed, [](T x) { return DVM::Sin(x); });
+		Unary<T>("Cos", Signed, [](T x) { return DVM::Cos(x); });
+		Unary<T>("Tan", Signed, [](T x) { return DVM::Tan(x); });
+		Unary<T>("Asin", Unit, [](T x) { return DVM::Asin(x); });
+		Unary<T>("Acos", Unit, [](T x) { return DVM::Acos(x); });
+		Unary<T>("Frexp", Positive, [](T x) { int exp = 0; return DVM::Frexp(x, exp) + T(exp); });
+		Unary<T>("Idexp", Signed, [](T x) { int exp = 3; return DVM::Idexp(x, exp) + T(exp); });
+	}
+
+	const bool registered = []
+	{
+		RegisterArithmetic<int>();
+		Unary<int>("Exp2", Positive, [](int x) { return DVM::Exp2(x % 31); });
+		RegisterFloating<float>();
+		RegisterFloating<double>();
+
+		Unary<float>("FloatBitsToInt", Signed, [](float x) { return DVM::FloatBitsToInt(x); });
+		Unary<float>("FloatBitsToUint", Signed, [](float x) { return DVM::FloatBitsToUint(x); });
+		Unary<int>("IntBitsToFloat", Positive, [](int x) { return DVM::IntBitsToFloat(x); });
+		Unary<int>("UintBitsToFloat", Positive, [](int x) { return DVM::UintBitsToFloat(static_cast<unsigned int>(x)); });
+		return true;
+	}();
+}
@@ -0,0 +1,158 @@
+#include <cstdint>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/DynMatrix_Math.h"
+#include "../Headers/Solvers.h"
+
+//Iterative solvers on the 7 point Laplacian of a cubic grid (symmetric, for ConjugateGradient) and the same stencil
+//with a convection term (non-symmetric, for BiCGSTAB), against Solve's LU on the densified matrix.
+//Items are whole solves, so the speedups compare time to solution and include fewer iterations
+namespace
+{
+	//1000 rows, small enough for the dense LU baseline
+	constexpr size_t SmallGrid = 10;
+	//32768 rows, the size of a per-frame physics solve
+	constexpr size_t LargeGrid = 32;
+
+	template<size_t Grid, int Convection>
+	const DVM::CsrMatrixd& Operator()
+	{
+		static DVM::CsrMatrixd matrix = []
+		{
+			constexpr double c = Convection / 10.;
+			constexpr size_t n = Grid * Grid * Grid;
+			std::vector<DVM::Triplet<double>> triplets;
+			triplets.reserve(7 * n);
+
+			for (size_t z = 0; z < Grid; ++z)
+				for (size_t y = 0; y < Grid; ++y)
+					for (size_t x = 0; x < Grid; ++x)
+					{
+						size_t i = (z * Grid + y) * Grid + x;
+						triplets.push_back({ i, i, 6. });
+
+						if (x > 0)			triplets.push_back({ i, i - 1, -1. - c });
+						if (x + 1 < Grid)	triplets.push_back({ i, i + 1, -1. + c });
+						if (y > 0)			triplets.push_back({ i, i - Grid, -1. });
+						if (y + 1 < Grid)	triplets.push_back({ i, i + Grid, -1. });
+						if (z > 0)			triplets.push_back({ i, i - Grid * Grid, -1. });
+						if (z + 1 < Grid)	triplets.push_back({ i, i + Grid * Grid, -1. });
+					}
+
+			return DVM::CsrMatrixd::FromTriplets(n, n, triplets.data(), triplets.size());
+		}();
+
+		return matrix;
+	}
+
+	template<size_t Grid>
+	const DVM::DynVectord& RightHandSide()
+	{
+		static DVM::DynVectord vector = []
+		{
+			DVM::DynVectord result(Grid * Grid * Grid);
+			uint32_t seed = 17u;
+			for (size_t i = 0; i < result.Size(); ++i)
+				result[i] = DVM::Bench::Random<double>(seed, -1., 1.);
+			return result;
+		}();
+
+		return vector;
+	}
+
+	//Every run solves from a zero guess
+	template<typename F>
+	void RunSolver(DVM::Bench::State& state, F solve)
+	{
+		DVM::DynVectord x;
+		state.SetItemsPerIteration(1);
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			x = DVM::DynVectord();
+			DVM::Bench::DoNotOptimize(solve(x).residual);
+		}
+	}
+}
+
+DVM_BENCHMARK(BM_Solver_Solve_Dense_1000)
+{
+	static DVM::DynMatrixd dense = DVM::ToDense(Operator<SmallGrid, 0>());
+	state.SetItemsPerIteration(1);
+	for (size_t i = 0; i < state.iterations; ++i)
+		DVM::Bench::DoNotOptimize(DVM::Solve(dense, RightHandSide<SmallGrid>())[0]);
+}
+
+DVM_BENCHMARK_BASELINE(BM_Solver_ConjugateGradient_Dense_1000, BM_Solver_Solve_Dense_1000)
+{
+	static DVM::DynMatrixd dense = DVM::ToDense(Operator<SmallGrid, 0>());
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::ConjugateGradient(dense, RightHandSide<SmallGrid>(), x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Solver_ConjugateGradient_Csr_1000, BM_Solver_Solve_Dense_1000)
+{
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::ConjugateGradient(Operator<SmallGrid, 0>(), RightHandSide<SmallGrid>(), x); });
+}
+
+DVM_BENCHMARK(BM_Solver_ConjugateGradient_32768)
+{
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::ConjugateGradient(Operator<LargeGrid, 0>(), RightHandSide<LargeGrid>(), x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Solver_ConjugateGradient_Jacobi_32768, BM_Solver_ConjugateGradient_32768)
+{
+	static DVM::JacobiPreconditioner<double> jacobi(Operator<LargeGrid, 0>());
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::ConjugateGradient(Operator<LargeGrid, 0>(), RightHandSide<LargeGrid>(), x, jacobi); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Solver_ConjugateGradient_IncompleteCholesky_32768, BM_Solver_ConjugateGradient_32768)
+{
+	static DVM::IncompleteCholesky<double> cholesky(Operator<LargeGrid, 0>());
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::ConjugateGradient(Operator<LargeGrid, 0>(), RightHandSide<LargeGrid>(), x, cholesky); });
+}
+
+//The previous frame's solution as the guess for a slightly changed right hand side
+DVM_BENCHMARK_BASELINE(BM_Solver_ConjugateGradient_WarmStart_32768, BM_Solver_ConjugateGradient_IncompleteCholesky_32768)
+{
+	static DVM::IncompleteCholesky<double> cholesky(Operator<LargeGrid, 0>());
+	static DVM::DynVectord previous = []
+	{
+		DVM::DynVectord x;
+		DVM::ConjugateGradient(Operator<LargeGrid, 0>(), RightHandSide<LargeGrid>(), x, cholesky);
+		return x;
+	}();
+	static DVM::DynVectord next = RightHandSide<LargeGrid>() * 1.01;
+
+	DVM::DynVectord x;
+	state.SetItemsPerIteration(1);
+	for (size_t i = 0; i < state.iterations; ++i)
+	{
+		x = previous;
+		DVM::Bench::DoNotOptimize(DVM::ConjugateGradient(Operator<LargeGrid, 0>(), next, x, cholesky).residual);
+	}
+}
+
+DVM_BENCHMARK(BM_Solver_BiCGSTAB_32768)
+{
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::BiCGSTAB(Operator<LargeGrid, 4>(), RightHandSide<LargeGrid>(), x); });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Solver_BiCGSTAB_Jacobi_32768, BM_Solver_BiCGSTAB_32768)
+{
+	static DVM::JacobiPreconditioner<double> jacobi(Operator<LargeGrid, 4>());
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::BiCGSTAB(Operator<LargeGrid, 4>(), RightHandSide<LargeGrid>(), x, jacobi); });
+}
+
+//The factor of the symmetric part preconditions the convection operator
+DVM_BENCHMARK_BASELINE(BM_Solver_BiCGSTAB_IncompleteCholesky_32768, BM_Solver_BiCGSTAB_32768)
+{
+	static DVM::IncompleteCholesky<double> cholesky(Operator<LargeGrid, 0>());
+	RunSolver(state, [](DVM::DynVectord& x) { return DVM::BiCGSTAB(Operator<LargeGrid, 4>(), RightHandSide<LargeGrid>(), x, cholesky); });
+}
+
+DVM_BENCHMARK(BM_Solver_IncompleteCholesky_Factorize_32768)
+{
+	state.SetItemsPerIteration(Operator<LargeGrid, 0>().NonZeros());
+	for (size_t i = 0; i < state.iterations; ++i)
+		DVM::Bench::DoNotOptimize(DVM::IncompleteCholesky<double>(Operator<LargeGrid, 0>()).Breakdowns());
+}
@@ -0,0 +1,181 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/DynMatrix_Math.h"
+#include "../Headers/SparseMatrix_Parallel.h"
+
+//SparseMatrix products on the 7 point Laplacian of a cubic grid, the shape of a mesh Laplacian, against the same
+//matrix densified into DynMatrix. Items are stored non-zeros, so items/s is the SpMV throughput
+namespace
+{
+	//Small enough to densify, 1728 rows
+	constexpr size_t SmallGrid = 12;
+	//110592 rows, about 7 non-zeros each
+	constexpr size_t LargeGrid = 48;
+
+	std::vector<DVM::Triplet<double>> LaplacianTriplets(size_t grid)
+	{
+		std::vector<DVM::Triplet<double>> triplets;
+		size_t n = grid * grid * grid;
+		triplets.reserve(7 * n);
+
+		for (size_t z = 0; z < grid; ++z)
+			for (size_t y = 0; y < grid; ++y)
+				for (size_t x = 0; x < grid; ++x)
+				{
+					size_t i = (z * grid + y) * grid + x;
+					triplets.push_back({ i, i, 6. });
+
+					if (x > 0)			triplets.push_back({ i, i - 1, -1. });
+					if (x + 1 < grid)	triplets.push_back({ i, i + 1, -1. });
+					if (y > 0)			triplets.push_back({ i, i - grid, -1. });
+					if (y + 1 < grid)	triplets.push_back({ i, i + grid, -1. });
+					if (z > 0)			triplets.push_back({ i, i - grid * grid, -1. });
+					if (z + 1 < grid)	triplets.push_back({ i, i + grid * grid, -1. });
+				}
+
+		return triplets;
+	}
+
+	template<size_t Grid>
+	const DVM::CsrMatrixd& Laplacian()
+	{
+		static DVM::CsrMatrixd matrix = []
+		{
+			std::vector<DVM::Triplet<double>> triplets = LaplacianTriplets(Grid);
+			return DVM::CsrMatrixd::FromTriplets(Grid * Grid * Grid, Grid * Grid * Grid, triplets.data(), triplets.size());
+		}();
+
+		return matrix;
+	}
+
+	template<size_t Grid>
+	const DVM::CscMatrixd& LaplacianCsc()
+	{
+		static DVM::CscMatrixd matrix(Laplacian<Grid>());
+		return matrix;
+	}
+
+	template<size_t Grid>
+	const DVM::DynVectord& Operand()
+	{
+		static DVM::DynVectord vector = []
+		{
+			DVM::DynVectord result(Grid * Grid * Grid);
+			uint32_t seed = 99u;
+			for (size_t i = 0; i < result.Size(); ++i)
+				result[i] = DVM::Bench::Random<double>(seed, -1., 1.);
+			return result;
+		}();
+
+		return vector;
+	}
+
+	//Four right hand sides, dense[j] is column j
+	template<size_t Grid>
+	const DVM::DynMatrixd& DenseOperand()
+	{
+		static DVM::DynMatrixd matrix = []
+		{
+			DVM::DynMatrixd result(4, Grid * Grid * Grid);
+			uint32_t seed = 199u;
+			for (size_t i = 0; i < result.Size(); ++i)
+				result.Data()[i] = DVM::Bench::Random<double>(seed, -1., 1.);
+			return result;
+		}();
+
+		return matrix;
+	}
+
+	template<size_t Grid, typename F>
+	void RunSparse(DVM::Bench::State& state, size_t items, F function)
+	{
+		state.SetItemsPerIteration(items);
+		for (size_t i = 0; i < state.iterations; ++i)
+			DVM::Bench::DoNotOptimize(function());
+	}
+}
+
+DVM_BENCHMARK(BM_Sparse_linearTransformation_Dense_1728)
+{
+	static DVM::DynMatrixd dense = DVM::ToDense(Laplacian<SmallGrid>());
+	RunSparse<SmallGrid>(state, Laplacian<SmallGrid>().NonZeros(), [&] { return DVM::linearTransformation(dense, Operand<SmallGrid>())[0]; });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Sparse_linearTransformation_Csr_1728, BM_Sparse_linearTransformation_Dense_1728)
+{
+	RunSparse<SmallGrid>(state, Laplacian<SmallGrid>().NonZeros(), [] { return DVM::linearTransformation(Laplacian<SmallGrid>(), Operand<SmallGrid>())[0]; });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Sparse_linearTransformation_Csc_1728, BM_Sparse_linearTransformation_Dense_1728)
+{
+	RunSparse<SmallGrid>(state, Laplacian<SmallGrid>().NonZeros(), [] { return DVM::linearTransformation(LaplacianCsc<SmallGrid>(), Operand<SmallGrid>())[0]; });
+}
+
+//The dense product of the four columns with the densified Laplacian, the sparse one runs four SpMV
+DVM_BENCHMARK(BM_Sparse_matrixMultiplication_Dense_1728)
+{
+	static DVM::DynMatrixd dense = DVM::ToDense(Laplacian<SmallGrid>());
+	RunSparse<SmallGrid>(state, 4 * Laplacian<SmallGrid>().NonZeros(), [&] { return DVM::matrixMultiplication(DenseOperand<SmallGrid>(), dense).Data()[0]; });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Sparse_matrixMultiplication_Csr_1728, BM_Sparse_matrixMultiplication_Dense_1728)
+{
+	RunSparse<SmallGrid>(state, 4 * Laplacian<SmallGrid>().NonZeros(), [] { return DVM::matrixMultiplication(Laplacian<SmallGrid>(), DenseOperand<SmallGrid>()).Data()[0]; });
+}
+
+DVM_BENCHMARK(BM_Sparse_linearTransformation_Csr_110592)
+{
+	RunSparse<LargeGrid>(state, Laplacian<LargeGrid>().NonZeros(), [] { return DVM::linearTransformation(Laplacian<LargeGrid>(), Operand<LargeGrid>())[0]; });
+}
+
+DVM_BENCHMARK_BASELINE(BM_Sparse_linearTransformation_Csc_110592, BM_Sparse_linearTransformation_Csr_110592)
+{
+	RunSparse<LargeGrid>(state, Laplacian<LargeGrid>().NonZeros(), [] { return DVM::linearTransformation(LaplacianCsc<LargeGrid>(), Operand<LargeGrid>())[0]; });
+}
+
+DVM_BENCHMARK(BM_Sparse_matrixMultiplication_Csr_110592)
+{
+	RunSparse<LargeGrid>(state, 4 * Laplacian<LargeGrid>().NonZeros(), [] { return DVM::matrixMultiplication(Laplacian<LargeGrid>(), DenseOperand<LargeGrid>()).Data()[0]; });
+}
+
+DVM_BENCHMARK(BM_Sparse_FromTriplets_110592)
+{
+	static std::vector<DVM::Triplet<double>> triplets = LaplacianTriplets(LargeGrid);
+	size_t n = LargeGrid * LargeGrid * LargeGrid;
+	RunSparse<LargeGrid>(state, triplets.size(), [&] { return DVM::CsrMatrixd::FromTriplets(n, n, triplets.data(), triplets.size()).NonZeros(); });
+}
+
+DVM_BENCHMARK(BM_Sparse_Transpose_110592)
+{
+	RunSparse<LargeGrid>(state, Laplacian<LargeGrid>().NonZeros(), [] { return DVM::Transpose(Laplacian<LargeGrid>()).NonZeros(); });
+}
+
+namespace
+{
+	//Speedup on every run is measured against the single thread pool
+	const bool registered = []
+	{
+		size_t maxThreads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+		std::string name = "BM_Sparse_Parallel_linearTransformation_110592";
+		std::string baseline = name + "/threads:1";
+
+		for (size_t threads = 1; ; threads = DVM::Min(threads * 2, maxThreads))
+		{
+			DVM::Bench::Registrar(name + "/threads:" + std::to_string(threads), [threads](DVM::Bench::State& state)
+			{
+				static std::unique_ptr<DVM::ThreadPool> pool;
+				if (!pool || pool->ThreadCount() != threads) pool.reset(new DVM::ThreadPool(threads));
+
+				RunSparse<LargeGrid>(state, Laplacian<LargeGrid>().NonZeros(), [&] { return DVM::linearTransformation(*pool, Laplacian<LargeGrid>(), Operand<LargeGrid>())[0]; });
+			}, threads == 1 ? "" : baseline);
+
+			if (threads == maxThreads) break;
+		}
+		return true;
+	}();
+}
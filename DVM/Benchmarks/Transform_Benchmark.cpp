@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Matrix_Batch.h"
+
+//One Mat4f applied to a point cloud, against a loop of linearTransformation on Vec4f points
+namespace
+{
+	constexpr size_t PointCount = size_t(1) << 20;
+
+	struct PointCloud
+	{
+		std::vector<DVM::Vec3f> points, result;
+		std::vector<DVM::Vec4f> homogeneous, homogeneousResult;
+		DVM::VecArray3f stream, streamResult;
+		DVM::Mat4f mat;
+	};
+
+	PointCloud& GetPointCloud()
+	{
+		static PointCloud cloud = []
+		{
+			PointCloud result{ std::vector<DVM::Vec3f>(PointCount), std::vector<DVM::Vec3f>(PointCount),
+				std::vector<DVM::Vec4f>(PointCount), std::vector<DVM::Vec4f>(PointCount), {}, {}, {} };
+			uint32_t seed = 31u;
+			auto random = [&seed] { seed = seed * 1664525u + 1013904223u; return static_cast<float>(seed / 4294967296.) * 2.f - 1.f; };
+
+			for (size_t i = 0; i < PointCount; ++i)
+			{
+				result.points[i] = DVM::Vec3f(random(), random(), random());
+				result.homogeneous[i] = DVM::Vec4f(result.points[i], 1.f);
+			}
+			result.stream.Load(result.points.data(), PointCount);
+
+			result.mat = DVM::Rotation(0.7f, DVM::Vec3f(0.f, 0.6f, 0.8f));
+			result.mat[3][0] = 1.f;
+			result.mat[3][1] = -2.f;
+			result.mat[3][2] = 3.f;
+			return result;
+		}();
+
+		return cloud;
+	}
+
+	//Items are transformed points
+	template<typename F>
+	void RunTransform(DVM::Bench::State& state, F transform)
+	{
+		PointCloud& cloud = GetPointCloud();
+		state.SetItemsPerIteration(PointCount);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			transform(cloud);
+			DVM::Bench::DoNotOptimize(&cloud);
+		}
+	}
+
+	DVM::ThreadPool& Pool()
+	{
+		static DVM::ThreadPool pool;
+		return pool;
+	}
+}
+
+DVM_BENCHMARK(BM_Transform_Vec4f_Loop)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		for (size_t i = 0; i < PointCount; ++i)
+			cloud.homogeneousResult[i] = DVM::linearTransformation(cloud.mat, cloud.homogeneous[i]);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_Transform_Vec4f_Batch, BM_Transform_Vec4f_Loop)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		DVM::linearTransformationBatch(cloud.mat, cloud.homogeneous.data(), cloud.homogeneousResult.data(), PointCount);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_TransformPoint_Vec3f_Batch, BM_Transform_Vec4f_Loop)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		DVM::TransformPointBatch(cloud.mat, cloud.points.data(), cloud.result.data(), PointCount);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_ProjectPoint_Vec3f_Batch, BM_Transform_Vec4f_Loop)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		DVM::ProjectPointBatch(cloud.mat, cloud.points.data(), cloud.result.data(), PointCount);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_TransformPoint_VecArray3f, BM_Transform_Vec4f_Loop)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		DVM::TransformPoint(cloud.mat, cloud.stream, cloud.streamResult);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_TransformPoint_Vec3f_Batch_Parallel, BM_TransformPoint_Vec3f_Batch)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		DVM::TransformPointBatch(Pool(), cloud.mat, cloud.points.data(), cloud.result.data(), PointCount);
+	});
+}
+
+DVM_BENCHMARK_BASELINE(BM_TransformPoint_VecArray3f_Parallel, BM_TransformPoint_VecArray3f)
+{
+	RunTransform(state, [](PointCloud& cloud)
+	{
+		DVM::TransformPoint(Pool(), cloud.mat, cloud.stream, cloud.streamResult);
+	});
+}
@@ -0,0 +1,184 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../Headers/Vector_Math.h"
+
+//Every operation of Vector_Math.h and the arithmetic operators over arrays of vectors, registered as
+//BM_Vector_<operation>_Vec<N><suffix> for N = 2, 3, 4. ns/op is the time of one call
+namespace
+{
+	constexpr size_t OperandCount = 1024;
+
+	//Signed covers zero, Positive stays inside the domain of Log, Sqrt and Pow and is nonzero for division
+	enum Range { Signed, Positive };
+
+	template<typename T, size_t N>
+	const std::vector<DVM::VecTemplate<T, N>>& Operands(Range range, size_t index)
+	{
+		static std::vector<DVM::VecTemplate<T, N>> pools[2][3];
+		std::vector<DVM::VecTemplate<T, N>>& pool = pools[range][index];
+
+		if (pool.empty())
+		{
+			uint32_t seed = static_cast<uint32_t>(29u + 3u * range + 101u * index);
+			bool integral = !DVTL::Is_floating_point_v<T>;
+			double low = range == Signed ? (integral ? -100. : -8.) : (integral ? 1. : 0.125);
+			double high = integral ? 100. : 8.;
+
+			pool.resize(OperandCount);
+			for (DVM::VecTemplate<T, N>& vec : pool)
+				for (size_t i = 0; i < N; ++i)
+					vec[i] = DVM::Bench::Random<T>(seed, low, high);
+		}
+
+		return pool;
+	}
+
+	template<typename T, size_t N>
+	std::string VectorName(const char* operation)
+	{
+		return std::string("BM_Vector_") + operation + "_Vec" + std::to_string(N) + DVM::Bench::TypeSuffix<T>();
+	}
+
+	//function(j) computes the result for operand j
+	template<typename F>
+	void RunOperands(DVM::Bench::State& state, F function)
+	{
+		using R = decltype(function(size_t(0)));
+		std::unique_ptr<R[]> output(new R[OperandCount]);
+		state.SetItemsPerIteration(OperandCount);
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			for (size_t j = 0; j < OperandCount; ++j)
+				output[j] = function(j);
+			DVM::Bench::DoNotOptimize(output.get());
+		}
+	}
+
+	template<typename T, size_t N, typename F>
+	void Unary(const char* operation, Range range, F function)
+	{
+		DVM::Bench::Registrar(VectorName<T, N>(operation), [range, function](DVM::Bench::State& state)
+		{
+			const auto& x = Operands<T, N>(range, 0);
+			RunOperands(state, [&](size_t j) { return function(x[j]); });
+		}, "");
+	}
+
+	template<typename T, size_t N, typename F>
+	void Binary(const char* operation, Range range, Range range2, F function)
+	{
+		DVM::Bench::Registrar(VectorName<T, N>(operation), [range, range2, function](DVM::Bench::State& state)
+		{
+			const auto& x = Operands<T, N>(range, 0);
+			const auto& y = Operands<T, N>(range2, 1);
+			RunOperands(state, [&](size_t j) { return function(x[j], y[j]); });
+		}, "");
+	}
+
+	template<typename T, size_t N, typename F>
+	void Ternary(const char* operation, Range range, F function)
+	{
+		DVM::Bench::Registrar(VectorName<T, N>(operation), [range, function](DVM::Bench::State& state)
+		{
+			const auto& x = Operands<T, N>(range, 0);
+			const auto& y = Operands<T, N>(range, 1);
+			const auto& z = Operands<T, N>(range, 2);
+			RunOperands(state, [&](size_t j) { return function(x[j], y[j], z[j]); });
+		}, "");
+	}
+
+	//Operators and functions defined for every element type. Results are spelled out as V so that
+	//expression template builds evaluate them
+	template<typename T, size_t N>
+	void RegisterArithmetic()
+	{
+		using V = DVM::VecTemplate<T, N>;
+
+		Binary<T, N>("Add", Signed, Signed, [](const V& x, const V& y) -> V { return x + y; });
+		Binary<T, N>("Sub", Signed, Signed, [](const V& x, const V& y) -> V { return x - y; });
+		Binary<T, N>("Mul", Signed, Signed, [](const V& x, const V& y) -> V { return x * y; });
+		Binary<T, N>("Div", Signed, Positive, [](const V& x, const V& y) -> V { return x / y; });
+		Unary<T, N>("MulScalar", Signed, [](const V& x) -> V { return x * T(3); });
+		Unary<T, N>("Abs", Signed, [](const V& x) { return DVM::Abs(x); });
+		Unary<T, N>("MinScalar", Signed, [](const V& x) { return DVM::Min(x, T(1)); });
+		Binary<T, N>("Min", Signed, Signed, [](const V& x, const V& y) { return DVM::Min(x, y); });
+		Unary<T, N>("MaxScalar", Signed, [](const V& x) { return DVM::Max(x, T(1)); });
+		Binary<T, N>("Max", Signed, Signed, [](const V& x, const V& y) { return DVM::Max(x, y); });
+		Unary<T, N>("ClampScalar", Signed, [](const V& x) { return DVM::Clamp(x, T(0), T(4)); });
+		Ternary<T, N>("Clamp", Signed, [](const V& x, const V& y, const V& z) { return DVM::Clamp(x, y, z); });
+		Binary<T, N>("Dot", Signed, Signed, [](const V& x, const V& y) { return DVM::Dot(x, y); });
+		Unary<T, N>("ModScalar", Signed, [](const V& x) { return DVM::Mod(x, T(3)); });
+		Binary<T, N>("Mod", Signed, Positive, [](const V& x, const V& y) { return DVM::Mod(x, y); });
+		//Exponent at run time, exponentiation by squaring for integral T and Exp and Log for floating point T
+		Unary<T, N>("Pow3", Positive, [](const V& x) { return DVM::Pow(x, T(3)); });
+		Unary<T, N>("Pow3Static", Positive, [](const V& x) { return DVM::Pow<3>(x); });
+	}
+
+	template<typename T, size_t N>
+	void RegisterFloating()
+	{
+		using V = DVM::VecTemplate<T, N>;
+
+		Unary<T, N>("Ceil", Signed, [](const V& x) { return DVM::Ceil(x); });
+		Unary<T, N>("Floor", Signed, [](const V& x) { return DVM::Floor(x); });
+		Unary<T, N>("Round", Signed, [](const V& x) { return DVM::Round(x); });
+		Unary<T, N>("Fract", Signed, [](const V& x) { return DVM::Fract(x); });
+		Unary<T, N>("Isinf", Signed, [](const V& x) { return DVM::Isinf(x); });
+		Unary<T, N>("Isnan", Signed, [](const V& x) { return DVM::Isnan(x); });
+		Unary<T, N>("Sign", Signed, [](const V& x) { return DVM::Sign(x); });
+		Unary<T, N>("StepScalar", Signed, [](const V& x) { return DVM::Step(x, T(0)); });
+		Binary<T, N>("Step", Signed, Signed, [](const V& x, const V& y) { return DVM::Step(x, y); });
+		Unary<T, N>("Exp", Signed, [](const V& x) { return DVM::Exp(x); });
+		Unary<T, N>("Exp2", Signed, [](const V& x) { return DVM::Exp2(x); });
+		Unary<T, N>("Inversesqrt", Positive, [](const V& x) { return DVM::Inversesqrt(x); });
+		Unary<T, N>("Log", Positive, [](const V& x) { return DVM::Log(x); });
+		Unary<T, N>("Log2", Positive, [](const V& x) { return DVM::Log2(x); });
+		Unary<T, N>("PowScalar", Positive, [](const V& x) { return DVM::Pow(x, T(1.5)); });
+		Binary<T, N>("Pow", Positive, Signed, [](const V& x, const V& y) { return DVM::Pow(x, y); });
+		Unary<T, N>("Sqrt", Positive, [](const V& x) { return DVM::Sqrt(x); });
+		Unary<T, N>("Length", Signed, [](const V& x) { return DVM::Length(x); });
+		Unary<T, N>("Normalize", Signed, [](const V& x) { return DVM::Normalize(x); });
+		Binary<T, N>("Distance", Signed, Signed, [](const V& x, const V& y) { return DVM::Distance(x, y); });
+		Ternary<T, N>("FaceForward", Signed, [](const V& x, const V& y, const V& z) { return DVM::FaceForward(x, y, z); });
+		Binary<T, N>("Reflect", Signed, Signed, [](const V& x, const V& y) -> V { return DVM::Reflect(x, DVM::Normalize(y)); });
+		Binary<T, N>("Refract", Signed, Signed, [](const V& x, const V& y) -> V { return DVM::Refract(DVM::Normalize(x), DVM::Normalize(y), T(0.75)); });
+
+		if constexpr (N == 3)
+			Binary<T, N>("Cross", Signed, Signed, [](const V& x, const V& y) { return DVM::Cross(x, y); });
+
+		if constexpr (DVTL::Is_same_v<T, float>)
+		{
+			Unary<T, N>("FloatBitsToInt", Signed, [](const V& x) { return DVM::FloatBitsToInt(x); });
+			Unary<T, N>("FloatBitsToUint", Signed, [](const V& x) { return DVM::FloatBitsToUint(x); });
+		}
+	}
+
+	template<typename T>
+	void RegisterSizes()
+	{
+		RegisterArithmetic<T, 2>();
+		RegisterArithmetic<T, 3>();
+		RegisterArithmetic<T, 4>();
+
+		if constexpr (DVTL::Is_same_v<T, float> || DVTL::Is_same_v<T, double>)
+		{
+			RegisterFloating<T, 2>();
+			RegisterFloating<T, 3>();
+			RegisterFloating<T, 4>();
+		}
+	}
+
+	const bool registered = []
+	{
+		DVM::Bench::ForEachElementType([](auto type) { RegisterSizes<typename decltype(type)::type>(); });
+
+		using Vec4i = DVM::Vec4i;
+		Unary<int, 4>("IntBitsToFloat", Positive, [](const Vec4i& x) { return DVM::IntBitsToFloat(x); });
+		Unary<int, 4>("UintBitsToFloat", Positive, [](const Vec4i& x) { return DVM::UintBitsToFloat(DVM::Vec4ui(x)); });
+		return true;
+	}();
+}
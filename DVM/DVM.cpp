@@ -20,6 +20,6 @@ void printMat(const DVM::MatTemplate<T, C, R>& mat)
 int main()
 {
 	DVM::Vec3f vec(1, 2, 3);
-	DVM::MatTemplate<float, 3, 1> mat=vec;
+	DVM::MatTemplate<float, 3, 1> mat(vec[0], vec[1], vec[2]);
 	printMat(mat);
 }
\ No newline at end of file
@@ -0,0 +1,212 @@
+#ifndef DVM_ARENA_H
+#define DVM_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Math.h"
+#include "Memory.h"
+#include "Utility.h"
+
+//Bump allocator for the scratch memory of DVM algorithms. Allocation moves a pointer inside a block, nothing is
+//freed one by one: ArenaScope rewinds to where it started and Reset empties the arena. Blocks stay allocated
+//across rewinds, so once the arena has grown to the peak of a frame the same work allocates nothing from the heap.
+//Only types that need no destructor can live in an arena
+namespace DVM
+{
+	class Arena
+	{
+		struct Block
+		{
+			Block* next;
+			size_t size;
+		};
+
+		static constexpr size_t BlockHeader = DVTL::AlignUp(sizeof(Block), DVTL::CacheLineSize);
+
+	public:
+		//Position to rewind to, from Mark
+		struct Marker
+		{
+			Block* block;
+			size_t offset;
+			size_t used;
+		};
+
+		static constexpr size_t DefaultBlockSize = size_t(1) << 16;
+
+		//The first block is allocated on first use
+		explicit Arena(size_t blockSize = DefaultBlockSize) : blockSize(blockSize ? blockSize : DefaultBlockSize) {}
+
+		~Arena() { FreeBlocks(head); }
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		//Uninitialised memory, alignment must be a power of two
+		void* AllocateBytes(size_t bytes, size_t alignment = alignof(std::max_align_t))
+		{
+			size_t start = current ? AlignedOffset(current, offset, alignment) : 0;
+			if (!current || start + bytes > current->size)
+			{
+				NextBlock(bytes + alignment);
+				start = AlignedOffset(current, 0, alignment);
+			}
+
+			used += start - offset + bytes;
+			peak = Max(peak, used);
+			offset = start + bytes;
+			return BlockData(current) + start;
+		}
+
+		template<typename T>
+		T* Allocate(size_t count)
+		{
+			static_assert(DVTL::Is_trivially_copyable_v<T>, "the arena never runs destructors");
+			return static_cast<T*>(AllocateBytes(count * sizeof(T), alignof(T) < DVTL::CacheLineSize ? DVTL::CacheLineSize : alignof(T)));
+		}
+
+		template<typename T>
+		T* Allocate(size_t count, T value)
+		{
+			T* result = Allocate<T>(count);
+			for (size_t i = 0; i < count; ++i)
+				result[i] = value;
+			return result;
+		}
+
+		Marker Mark() const { return Marker{ current, offset, used }; }
+
+		//Frees everything allocated after marker was taken, markers must be released in reverse order
+		void Release(const Marker& marker)
+		{
+			current = marker.block;
+			offset = marker.offset;
+			used = marker.used;
+		}
+
+		//Frees everything. Blocks the last frame spilled into are merged into one, so the next frame of the same
+		//size fits in a single block
+		void Reset()
+		{
+			if (head && head->next)
+			{
+				size_t capacity = Capacity();
+				FreeBlocks(head);
+				head = NewBlock(capacity);
+			}
+
+			current = nullptr;
+			offset = 0;
+			used = 0;
+		}
+
+		//Bytes handed out since the last Reset, alignment padding included
+		size_t Used() const { return used; }
+		//Highest Used() since construction or ResetPeak
+		size_t Peak() const { return peak; }
+		void ResetPeak() { peak = used; }
+
+		//Bytes held in blocks
+		size_t Capacity() const
+		{
+			size_t capacity = 0;
+			for (Block* block = head; block; block = block->next)
+				capacity += block->size;
+			return capacity;
+		}
+
+		//Blocks allocated from the heap since construction, constant in a steady state
+		size_t HeapAllocations() const { return heapAllocations; }
+
+	private:
+		static unsigned char* BlockData(Block* block) { return reinterpret_cast<unsigned char*>(block) + BlockHeader; }
+
+		static size_t AlignedOffset(Block* block, size_t from, size_t alignment)
+		{
+			uintptr_t base = reinterpret_cast<uintptr_t>(BlockData(block));
+			return ((base + from + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+		}
+
+		Block* NewBlock(size_t size)
+		{
+			Block* block = static_cast<Block*>(DVTL::AlignedAlloc(BlockHeader + size));
+			block->next = nullptr;
+			block->size = size;
+			++heapAllocations;
+			return block;
+		}
+
+		static void FreeBlocks(Block* block)
+		{
+			while (block)
+			{
+				Block* next = block->next;
+				DVTL::AlignedFree(block);
+				block = next;
+			}
+		}
+
+		//Moves to the block after current, reusing it if it holds minSize bytes and replacing it otherwise.
+		//New blocks at least double, so a growing arena reaches its peak in a few heap allocations
+		void NextBlock(size_t minSize)
+		{
+			Block* next = current ? current->next : head;
+			if (!next || next->size < minSize)
+			{
+				Block* block = NewBlock(Max(minSize, current ? 2 * current->size : blockSize));
+				if (next)
+				{
+					block->next = next->next;
+					DVTL::AlignedFree(next);
+				}
+
+				if (current) current->next = block;
+				else head = block;
+				next = block;
+			}
+
+			current = next;
+			offset = 0;
+		}
+
+		Block* head = nullptr;
+		Block* current = nullptr;
+		size_t offset = 0;
+		size_t used = 0;
+		size_t peak = 0;
+		size_t blockSize;
+		size_t heapAllocations = 0;
+	};
+
+	//Scratch arena of the calling thread, ThreadPool workers each get their own
+	inline Arena& ThreadArena()
+	{
+		thread_local Arena arena;
+		return arena;
+	}
+
+	//Rewinds the arena to where it was on construction when it goes out of scope. Every DVM algorithm that takes
+	//scratch memory does so inside one, so they nest and return the arena as they found it
+	class ArenaScope
+	{
+	public:
+		explicit ArenaScope(Arena& arena = ThreadArena()) : arena(arena), marker(arena.Mark()) {}
+		~ArenaScope() { arena.Release(marker); }
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+		template<typename T>
+		T* Allocate(size_t count) { return arena.Allocate<T>(count); }
+
+		template<typename T>
+		T* Allocate(size_t count, T value) { return arena.Allocate<T>(count, value); }
+
+	private:
+		Arena& arena;
+		Arena::Marker marker;
+	};
+}
+
+#endif // !DVM_ARENA_H
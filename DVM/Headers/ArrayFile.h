@@ -0,0 +1,446 @@
+#ifndef DVM_ARRAYFILE_H
+#define DVM_ARRAYFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include "Half.h"
+#include "Matrix.h"
+#include "Utility.h"
+#include "Vector.h"
+
+//Binary container for arrays of VecTemplate and MatTemplate. A 64 byte header (magic, version, element type,
+//columns, rows, count, endianness) is followed by the elements exactly as they lie in memory, starting on a 64 byte
+//boundary. WriteArrayFile stores an array with one write, MappedArray opens a file read-only through the page
+//cache with no copy or parse, ArrayFileReader streams files larger than memory in chunks.
+//Every open and write returns false on failure, the element type of the file must match E exactly
+namespace DVM
+{
+	namespace Detail
+	{
+		constexpr uint32_t ArrayFileMagic = 0x41'4D'56'44; //"DVMA" read as little endian
+		constexpr uint16_t ArrayFileVersion = 1;
+		constexpr uint16_t ArrayFileEndianMark = 0x0102;
+		constexpr size_t ArrayFileHeaderSize = 64;
+
+		//Scalar type codes, the element size is stored next to them so long double only matches its own ABI
+		template<typename T> constexpr uint8_t ArrayScalarCode = 0;
+		template<> constexpr uint8_t ArrayScalarCode<signed char> = 1;
+		template<> constexpr uint8_t ArrayScalarCode<unsigned char> = 2;
+		template<> constexpr uint8_t ArrayScalarCode<char> = char(-1) < 0 ? 1 : 2;
+		template<> constexpr uint8_t ArrayScalarCode<short> = 3;
+		template<> constexpr uint8_t ArrayScalarCode<unsigned short> = 4;
+		template<> constexpr uint8_t ArrayScalarCode<int> = 5;
+		template<> constexpr uint8_t ArrayScalarCode<unsigned int> = 6;
+		template<> constexpr uint8_t ArrayScalarCode<long long> = 7;
+		template<> constexpr uint8_t ArrayScalarCode<unsigned long long> = 8;
+		template<> constexpr uint8_t ArrayScalarCode<float> = 9;
+		template<> constexpr uint8_t ArrayScalarCode<double> = 10;
+		template<> constexpr uint8_t ArrayScalarCode<long double> = 11;
+		template<> constexpr uint8_t ArrayScalarCode<Half> = 12;
+		template<> constexpr uint8_t ArrayScalarCode<BFloat16> = 13;
+
+		//Scalar type and shape of an element, vectors have one row
+		template<typename E> struct ArrayElement;
+
+		template<typename T, size_t N>
+		struct ArrayElement<VecTemplate<T, N>>
+		{
+			using Scalar = T;
+			static constexpr uint32_t Columns = N;
+			static constexpr uint32_t Rows = 1;
+			static constexpr uint8_t Kind = 1;
+		};
+
+		template<typename T, size_t C, size_t R>
+		struct ArrayElement<MatTemplate<T, C, R>>
+		{
+			using Scalar = T;
+			static constexpr uint32_t Columns = C;
+			static constexpr uint32_t Rows = R;
+			static constexpr uint8_t Kind = 2;
+		};
+
+		struct ArrayFileHeader
+		{
+			uint32_t magic;
+			uint16_t version;
+			uint16_t endianMark;
+			uint8_t kind;
+			uint8_t scalarCode;
+			uint8_t scalarSize;
+			uint8_t reserved0;
+			uint32_t columns;
+			uint32_t rows;
+			uint32_t reserved1;
+			uint64_t count;
+			uint64_t dataOffset;
+			uint8_t reserved2[24];
+		};
+		static_assert(sizeof(ArrayFileHeader) == ArrayFileHeaderSize, "the header must stay 64 bytes");
+
+		template<typename E>
+		inline void CheckArrayElement()
+		{
+			using Scalar = typename ArrayElement<E>::Scalar;
+			static_assert(ArrayScalarCode<Scalar> != 0, "unsupported scalar type");
+			static_assert(sizeof(E) == sizeof(Scalar) * ArrayElement<E>::Columns * ArrayElement<E>::Rows, "elements must not be padded");
+			static_assert(DVTL::Is_trivially_copyable_v<E>, "elements must be trivially copyable");
+		}
+
+		template<typename E>
+		inline ArrayFileHeader MakeArrayHeader(uint64_t count)
+		{
+			CheckArrayElement<E>();
+
+			ArrayFileHeader header{};
+			header.magic = ArrayFileMagic;
+			header.version = ArrayFileVersion;
+			header.endianMark = ArrayFileEndianMark;
+			header.kind = ArrayElement<E>::Kind;
+			header.scalarCode = ArrayScalarCode<typename ArrayElement<E>::Scalar>;
+			header.scalarSize = static_cast<uint8_t>(sizeof(typename ArrayElement<E>::Scalar));
+			header.columns = ArrayElement<E>::Columns;
+			header.rows = ArrayElement<E>::Rows;
+			header.count = count;
+			header.dataOffset = ArrayFileHeaderSize;
+			return header;
+		}
+
+		inline void ByteSwap(void* value, size_t size)
+		{
+			unsigned char* bytes = static_cast<unsigned char*>(value);
+			for (size_t i = 0; i < size / 2; ++i)
+			{
+				unsigned char temp = bytes[i];
+				bytes[i] = bytes[size - 1 - i];
+				bytes[size - 1 - i] = temp;
+			}
+		}
+
+		//Brings a header written on a machine of the other endianness to native order, sets swapped if it did
+		inline void NativeArrayHeader(ArrayFileHeader& header, bool& swapped)
+		{
+			swapped = header.endianMark != ArrayFileEndianMark;
+			if (!swapped) return;
+
+			ByteSwap(&header.magic, 4);
+			ByteSwap(&header.version, 2);
+			ByteSwap(&header.endianMark, 2);
+			ByteSwap(&header.columns, 4);
+			ByteSwap(&header.rows, 4);
+			ByteSwap(&header.count, 8);
+			ByteSwap(&header.dataOffset, 8);
+		}
+
+		//fileSize bounds count, so a truncated file fails to open instead of reading past its end. The elements must
+		//start on a 64 byte boundary like the mapping does, a misaligned offset would give misaligned SIMD loads
+		template<typename E>
+		inline bool ValidArrayHeader(const ArrayFileHeader& header, uint64_t fileSize)
+		{
+			ArrayFileHeader expected = MakeArrayHeader<E>(0);
+
+			return header.magic == ArrayFileMagic && header.version == ArrayFileVersion &&
+				header.endianMark == ArrayFileEndianMark && header.kind == expected.kind &&
+				header.scalarCode == expected.scalarCode && header.scalarSize == expected.scalarSize &&
+				header.columns == expected.columns && header.rows == expected.rows &&
+				header.dataOffset >= ArrayFileHeaderSize && header.dataOffset % ArrayFileHeaderSize == 0 && header.dataOffset <= fileSize &&
+				header.count <= (fileSize - header.dataOffset) / sizeof(E);
+		}
+	}
+
+	//Writes header and elements in one pass, replacing the file
+	template<typename E>
+	inline bool WriteArrayFile(const char* path, const E* elements, size_t count)
+	{
+		Detail::ArrayFileHeader header = Detail::MakeArrayHeader<E>(count);
+
+		std::FILE* file = std::fopen(path, "wb");
+		if (!file) return false;
+
+		bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+			(count == 0 || std::fwrite(elements, sizeof(E), count, file) == count);
+
+		return (std::fclose(file) == 0) && written;
+	}
+
+	//Appends elements in chunks, for arrays produced piece by piece. The count in the header is patched by Close,
+	//a file left unclosed reads as empty
+	template<typename E>
+	class ArrayFileWriter
+	{
+	public:
+		ArrayFileWriter() = default;
+		~ArrayFileWriter() { Close(); }
+
+		ArrayFileWriter(const ArrayFileWriter&) = delete;
+		ArrayFileWriter& operator=(const ArrayFileWriter&) = delete;
+
+		bool Open(const char* path)
+		{
+			Close();
+			file = std::fopen(path, "wb");
+			if (!file) return false;
+
+			Detail::ArrayFileHeader header = Detail::MakeArrayHeader<E>(0);
+			failed = std::fwrite(&header, sizeof(header), 1, file) != 1;
+			count = 0;
+			return !failed;
+		}
+
+		bool Append(const E* elements, size_t elementCount)
+		{
+			if (!file || failed) return false;
+			if (elementCount == 0) return true;
+
+			failed = std::fwrite(elements, sizeof(E), elementCount, file) != elementCount;
+			if (!failed) count += elementCount;
+			return !failed;
+		}
+
+		//False if any write failed, the file then must not be trusted
+		bool Close()
+		{
+			if (!file) return false;
+
+			Detail::ArrayFileHeader header = Detail::MakeArrayHeader<E>(count);
+			if (!failed)
+				failed = std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, file) != 1;
+
+			failed = std::fclose(file) != 0 || failed;
+			file = nullptr;
+			return !failed;
+		}
+
+		bool IsOpen() const { return file != nullptr; }
+		size_t Size() const { return count; }
+
+	private:
+		std::FILE* file = nullptr;
+		uint64_t count = 0;
+		bool failed = false;
+	};
+
+	//Read-only memory mapping of an array file, Data() points straight into the page cache and pages are read on
+	//first touch. Files of the other endianness cannot be viewed in place, read them with ArrayFileReader
+	template<typename E>
+	class MappedArray
+	{
+	public:
+		MappedArray() = default;
+		~MappedArray() { Close(); }
+
+		MappedArray(const MappedArray&) = delete;
+		MappedArray& operator=(const MappedArray&) = delete;
+
+		MappedArray(MappedArray&& right) noexcept { Swap(right); }
+		MappedArray& operator=(MappedArray&& right) noexcept
+		{
+			if (this != &right)
+			{
+				Close();
+				Swap(right);
+			}
+			return *this;
+		}
+
+		bool Open(const char* path)
+		{
+			Close();
+
+#if defined(_WIN32)
+			HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) return false;
+
+			LARGE_INTEGER size;
+			HANDLE mapping = nullptr;
+			if (GetFileSizeEx(file, &size) && static_cast<uint64_t>(size.QuadPart) >= Detail::ArrayFileHeaderSize)
+				mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (!mapping) return false;
+
+			void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+			if (!view) return false;
+
+			mapped = view;
+			mappedSize = static_cast<size_t>(size.QuadPart);
+#else
+			int file = open(path, O_RDONLY);
+			if (file < 0) return false;
+
+			struct stat status;
+			void* view = MAP_FAILED;
+			if (fstat(file, &status) == 0 && static_cast<uint64_t>(status.st_size) >= Detail::ArrayFileHeaderSize)
+				view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+			close(file);
+			if (view == MAP_FAILED) return false;
+
+			mapped = view;
+			mappedSize = static_cast<size_t>(status.st_size);
+#endif
+
+			Detail::ArrayFileHeader header;
+			std::memcpy(&header, mapped, sizeof(header));
+			if (!Detail::ValidArrayHeader<E>(header, mappedSize))
+			{
+				Close();
+				return false;
+			}
+
+			data = reinterpret_cast<const E*>(static_cast<const unsigned char*>(mapped) + header.dataOffset);
+			count = static_cast<size_t>(header.count);
+			return true;
+		}
+
+		void Close()
+		{
+			if (!mapped) return;
+
+#if defined(_WIN32)
+			UnmapViewOfFile(mapped);
+#else
+			munmap(mapped, mappedSize);
+#endif
+			mapped = nullptr;
+			mappedSize = 0;
+			data = nullptr;
+			count = 0;
+		}
+
+		void Swap(MappedArray& right) noexcept
+		{
+			void* tempMapped = mapped; mapped = right.mapped; right.mapped = tempMapped;
+			const E* tempData = data; data = right.data; right.data = tempData;
+			size_t temp = mappedSize; mappedSize = right.mappedSize; right.mappedSize = temp;
+			temp = count; count = right.count; right.count = temp;
+		}
+
+		bool IsOpen() const { return mapped != nullptr; }
+		size_t Size() const { return count; }
+		const E* Data() const { return data; }
+
+		const E* begin() const { return data; }
+		const E* end() const { return data + count; }
+
+		inline const E& operator[](size_t index) const { return data[index]; }
+
+	private:
+		void* mapped = nullptr;
+		size_t mappedSize = 0;
+		const E* data = nullptr;
+		size_t count = 0;
+	};
+
+	//Sequential reader holding only the caller's buffer in memory, for files larger than RAM. Files written on a
+	//machine of the other endianness are byte swapped while reading
+	template<typename E>
+	class ArrayFileReader
+	{
+	public:
+		ArrayFileReader() = default;
+		~ArrayFileReader() { Close(); }
+
+		ArrayFileReader(const ArrayFileReader&) = delete;
+		ArrayFileReader& operator=(const ArrayFileReader&) = delete;
+
+		bool Open(const char* path)
+		{
+			Close();
+			file = std::fopen(path, "rb");
+			if (!file) return false;
+
+			Detail::ArrayFileHeader header;
+			bool valid = std::fread(&header, sizeof(header), 1, file) == 1;
+			if (valid)
+			{
+				Detail::NativeArrayHeader(header, swapped);
+
+				//The file size is unknown without seeking to the end, a short file shows up as a short Read
+				valid = Detail::ValidArrayHeader<E>(header, ~uint64_t(0)) &&
+					SkipTo(header.dataOffset - Detail::ArrayFileHeaderSize);
+			}
+
+			if (!valid)
+			{
+				Close();
+				return false;
+			}
+
+			remaining = header.count;
+			total = header.count;
+			return true;
+		}
+
+		//Reads up to maxCount elements into out, returns how many were read. 0 at the end of the array or on error
+		size_t Read(E* out, size_t maxCount)
+		{
+			if (!file) return 0;
+
+			size_t wanted = static_cast<size_t>(Min<uint64_t>(remaining, maxCount));
+			size_t read = wanted ? std::fread(out, sizeof(E), wanted, file) : 0;
+			remaining = read == wanted ? remaining - read : 0;
+
+			if (swapped)
+			{
+				using Scalar = typename Detail::ArrayElement<E>::Scalar;
+				Scalar* scalars = reinterpret_cast<Scalar*>(out);
+				for (size_t i = 0; i < read * sizeof(E) / sizeof(Scalar); ++i)
+					Detail::ByteSwap(&scalars[i], sizeof(Scalar));
+			}
+
+			return read;
+		}
+
+		void Close()
+		{
+			if (file) std::fclose(file);
+			file = nullptr;
+			remaining = 0;
+			total = 0;
+			swapped = false;
+		}
+
+		bool IsOpen() const { return file != nullptr; }
+		//Elements in the file and elements not read yet
+		size_t Size() const { return static_cast<size_t>(total); }
+		size_t Remaining() const { return static_cast<size_t>(remaining); }
+
+	private:
+		bool SkipTo(uint64_t bytes)
+		{
+			char buffer[256];
+			while (bytes > 0)
+			{
+				size_t chunk = static_cast<size_t>(Min<uint64_t>(bytes, sizeof(buffer)));
+				if (std::fread(buffer, 1, chunk, file) != chunk) return false;
+				bytes -= chunk;
+			}
+			return true;
+		}
+
+		std::FILE* file = nullptr;
+		uint64_t remaining = 0;
+		uint64_t total = 0;
+		bool swapped = false;
+	};
+}
+
+#endif // !DVM_ARRAYFILE_H
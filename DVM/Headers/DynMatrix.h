@@ -0,0 +1,464 @@
+#ifndef DVM_DYNMATRIX_H
+#define DVM_DYNMATRIX_H
+
+#include "Math.h"
+#include "Matrix.h"
+#include "Memory.h"
+#include "Utility.h"
+
+namespace DVM
+{
+	//Non owning window into a matrix, column i starts at data + i * stride.
+	//Assigning to a view copies the elements, copying a view does not.
+	template<typename T>
+	struct DynMatrixView
+	{
+		DynMatrixView() : data(nullptr), columns(0), rows(0), stride(0) {}
+
+		DynMatrixView(T* data, size_t columns, size_t rows, size_t stride) : data(data), columns(columns), rows(rows), stride(stride) {}
+
+		DynMatrixView(const DynMatrixView& right) = default;
+
+		DynMatrixView& operator=(const DynMatrixView& right)
+		{
+			for (size_t i = 0; i < columns; ++i)
+				for (size_t j = 0; j < rows; ++j)
+					(*this)[i][j] = right[i][j];
+
+			return *this;
+		}
+
+		template<typename U>
+		DynMatrixView& operator=(const DynMatrixView<U>& right)
+		{
+			for (size_t i = 0; i < columns; ++i)
+				for (size_t j = 0; j < rows; ++j)
+					(*this)[i][j] = right[i][j];
+
+			return *this;
+		}
+
+		operator DynMatrixView<const T>() const { return DynMatrixView<const T>(data, columns, rows, stride); }
+
+		//Sub-block of columnCount x rowCount elements starting at (column, row)
+		DynMatrixView Block(size_t column, size_t row, size_t columnCount, size_t rowCount) const
+		{
+			return DynMatrixView(data + column * stride + row, columnCount, rowCount, stride);
+		}
+
+		size_t Columns() const { return columns; }
+		size_t Rows() const { return rows; }
+		size_t Stride() const { return stride; }
+		T* Data() const { return data; }
+
+		inline T* operator[](size_t index) const { return data + index * stride; }
+		inline T& operator()(size_t i, size_t j) const { return data[i * stride + j]; }
+
+		DynMatrixView& operator*=(T value);
+		DynMatrixView& operator*=(const DynMatrixView<const T>& value);
+		DynMatrixView& operator/=(T value);
+		DynMatrixView& operator/=(const DynMatrixView<const T>& value);
+		DynMatrixView& operator+=(T value);
+		DynMatrixView& operator+=(const DynMatrixView<const T>& value);
+		DynMatrixView& operator-=(T value);
+		DynMatrixView& operator-=(const DynMatrixView<const T>& value);
+
+	private:
+		T* data;
+		size_t columns;
+		size_t rows;
+		size_t stride;
+	};
+
+	//Composite statements of the DynMatrixView class
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator*=(T value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] *= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator*=(const DynMatrixView<const T>& value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] *= value[i][j];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator/=(T value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] /= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator/=(const DynMatrixView<const T>& value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] /= value[i][j];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator+=(T value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] += value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator+=(const DynMatrixView<const T>& value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] += value[i][j];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator-=(T value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] -= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrixView<T>& DynMatrixView<T>::operator-=(const DynMatrixView<const T>& value)
+	{
+		for (size_t i = 0; i < columns; ++i)
+			for (size_t j = 0; j < rows; ++j)
+				(*this)[i][j] -= value[i][j];
+
+		return *this;
+	}
+
+	//Matrix with dimensions chosen at run time, laid out like MatTemplate<T, C, R>:
+	//mat[i][j] = Data()[i * Rows() + j], stored on the heap on a cache line boundary
+	template<typename T>
+	struct DynMatrix
+	{
+		DynMatrix() : data(nullptr), columns(0), rows(0) {}
+
+		DynMatrix(size_t columns, size_t rows) : DynMatrix()
+		{
+			Allocate(columns, rows);
+			for (size_t i = 0; i < columns * rows; ++i)
+				data[i] = T{};
+		}
+
+		DynMatrix(const T* values, size_t columns, size_t rows) : DynMatrix()
+		{
+			Allocate(columns, rows);
+			for (size_t i = 0; i < columns * rows; ++i)
+				data[i] = values[i];
+		}
+
+		template<size_t C, size_t R>
+		DynMatrix(const MatTemplate<T, C, R>& mat) : DynMatrix(mat.data, C, R) {}
+
+		explicit DynMatrix(const DynMatrixView<const T>& view) : DynMatrix()
+		{
+			Allocate(view.Columns(), view.Rows());
+			View() = view;
+		}
+
+		DynMatrix(const DynMatrix& right) : DynMatrix(right.data, right.columns, right.rows) {}
+
+		DynMatrix(DynMatrix&& right) noexcept : DynMatrix() { Swap(right); }
+
+		DynMatrix& operator=(const DynMatrix& right)
+		{
+			if (this != &right)
+			{
+				DynMatrix temp(right);
+				Swap(temp);
+			}
+			return *this;
+		}
+
+		DynMatrix& operator=(DynMatrix&& right) noexcept
+		{
+			if (this != &right)
+			{
+				DynMatrix temp(DVTL::Move(right));
+				Swap(temp);
+			}
+			return *this;
+		}
+
+		~DynMatrix()
+		{
+			if (data)
+				DVTL::AlignedFree(data);
+		}
+
+		//Square matrix with diagonalValue on the diagonal. A factory rather than a constructor,
+		//DynMatrix(size, value) would be ambiguous with DynMatrix(columns, rows) for integral T
+		static DynMatrix Diagonal(size_t size, T diagonalValue)
+		{
+			DynMatrix result(size, size);
+			for (size_t i = 0; i < size; ++i)
+				result.data[i * size + i] = diagonalValue;
+			return result;
+		}
+
+		void Swap(DynMatrix& right) noexcept
+		{
+			T* tempData = data; data = right.data; right.data = tempData;
+			size_t temp = columns; columns = right.columns; right.columns = temp;
+			temp = rows; rows = right.rows; right.rows = temp;
+		}
+
+		//Keeps the overlapping block, new elements are zero
+		void Resize(size_t columnCount, size_t rowCount)
+		{
+			if (columnCount == columns && rowCount == rows) return;
+
+			DynMatrix temp(columnCount, rowCount);
+			temp.Block(0, 0, Min(columnCount, columns), Min(rowCount, rows)) = Block(0, 0, Min(columnCount, columns), Min(rowCount, rows));
+			Swap(temp);
+		}
+
+		size_t Columns() const { return columns; }
+		size_t Rows() const { return rows; }
+		size_t Size() const { return columns * rows; }
+
+		inline			T* Data()			{ return data; }
+		inline const	T* Data() const		{ return data; }
+
+		DynMatrixView<T> View() { return DynMatrixView<T>(data, columns, rows, rows); }
+		DynMatrixView<const T> View() const { return DynMatrixView<const T>(data, columns, rows, rows); }
+
+		DynMatrixView<T> Block(size_t column, size_t row, size_t columnCount, size_t rowCount) { return View().Block(column, row, columnCount, rowCount); }
+		DynMatrixView<const T> Block(size_t column, size_t row, size_t columnCount, size_t rowCount) const { return View().Block(column, row, columnCount, rowCount); }
+
+		inline			T* operator[](size_t index)			{ return &data[index * rows]; }
+		inline const	T* operator[](size_t index) const	{ return &data[index * rows]; }
+		inline			T& operator()(size_t i, size_t j)		{ return data[i * rows + j]; }
+		inline const	T& operator()(size_t i, size_t j) const	{ return data[i * rows + j]; }
+
+		DynMatrix& operator++();
+		DynMatrix& operator--();
+		const DynMatrix operator++(int);
+		const DynMatrix operator--(int);
+
+		//Composite statements of the DynMatrix class, matrix operands must have the same dimensions
+		DynMatrix& operator*=(T value);
+		DynMatrix& operator*=(const DynMatrix& value);
+		DynMatrix& operator/=(T value);
+		DynMatrix& operator/=(const DynMatrix& value);
+		DynMatrix& operator+=(T value);
+		DynMatrix& operator+=(const DynMatrix& value);
+		DynMatrix& operator-=(T value);
+		DynMatrix& operator-=(const DynMatrix& value);
+
+	private:
+		void Allocate(size_t columnCount, size_t rowCount)
+		{
+			columns = columnCount;
+			rows = rowCount;
+			if (columns * rows != 0)
+				data = static_cast<T*>(DVTL::AlignedAlloc(columns * rows * sizeof(T)));
+		}
+
+		T* data;
+		size_t columns;
+		size_t rows;
+	};
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator++()
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			++data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator--()
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			--data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline const DynMatrix<T> DynMatrix<T>::operator++(int)
+	{
+		DynMatrix temp(*this);
+		++(*this);
+		return temp;
+	}
+
+	template<typename T>
+	inline const DynMatrix<T> DynMatrix<T>::operator--(int)
+	{
+		DynMatrix temp(*this);
+		--(*this);
+		return temp;
+	}
+
+	//Composite statements of the DynMatrix class
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator*=(T value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] *= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator*=(const DynMatrix& value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] *= value.data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator/=(T value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] /= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator/=(const DynMatrix& value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] /= value.data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator+=(T value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] += value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator+=(const DynMatrix& value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] += value.data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator-=(T value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] -= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynMatrix<T>& DynMatrix<T>::operator-=(const DynMatrix& value)
+	{
+		for (size_t i = 0; i < columns * rows; ++i)
+			data[i] -= value.data[i];
+
+		return *this;
+	}
+
+	//External operators of the DynMatrix class
+	template<typename T>
+	DynMatrix<T> operator*(DynMatrix<T> lhs, T rhs)
+	{
+		lhs *= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator*(T lhs, DynMatrix<T> rhs)
+	{
+		rhs *= lhs;
+		return rhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator*(DynMatrix<T> lhs, const DynMatrix<T>& rhs)
+	{
+		lhs *= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator/(DynMatrix<T> lhs, T rhs)
+	{
+		lhs /= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator/(DynMatrix<T> lhs, const DynMatrix<T>& rhs)
+	{
+		lhs /= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator+(DynMatrix<T> lhs, T rhs)
+	{
+		lhs += rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator+(DynMatrix<T> lhs, const DynMatrix<T>& rhs)
+	{
+		lhs += rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator-(DynMatrix<T> lhs, T rhs)
+	{
+		lhs -= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynMatrix<T> operator-(DynMatrix<T> lhs, const DynMatrix<T>& rhs)
+	{
+		lhs -= rhs;
+		return lhs;
+	}
+
+	using DynMatrixf = DynMatrix<float>;
+	using DynMatrixd = DynMatrix<double>;
+	using DynMatrixi = DynMatrix<int>;
+}
+
+#endif // !DVM_DYNMATRIX_H
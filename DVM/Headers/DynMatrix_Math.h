@@ -0,0 +1,179 @@
+#ifndef DVM_DYNMATRIX_MATH_H
+#define DVM_DYNMATRIX_MATH_H
+
+#include "Arena.h"
+#include "DynMatrix.h"
+#include "DynVector.h"
+#include "Math.h"
+#include "Matrix_Kernels.h"
+#include "Utility.h"
+
+//Matrix_Math.h functions for DynMatrix. Square matrices are required where the fixed size versions
+//static_assert it, Determinant, Inverse and Solve always take the LU path with their workspace in ThreadArena()
+namespace DVM
+{
+	namespace Detail
+	{
+		//Copy of mat converted to F in the scratch arena
+		template<typename F, typename T>
+		inline F* ConvertToScratch(ArenaScope& scratch, const DynMatrix<T>& mat)
+		{
+			F* result = scratch.Allocate<F>(mat.Size());
+			for (size_t i = 0; i < mat.Size(); ++i)
+				result[i] = template_cast<F>(mat.Data()[i]);
+			return result;
+		}
+
+		//Square mat converted to F with rows and columns exchanged: linearTransformation reads mat[j][i] as row i,
+		//column j, the LU kernels want row i at result[i * n]
+		template<typename F, typename T>
+		inline F* TransposeToScratch(ArenaScope& scratch, const DynMatrix<T>& mat)
+		{
+			size_t n = mat.Columns();
+			F* result = scratch.Allocate<F>(n * n);
+			for (size_t i = 0; i < n; ++i)
+				for (size_t j = 0; j < n; ++j)
+					result[i * n + j] = template_cast<F>(mat[j][i]);
+			return result;
+		}
+	}
+
+	template<typename T>
+	inline T Determinant(const DynMatrix<T>& mat)
+	{
+		size_t n = mat.Columns();
+		ArenaScope scratch;
+		T* temp = Detail::ConvertToScratch<T>(scratch, mat);
+
+		if constexpr (DVTL::Is_floating_point_v<T>)
+		{
+			size_t* pivot = scratch.Allocate<size_t>(n);
+			T sign = 1;
+			if (!DVM_INSTRUMENT_CALL(Detail::LUDecompose(temp, n, pivot, sign))) return template_cast<T>(0);
+
+			return Detail::LUDeterminant(temp, n, sign);
+		}
+		else
+			return DVM_INSTRUMENT_CALL(Detail::BareissDeterminant(temp, n));
+	}
+
+	//Returns an empty matrix of the same size if mat is singular
+	template<typename T>
+	inline DynMatrix<T> Inverse(const DynMatrix<T>& mat)
+	{
+		using F = Detail::LUValue_t<T>;
+
+		size_t n = mat.Columns();
+		ArenaScope scratch;
+		F* lu = Detail::ConvertToScratch<F>(scratch, mat);
+		size_t* pivot = scratch.Allocate<size_t>(n);
+		F sign = 1;
+		if (!DVM_INSTRUMENT_CALL(Detail::LUDecompose(lu, n, pivot, sign))) return DynMatrix<T>(n, n);
+
+		DynMatrix<T> resultMat(n, n);
+		F* column = scratch.Allocate<F>(n);
+
+		if constexpr (DVTL::Is_same_v<T, F>)
+			Detail::LUInverse(lu, n, pivot, resultMat.Data(), column);
+		else
+		{
+			F* inverse = scratch.Allocate<F>(n * n);
+			Detail::LUInverse(lu, n, pivot, inverse, column);
+			for (size_t i = 0; i < n * n; ++i)
+				resultMat.Data()[i] = Detail::FromLUValue<T>(inverse[i]);
+		}
+
+		return resultMat;
+	}
+
+	//x such that linearTransformation(mat, x) == vec, a zero vector if mat is singular
+	template<typename T>
+	inline DynVector<T> Solve(const DynMatrix<T>& mat, const DynVector<T>& vec)
+	{
+		using F = Detail::LUValue_t<T>;
+
+		size_t n = mat.Columns();
+
+		ArenaScope scratch;
+		F* lu = Detail::TransposeToScratch<F>(scratch, mat);
+		size_t* pivot = scratch.Allocate<size_t>(n);
+		F sign = 1;
+		if (!DVM_INSTRUMENT_CALL(Detail::LUDecompose(lu, n, pivot, sign))) return DynVector<T>(n);
+
+		F* x = scratch.Allocate<F>(n);
+		for (size_t i = 0; i < n; ++i)
+			x[i] = template_cast<F>(vec[i]);
+
+		Detail::LUSolve(lu, n, pivot, x, x);
+
+		DynVector<T> result(n);
+		for (size_t i = 0; i < n; ++i)
+			result[i] = Detail::FromLUValue<T>(x[i]);
+
+		return result;
+	}
+
+	//matX.Rows() must equal matY.Columns()
+	template<typename T>
+	inline DynMatrix<T> matrixMultiplication(const DynMatrix<T>& matX, const DynMatrix<T>& matY)
+	{
+		DynMatrix<T> result(matX.Columns(), matY.Rows());
+		Detail::Gemm(matX.Data(), matY.Data(), result.Data(), matX.Columns(), matX.Rows(), matY.Rows());
+		return result;
+	}
+
+	template<typename T>
+	inline DynMatrix<T> MatrixCompMult(DynMatrix<T> matX, const DynMatrix<T>& matY)
+	{
+		matX *= matY;
+		return matX;
+	}
+
+	template<typename T>
+	inline DynMatrix<T> OuterProduct(const DynVector<T>& vecC, const DynVector<T>& vecR)
+	{
+		DynMatrix<T> result(vecC.Size(), vecR.Size());
+
+		for (size_t i = 0; i < vecC.Size(); ++i)
+			for (size_t j = 0; j < vecR.Size(); ++j)
+				result[i][j] = vecC[i] * vecR[j];
+
+		return result;
+	}
+
+	template<typename T>
+	inline DynMatrix<T> Transpose(const DynMatrix<T>& matX)
+	{
+		//Tiles keep both the reads and the strided writes inside a few cache lines
+		constexpr size_t Tile = 16;
+		DynMatrix<T> result(matX.Rows(), matX.Columns());
+
+		for (size_t i0 = 0; i0 < matX.Columns(); i0 += Tile)
+			for (size_t j0 = 0; j0 < matX.Rows(); j0 += Tile)
+				for (size_t i = i0; i < Min(i0 + Tile, matX.Columns()); ++i)
+					for (size_t j = j0; j < Min(j0 + Tile, matX.Rows()); ++j)
+						result[j][i] = matX[i][j];
+
+		return result;
+	}
+
+	//Sum of the columns mat[j] weighted by vec[j], vec has Columns() values and the result Rows()
+	template<typename T>
+	inline DynVector<T> linearTransformation(const DynMatrix<T>& mat, const DynVector<T>& vec)
+	{
+		DynVector<T> result(mat.Rows());
+
+		for (size_t j = 0; j < mat.Columns(); ++j)
+		{
+			const T* column = mat[j];
+			T weight = vec[j];
+
+			for (size_t i = 0; i < mat.Rows(); ++i)
+				result[i] += column[i] * weight;
+		}
+
+		return result;
+	}
+}
+
+#endif // !DVM_DYNMATRIX_MATH_H
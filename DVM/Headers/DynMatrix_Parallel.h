@@ -0,0 +1,155 @@
+#ifndef DVM_DYNMATRIX_PARALLEL_H
+#define DVM_DYNMATRIX_PARALLEL_H
+
+#include "Arena.h"
+#include "DynMatrix.h"
+#include "DynMatrix_Math.h"
+#include "DynVector.h"
+#include "Math.h"
+#include "Matrix_Kernels.h"
+#include "ThreadPool.h"
+#include "Utility.h"
+
+//DynMatrix_Math.h functions split over a ThreadPool. Every output element is computed by one thread in the
+//same order as the serial version, so results match it bit for bit for any thread count
+namespace DVM
+{
+	namespace Detail
+	{
+		//Executor for the Matrix_Kernels.h functions that runs the parts on a pool
+		struct PoolExecutor
+		{
+			ThreadPool& pool;
+
+			template<typename F>
+			void operator()(size_t count, size_t grain, F&& function) const { pool.ParallelFor(0, count, grain, DVTL::Forward<F>(function)); }
+		};
+
+		//Below this many multiply-adds splitting costs more than it saves
+		constexpr size_t ParallelMinWork = size_t(1) << 15;
+	}
+
+	//matX.Rows() must equal matY.Columns()
+	template<typename T>
+	inline DynMatrix<T> matrixMultiplication(ThreadPool& pool, const DynMatrix<T>& matX, const DynMatrix<T>& matY)
+	{
+		size_t m = matX.Columns();
+		size_t n = matX.Rows();
+		size_t k = matY.Rows();
+
+		if (m * n * k < Detail::ParallelMinWork) return matrixMultiplication(matX, matY);
+
+		DynMatrix<T> result(m, k);
+		Detail::GemmAccumulate(matX.Data(), n, matY.Data(), k, result.Data(), k, m, n, k, Detail::PoolExecutor{ pool });
+		return result;
+	}
+
+	//Returns an empty matrix of the same size if mat is singular
+	template<typename T>
+	inline DynMatrix<T> Inverse(ThreadPool& pool, const DynMatrix<T>& mat)
+	{
+		using F = Detail::LUValue_t<T>;
+
+		size_t n = mat.Columns();
+		if (n <= Detail::LUBlock) return Inverse(mat);
+
+		ArenaScope scratch;
+		F* lu = Detail::ConvertToScratch<F>(scratch, mat);
+		size_t* pivot = scratch.Allocate<size_t>(n);
+		F sign = 1;
+		if (!DVM_INSTRUMENT_CALL(Detail::LUDecomposeBlocked(lu, n, pivot, sign, Detail::PoolExecutor{ pool }))) return DynMatrix<T>(n, n);
+
+		DynMatrix<T> resultMat(n, n);
+		F* inverse = nullptr;
+		if constexpr (DVTL::Is_same_v<T, F>)
+			inverse = resultMat.Data();
+		else
+			inverse = scratch.Allocate<F>(n * n);
+
+		//Every part solves its own columns of the inverse with a scratch column from its thread's arena
+		pool.ParallelFor(0, n, 8, [&](size_t first, size_t last)
+		{
+			ArenaScope partScratch;
+			Detail::LUInverseColumns(lu, n, pivot, inverse, partScratch.Allocate<F>(n), first, last);
+		});
+
+		if constexpr (!DVTL::Is_same_v<T, F>)
+			for (size_t i = 0; i < n * n; ++i)
+				resultMat.Data()[i] = Detail::FromLUValue<T>(inverse[i]);
+
+		return resultMat;
+	}
+
+	//x such that linearTransformation(mat, x) == vec, a zero vector if mat is singular.
+	//Only the factorization is split, the substitution is a small part of the work
+	template<typename T>
+	inline DynVector<T> Solve(ThreadPool& pool, const DynMatrix<T>& mat, const DynVector<T>& vec)
+	{
+		using F = Detail::LUValue_t<T>;
+
+		size_t n = mat.Columns();
+		if (n <= Detail::LUBlock) return Solve(mat, vec);
+
+		ArenaScope scratch;
+		F* lu = Detail::TransposeToScratch<F>(scratch, mat);
+		size_t* pivot = scratch.Allocate<size_t>(n);
+		F sign = 1;
+		if (!DVM_INSTRUMENT_CALL(Detail::LUDecomposeBlocked(lu, n, pivot, sign, Detail::PoolExecutor{ pool }))) return DynVector<T>(n);
+
+		F* x = scratch.Allocate<F>(n);
+		for (size_t i = 0; i < n; ++i)
+			x[i] = template_cast<F>(vec[i]);
+
+		Detail::LUSolve(lu, n, pivot, x, x);
+
+		DynVector<T> result(n);
+		for (size_t i = 0; i < n; ++i)
+			result[i] = Detail::FromLUValue<T>(x[i]);
+
+		return result;
+	}
+
+	template<typename T>
+	inline DynMatrix<T> Transpose(ThreadPool& pool, const DynMatrix<T>& matX)
+	{
+		constexpr size_t Tile = 16;
+		DynMatrix<T> result(matX.Rows(), matX.Columns());
+
+		//Parts own whole tile columns of matX, so no two parts write the same element of result
+		size_t tiles = (matX.Columns() + Tile - 1) / Tile;
+		pool.ParallelFor(0, tiles, 4, [&](size_t first, size_t last)
+		{
+			for (size_t i0 = first * Tile; i0 < Min(last * Tile, matX.Columns()); i0 += Tile)
+				for (size_t j0 = 0; j0 < matX.Rows(); j0 += Tile)
+					for (size_t i = i0; i < Min(i0 + Tile, matX.Columns()); ++i)
+						for (size_t j = j0; j < Min(j0 + Tile, matX.Rows()); ++j)
+							result[j][i] = matX[i][j];
+		});
+
+		return result;
+	}
+
+	//Parts own a range of result values and sum every column over it
+	template<typename T>
+	inline DynVector<T> linearTransformation(ThreadPool& pool, const DynMatrix<T>& mat, const DynVector<T>& vec)
+	{
+		if (mat.Size() < Detail::ParallelMinWork) return linearTransformation(mat, vec);
+
+		DynVector<T> result(mat.Rows());
+		pool.ParallelFor(0, mat.Rows(), 1024, [&](size_t first, size_t last)
+		{
+			for (size_t j = 0; j < mat.Columns(); ++j)
+			{
+				const T* column = mat[j];
+				T weight = vec[j];
+
+				for (size_t i = first; i < last; ++i)
+					result[i] += column[i] * weight;
+			}
+		});
+
+		return result;
+	}
+}
+
+#endif // !DVM_DYNMATRIX_PARALLEL_H
@@ -0,0 +1,468 @@
+#ifndef DVM_DYNVECTOR_H
+#define DVM_DYNVECTOR_H
+
+#include "Math.h"
+#include "Memory.h"
+#include "Utility.h"
+#include "Vector.h"
+
+namespace DVM
+{
+	//Vector with a size chosen at run time, stored on the heap on a cache line boundary.
+	//Operators between two vectors require equal sizes.
+	template<typename T>
+	struct DynVector
+	{
+		DynVector() : data(nullptr), size(0) {}
+
+		explicit DynVector(size_t count) : DynVector(count, T{}) {}
+
+		DynVector(size_t count, T value) : DynVector()
+		{
+			Allocate(count);
+			for (size_t i = 0; i < size; ++i)
+				data[i] = value;
+		}
+
+		DynVector(const T* values, size_t count) : DynVector()
+		{
+			Allocate(count);
+			for (size_t i = 0; i < size; ++i)
+				data[i] = values[i];
+		}
+
+		template<size_t N>
+		DynVector(const VecTemplate<T, N>& vec) : DynVector(vec.data, N) {}
+
+		DynVector(const DynVector& right) : DynVector(right.data, right.size) {}
+
+		DynVector(DynVector&& right) noexcept : DynVector() { Swap(right); }
+
+		DynVector& operator=(const DynVector& right)
+		{
+			if (this != &right)
+			{
+				DynVector temp(right);
+				Swap(temp);
+			}
+			return *this;
+		}
+
+		DynVector& operator=(DynVector&& right) noexcept
+		{
+			if (this != &right)
+			{
+				DynVector temp(DVTL::Move(right));
+				Swap(temp);
+			}
+			return *this;
+		}
+
+		~DynVector()
+		{
+			if (data)
+				DVTL::AlignedFree(data);
+		}
+
+		void Swap(DynVector& right) noexcept
+		{
+			T* tempData = data; data = right.data; right.data = tempData;
+			size_t tempSize = size; size = right.size; right.size = tempSize;
+		}
+
+		//Keeps the first Min(count, Size()) values, new values are zero
+		void Resize(size_t count)
+		{
+			if (count == size) return;
+
+			DynVector temp(count);
+			for (size_t i = 0; i < Min(count, size); ++i)
+				temp.data[i] = data[i];
+
+			Swap(temp);
+		}
+
+		size_t Size() const { return size; }
+
+		inline			T* Data()			{ return data; }
+		inline const	T* Data() const		{ return data; }
+
+		inline			T& operator[](size_t index)			{ return data[index]; }
+		inline const	T& operator[](size_t index) const	{ return data[index]; }
+
+		DynVector& operator++();
+		DynVector& operator--();
+		const DynVector operator++(int);
+		const DynVector operator--(int);
+
+		//Composite statements of the DynVector class, vector operands must have the same size
+		DynVector& operator%=(T value);
+		DynVector& operator%=(const DynVector& value);
+		DynVector& operator*=(T value);
+		DynVector& operator*=(const DynVector& value);
+		DynVector& operator/=(T value);
+		DynVector& operator/=(const DynVector& value);
+		DynVector& operator+=(T value);
+		DynVector& operator+=(const DynVector& value);
+		DynVector& operator-=(T value);
+		DynVector& operator-=(const DynVector& value);
+
+		DynVector& operator<<=(int shift);
+		DynVector& operator>>=(int shift);
+
+		DynVector& operator^=(T value);
+		DynVector& operator^=(const DynVector& value);
+		DynVector& operator|=(T value);
+		DynVector& operator|=(const DynVector& value);
+		DynVector& operator&=(T value);
+		DynVector& operator&=(const DynVector& value);
+
+	private:
+		void Allocate(size_t count)
+		{
+			size = count;
+			if (size)
+				data = static_cast<T*>(DVTL::AlignedAlloc(size * sizeof(T)));
+		}
+
+		T* data;
+		size_t size;
+	};
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator++()
+	{
+		for (size_t i = 0; i < size; ++i)
+			++data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator--()
+	{
+		for (size_t i = 0; i < size; ++i)
+			--data[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline const DynVector<T> DynVector<T>::operator++(int)
+	{
+		DynVector temp(*this);
+		++(*this);
+		return temp;
+	}
+
+	template<typename T>
+	inline const DynVector<T> DynVector<T>::operator--(int)
+	{
+		DynVector temp(*this);
+		--(*this);
+		return temp;
+	}
+
+	//Composite statements of the DynVector class
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator%=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] = Mod(data[i], value);
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator%=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] = Mod(data[i], value[i]);
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator*=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] *= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator*=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] *= value[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator/=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] /= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator/=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] /= value[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator+=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] += value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator+=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] += value[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator-=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] -= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator-=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] -= value[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator<<=(int shift)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] <<= shift;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator>>=(int shift)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] >>= shift;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator^=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] ^= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator^=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] ^= value[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator|=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] |= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator|=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] |= value[i];
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator&=(T value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] &= value;
+
+		return *this;
+	}
+
+	template<typename T>
+	inline DynVector<T>& DynVector<T>::operator&=(const DynVector& value)
+	{
+		for (size_t i = 0; i < size; ++i)
+			data[i] &= value[i];
+
+		return *this;
+	}
+
+	//External operators of the DynVector class
+	template<typename T>
+	DynVector<T> operator%(DynVector<T> lhs, T rhs)
+	{
+		lhs %= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator%(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs %= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator*(DynVector<T> lhs, T rhs)
+	{
+		lhs *= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator*(T lhs, DynVector<T> rhs)
+	{
+		rhs *= lhs;
+		return rhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator*(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs *= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator/(DynVector<T> lhs, T rhs)
+	{
+		lhs /= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator/(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs /= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator+(DynVector<T> lhs, T rhs)
+	{
+		lhs += rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator+(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs += rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator-(DynVector<T> lhs, T rhs)
+	{
+		lhs -= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator-(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs -= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator<<(DynVector<T> lhs, int rhs)
+	{
+		lhs <<= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator>>(DynVector<T> lhs, int rhs)
+	{
+		lhs >>= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator^(DynVector<T> lhs, T rhs)
+	{
+		lhs ^= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator^(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs ^= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator|(DynVector<T> lhs, T rhs)
+	{
+		lhs |= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator|(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs |= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator&(DynVector<T> lhs, T rhs)
+	{
+		lhs &= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	DynVector<T> operator&(DynVector<T> lhs, const DynVector<T>& rhs)
+	{
+		lhs &= rhs;
+		return lhs;
+	}
+
+	using DynVectorf = DynVector<float>;
+	using DynVectord = DynVector<double>;
+	using DynVectori = DynVector<int>;
+}
+
+#endif // !DVM_DYNVECTOR_H
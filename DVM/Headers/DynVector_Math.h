@@ -0,0 +1,172 @@
+#ifndef DVM_DYNVECTOR_MATH_H
+#define DVM_DYNVECTOR_MATH_H
+
+#include "DynVector.h"
+#include "Math.h"
+#include "Math_Batch.h"
+#include "SIMD.h"
+
+//Vector_Math.h functions for DynVector, vector arguments must have the same size
+namespace DVM
+{
+	namespace Detail
+	{
+		template<typename T>
+		inline T DotSpan(const T* x, const T* y, size_t count)
+		{
+			size_t i = 0;
+			T result = T{};
+
+#if defined(DVM_SIMD_SSE2)
+			if constexpr (DVTL::Is_same_v<T, float> || DVTL::Is_same_v<T, double>)
+			{
+				using L = SIMD::WideLane_t<T>;
+
+				//Two accumulators hide the latency of the multiply-add chain
+				L sum0 = L::Set(T(0));
+				L sum1 = L::Set(T(0));
+				for (; i + 2 * L::Width <= count; i += 2 * L::Width)
+				{
+					sum0 = SIMD::MulAdd(L::Load(x + i), L::Load(y + i), sum0);
+					sum1 = SIMD::MulAdd(L::Load(x + i + L::Width), L::Load(y + i + L::Width), sum1);
+				}
+
+				T lanes[L::Width];
+				(sum0 + sum1).Store(lanes);
+				for (size_t j = 0; j < L::Width; ++j)
+					result += lanes[j];
+			}
+#endif
+			for (; i < count; ++i)
+				result += x[i] * y[i];
+
+			return result;
+		}
+	}
+
+	template<typename T>
+	inline T Dot(const DynVector<T>& x, const DynVector<T>& y)
+	{
+		return Detail::DotSpan(x.Data(), y.Data(), x.Size());
+	}
+
+	template<typename T>
+	inline floatingPoint_t<T> Length(const DynVector<T>& vec)
+	{
+		return Sqrt(template_cast<floatingPoint_t<T>>(Dot(vec, vec)));
+	}
+
+	template<typename T>
+	inline floatingPoint_t<T> Distance(const DynVector<T>& p1, const DynVector<T>& p2)
+	{
+		return Length(p1 - p2);
+	}
+
+	template<typename T>
+	inline DynVector<T> Normalize(const DynVector<T>& vec)
+	{
+		floatingPoint_t<T> length = Length(vec);
+		if (length < getEpsilon<floatingPoint_t<T>>()) return DynVector<T>(vec.Size());
+
+		return vec * template_cast<T>(1 / length);
+	}
+
+	template<typename T>
+	inline DynVector<T> Abs(DynVector<T> vec)
+	{
+		for (size_t i = 0; i < vec.Size(); ++i)
+			vec[i] = Abs(vec[i]);
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Min(DynVector<T> vec, T val)
+	{
+		for (size_t i = 0; i < vec.Size(); ++i)
+			vec[i] = Min(vec[i], val);
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Min(DynVector<T> vec, const DynVector<T>& vec2)
+	{
+		for (size_t i = 0; i < vec.Size(); ++i)
+			vec[i] = Min(vec[i], vec2[i]);
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Max(DynVector<T> vec, T val)
+	{
+		for (size_t i = 0; i < vec.Size(); ++i)
+			vec[i] = Max(vec[i], val);
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Max(DynVector<T> vec, const DynVector<T>& vec2)
+	{
+		for (size_t i = 0; i < vec.Size(); ++i)
+			vec[i] = Max(vec[i], vec2[i]);
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Clamp(DynVector<T> vec, T min, T max)
+	{
+		for (size_t i = 0; i < vec.Size(); ++i)
+			vec[i] = Clamp(vec[i], min, max);
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Exp(DynVector<T> vec)
+	{
+		ExpBatch(vec.Data(), vec.Data(), vec.Size());
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Exp2(DynVector<T> vec)
+	{
+		Exp2Batch(vec.Data(), vec.Data(), vec.Size());
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Log(DynVector<T> vec)
+	{
+		LogBatch(vec.Data(), vec.Data(), vec.Size());
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Log2(DynVector<T> vec)
+	{
+		Log2Batch(vec.Data(), vec.Data(), vec.Size());
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Sqrt(DynVector<T> vec)
+	{
+		SqrtBatch(vec.Data(), vec.Data(), vec.Size());
+		return vec;
+	}
+
+	template<typename T>
+	inline DynVector<T> Pow(DynVector<T> vecbase, T exp)
+	{
+		PowBatch(vecbase.Data(), exp, vecbase.Data(), vecbase.Size());
+		return vecbase;
+	}
+
+	template<typename T>
+	inline DynVector<T> Pow(DynVector<T> vecbase, const DynVector<T>& vecexp)
+	{
+		PowBatch(vecbase.Data(), vecexp.Data(), vecbase.Data(), vecbase.Size());
+		return vecbase;
+	}
+}
+
+#endif // !DVM_DYNVECTOR_MATH_H
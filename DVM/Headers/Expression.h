@@ -0,0 +1,236 @@
+#ifndef DVM_EXPRESSION_H
+#define DVM_EXPRESSION_H
+
+#include <cstddef>
+
+#include "Utility.h"
+
+//Lazy elementwise + - * / for VecTemplate and MatTemplate, enabled by defining DVM_EXPRESSION_TEMPLATES.
+//a * s + b * t - c then builds one expression that is evaluated in a single loop when it is assigned or
+//converted, instead of making a temporary and a pass per operator. Without the define the eager operators
+//of Vector.h and Matrix.h are used, which are easier to step through in a debugger.
+//Expressions refer to their vector and matrix operands, an expression kept with auto must not outlive them.
+//Eval gives the vector or matrix of an expression, e.g. to pass it to a function template like Length
+namespace DVM
+{
+	template<typename T, size_t N> struct VecTemplate;
+	template<typename T, size_t C, size_t R> struct MatTemplate;
+
+	namespace Detail
+	{
+		//Value is the element type and Result the vector or matrix an operand evaluates to
+		template<typename E>
+		struct ExpressionTraits
+		{
+			static constexpr bool isOperand = false;
+			static constexpr bool isExpression = false;
+		};
+
+		template<typename T, size_t N>
+		struct ExpressionTraits<VecTemplate<T, N>>
+		{
+			static constexpr bool isOperand = true;
+			static constexpr bool isExpression = false;
+			using Value = T;
+			using Result = VecTemplate<T, N>;
+		};
+
+		template<typename T, size_t C, size_t R>
+		struct ExpressionTraits<MatTemplate<T, C, R>>
+		{
+			static constexpr bool isOperand = true;
+			static constexpr bool isExpression = false;
+			using Value = T;
+			using Result = MatTemplate<T, C, R>;
+		};
+
+		template<typename E> constexpr bool IsExpression_v = ExpressionTraits<E>::isExpression;
+
+		template<typename L, typename R, bool = ExpressionTraits<L>::isOperand && ExpressionTraits<R>::isOperand>
+		struct ElementwiseOperands { static constexpr bool value = false; };
+
+		template<typename L, typename R>
+		struct ElementwiseOperands<L, R, true> { static constexpr bool value = DVTL::Is_same_v<typename ExpressionTraits<L>::Result, typename ExpressionTraits<R>::Result>; };
+
+		template<typename L, typename S, bool = ExpressionTraits<L>::isOperand>
+		struct ScalarOperands { static constexpr bool value = false; };
+
+		template<typename L, typename S>
+		struct ScalarOperands<L, S, true> { static constexpr bool value = DVTL::Is_same_v<typename ExpressionTraits<L>::Value, S>; };
+
+		//Leaves of an expression
+		template<typename T>
+		struct ExpressionTerminal
+		{
+			const T* data;
+
+			constexpr T Element(size_t index) const { return data[index]; }
+		};
+
+		template<typename T>
+		struct ExpressionScalar
+		{
+			T value;
+
+			constexpr T Element(size_t) const { return value; }
+		};
+
+		struct AddOperation { template<typename T> static constexpr T Apply(T lhs, T rhs) { return static_cast<T>(lhs + rhs); } };
+		struct SubOperation { template<typename T> static constexpr T Apply(T lhs, T rhs) { return static_cast<T>(lhs - rhs); } };
+		struct MulOperation { template<typename T> static constexpr T Apply(T lhs, T rhs) { return static_cast<T>(lhs * rhs); } };
+		struct DivOperation { template<typename T> static constexpr T Apply(T lhs, T rhs) { return static_cast<T>(lhs / rhs); } };
+
+		//Nodes hold their sub-expressions by value, so a whole tree is a small aggregate of pointers and scalars
+		template<typename Operation, typename L, typename R, typename ResultType>
+		struct Expression
+		{
+			L lhs;
+			R rhs;
+
+			constexpr typename ExpressionTraits<ResultType>::Value Element(size_t index) const
+			{
+				return Operation::Apply(lhs.Element(index), rhs.Element(index));
+			}
+		};
+
+		template<typename Operation, typename L, typename R, typename ResultType>
+		struct ExpressionTraits<Expression<Operation, L, R, ResultType>>
+		{
+			static constexpr bool isOperand = true;
+			static constexpr bool isExpression = true;
+			using Value = typename ExpressionTraits<ResultType>::Value;
+			using Result = ResultType;
+		};
+
+		//Vectors and matrices enter a tree as terminals, expressions as copies of themselves
+		template<typename E>
+		struct ExpressionNode
+		{
+			using type = E;
+			static constexpr const E& Make(const E& expression) { return expression; }
+		};
+
+		template<typename T, size_t N>
+		struct ExpressionNode<VecTemplate<T, N>>
+		{
+			using type = ExpressionTerminal<T>;
+			static constexpr type Make(const VecTemplate<T, N>& vec) { return { vec.data }; }
+		};
+
+		template<typename T, size_t C, size_t R>
+		struct ExpressionNode<MatTemplate<T, C, R>>
+		{
+			using type = ExpressionTerminal<T>;
+			static constexpr type Make(const MatTemplate<T, C, R>& mat) { return { mat.data }; }
+		};
+
+		template<typename E> using ExpressionNode_t = typename ExpressionNode<E>::type;
+
+		template<typename Operation, typename L, typename R>
+		constexpr auto MakeExpression(const L& lhs, const R& rhs)
+		{
+			using ResultType = typename ExpressionTraits<L>::Result;
+			return Expression<Operation, ExpressionNode_t<L>, ExpressionNode_t<R>, ResultType>{ ExpressionNode<L>::Make(lhs), ExpressionNode<R>::Make(rhs) };
+		}
+
+		template<typename Operation, typename L>
+		constexpr auto MakeScalarExpression(const L& lhs, typename ExpressionTraits<L>::Value rhs)
+		{
+			using T = typename ExpressionTraits<L>::Value;
+			using ResultType = typename ExpressionTraits<L>::Result;
+			return Expression<Operation, ExpressionNode_t<L>, ExpressionScalar<T>, ResultType>{ ExpressionNode<L>::Make(lhs), { rhs } };
+		}
+
+		template<typename Operation, typename R>
+		constexpr auto MakeLeftScalarExpression(typename ExpressionTraits<R>::Value lhs, const R& rhs)
+		{
+			using T = typename ExpressionTraits<R>::Value;
+			using ResultType = typename ExpressionTraits<R>::Result;
+			return Expression<Operation, ExpressionScalar<T>, ExpressionNode_t<R>, ResultType>{ { lhs }, ExpressionNode<R>::Make(rhs) };
+		}
+
+		//Unrolled at compile time, the sizes are small and a loop would not be vectorized at -O2
+		template<size_t Index, size_t Count>
+		struct ExpressionUnroll
+		{
+			template<typename T, typename E>
+			static constexpr void Evaluate(T* values, const E& expression)
+			{
+				values[Index] = expression.Element(Index);
+				ExpressionUnroll<Index + 1, Count>::Evaluate(values, expression);
+			}
+
+			template<typename T>
+			static constexpr void Store(T* data, const T* values)
+			{
+				data[Index] = values[Index];
+				ExpressionUnroll<Index + 1, Count>::Store(data, values);
+			}
+		};
+
+		template<size_t Count>
+		struct ExpressionUnroll<Count, Count>
+		{
+			template<typename T, typename E> static constexpr void Evaluate(T*, const E&) {}
+			template<typename T> static constexpr void Store(T*, const T*) {}
+		};
+
+		constexpr size_t ExpressionUnrollLimit = 16;
+
+		//Small results compute every element before the first store, so the compiler does not have to reload
+		//the operands after each store in case data aliases one of them
+		template<size_t Count, typename T, typename E>
+		constexpr void EvaluateExpression(T* data, const E& expression)
+		{
+			if constexpr (Count <= ExpressionUnrollLimit)
+			{
+				T values[Count]{};
+				ExpressionUnroll<0, Count>::Evaluate(values, expression);
+				ExpressionUnroll<0, Count>::Store(data, values);
+			}
+			else
+			{
+				for (size_t i = 0; i < Count; ++i)
+					data[i] = expression.Element(i);
+			}
+		}
+	}
+
+	template<typename E>
+	inline typename Detail::ExpressionTraits<E>::Result Eval(const E& expression)
+	{
+		return expression;
+	}
+
+#if defined(DVM_EXPRESSION_TEMPLATES)
+	//Same operand shapes as the eager operators, scalars must have the element type
+	template<typename L, typename R, DVTL::Enable_if_t<Detail::ElementwiseOperands<L, R>::value, int> = 0>
+	constexpr auto operator+(const L& lhs, const R& rhs) { return Detail::MakeExpression<Detail::AddOperation>(lhs, rhs); }
+
+	template<typename L, typename R, DVTL::Enable_if_t<Detail::ElementwiseOperands<L, R>::value, int> = 0>
+	constexpr auto operator-(const L& lhs, const R& rhs) { return Detail::MakeExpression<Detail::SubOperation>(lhs, rhs); }
+
+	template<typename L, typename R, DVTL::Enable_if_t<Detail::ElementwiseOperands<L, R>::value, int> = 0>
+	constexpr auto operator*(const L& lhs, const R& rhs) { return Detail::MakeExpression<Detail::MulOperation>(lhs, rhs); }
+
+	template<typename L, typename R, DVTL::Enable_if_t<Detail::ElementwiseOperands<L, R>::value, int> = 0>
+	constexpr auto operator/(const L& lhs, const R& rhs) { return Detail::MakeExpression<Detail::DivOperation>(lhs, rhs); }
+
+	template<typename L, typename S, DVTL::Enable_if_t<Detail::ScalarOperands<L, S>::value, int> = 0>
+	constexpr auto operator+(const L& lhs, S rhs) { return Detail::MakeScalarExpression<Detail::AddOperation>(lhs, rhs); }
+
+	template<typename L, typename S, DVTL::Enable_if_t<Detail::ScalarOperands<L, S>::value, int> = 0>
+	constexpr auto operator-(const L& lhs, S rhs) { return Detail::MakeScalarExpression<Detail::SubOperation>(lhs, rhs); }
+
+	template<typename L, typename S, DVTL::Enable_if_t<Detail::ScalarOperands<L, S>::value, int> = 0>
+	constexpr auto operator*(const L& lhs, S rhs) { return Detail::MakeScalarExpression<Detail::MulOperation>(lhs, rhs); }
+
+	template<typename S, typename R, DVTL::Enable_if_t<Detail::ScalarOperands<R, S>::value, int> = 0>
+	constexpr auto operator*(S lhs, const R& rhs) { return Detail::MakeLeftScalarExpression<Detail::MulOperation>(lhs, rhs); }
+
+	template<typename L, typename S, DVTL::Enable_if_t<Detail::ScalarOperands<L, S>::value, int> = 0>
+	constexpr auto operator/(const L& lhs, S rhs) { return Detail::MakeScalarExpression<Detail::DivOperation>(lhs, rhs); }
+#endif
+}
+
+#endif // !DVM_EXPRESSION_H
@@ -0,0 +1,261 @@
+#ifndef DVM_HALF_H
+#define DVM_HALF_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Matrix.h"
+#include "SIMD.h"
+#include "Utility.h"
+#include "Vector.h"
+
+//16 bit storage types for VecTemplate and MatTemplate. Half is IEEE binary16 (10 bit mantissa, range 65504),
+//BFloat16 is the upper half of a float (7 bit mantissa, float range). Both convert implicitly to and from float
+//with round to nearest even, arithmetic on them runs in float and rounds once when stored back, so
+//Vec4h + Vec4h computes every lane in float. Scalar operands of Half vectors are written Half(x), a bare float
+//converts to both Half and the vector and is ambiguous. Bulk conversions use F16C and SSE2 where available
+namespace DVM
+{
+	namespace Detail
+	{
+		inline uint32_t FloatBits(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		inline float BitsFloat(uint32_t bits)
+		{
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		//Overflow goes to infinity, NaN stays a quiet NaN, results below the smallest normal half are rounded
+		//by a float addition that lines the mantissa up with the subnormal half bits
+		inline uint16_t FloatToHalfBits(float value)
+		{
+			uint32_t bits = FloatBits(value);
+			uint32_t sign = (bits >> 16) & 0x8000u;
+			bits &= 0x7FFF'FFFFu;
+
+			uint32_t result;
+			if (bits >= 0x4780'0000u)
+				result = bits > 0x7F80'0000u ? 0x7E00u : 0x7C00u;
+			else if (bits < 0x3880'0000u)
+				result = FloatBits(BitsFloat(bits) + 0.5f) - 0x3F00'0000u;
+			else
+			{
+				uint32_t odd = (bits >> 13) & 1u;
+				result = (bits + (uint32_t(15 - 127) << 23) + 0xFFFu + odd) >> 13;
+			}
+
+			return static_cast<uint16_t>(result | sign);
+		}
+
+		inline float HalfBitsToFloat(uint16_t half)
+		{
+			uint32_t bits = uint32_t(half & 0x7FFFu) << 13;
+			uint32_t exponent = bits & 0x0F80'0000u;
+			bits += uint32_t(127 - 15) << 23;
+
+			if (exponent == 0x0F80'0000u)
+				bits += uint32_t(128 - 16) << 23;
+			else if (exponent == 0)
+				bits = FloatBits(BitsFloat(bits + (1u << 23)) - BitsFloat(113u << 23));
+
+			return BitsFloat(bits | (uint32_t(half & 0x8000u) << 16));
+		}
+
+		//Rounding adds 0x7FFF plus the lowest kept bit, NaN is truncated with the quiet bit set so it stays NaN
+		inline uint16_t FloatToBFloat16Bits(float value)
+		{
+			uint32_t bits = FloatBits(value);
+			if ((bits & 0x7FFF'FFFFu) > 0x7F80'0000u)
+				return static_cast<uint16_t>((bits >> 16) | 0x40u);
+
+			return static_cast<uint16_t>((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+		}
+
+		inline float BFloat16BitsToFloat(uint16_t value) { return BitsFloat(uint32_t(value) << 16); }
+	}
+
+	struct Half
+	{
+		uint16_t bits;
+
+		Half() = default;
+		Half(float value) : bits(Detail::FloatToHalfBits(value)) {}
+
+		template<typename U, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<U>, int> = 0>
+		Half(U value) : Half(static_cast<float>(value)) {}
+
+		static constexpr Half FromBits(uint16_t bits) { Half result{}; result.bits = bits; return result; }
+
+		operator float() const { return Detail::HalfBitsToFloat(bits); }
+
+		//Sign flips are exact and keep Abs and the conditional operator on Half, not float
+		constexpr Half operator-() const { return FromBits(static_cast<uint16_t>(bits ^ 0x8000u)); }
+		constexpr Half operator+() const { return *this; }
+
+		Half& operator+=(float value) { return *this = float(*this) + value; }
+		Half& operator-=(float value) { return *this = float(*this) - value; }
+		Half& operator*=(float value) { return *this = float(*this) * value; }
+		Half& operator/=(float value) { return *this = float(*this) / value; }
+
+		Half& operator++() { return *this += 1.f; }
+		Half& operator--() { return *this -= 1.f; }
+		Half operator++(int) { Half old = *this; ++*this; return old; }
+		Half operator--(int) { Half old = *this; --*this; return old; }
+	};
+
+	struct BFloat16
+	{
+		uint16_t bits;
+
+		BFloat16() = default;
+		BFloat16(float value) : bits(Detail::FloatToBFloat16Bits(value)) {}
+
+		template<typename U, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<U>, int> = 0>
+		BFloat16(U value) : BFloat16(static_cast<float>(value)) {}
+
+		static constexpr BFloat16 FromBits(uint16_t bits) { BFloat16 result{}; result.bits = bits; return result; }
+
+		operator float() const { return Detail::BFloat16BitsToFloat(bits); }
+
+		constexpr BFloat16 operator-() const { return FromBits(static_cast<uint16_t>(bits ^ 0x8000u)); }
+		constexpr BFloat16 operator+() const { return *this; }
+
+		BFloat16& operator+=(float value) { return *this = float(*this) + value; }
+		BFloat16& operator-=(float value) { return *this = float(*this) - value; }
+		BFloat16& operator*=(float value) { return *this = float(*this) * value; }
+		BFloat16& operator/=(float value) { return *this = float(*this) / value; }
+
+		BFloat16& operator++() { return *this += 1.f; }
+		BFloat16& operator--() { return *this -= 1.f; }
+		BFloat16 operator++(int) { BFloat16 old = *this; ++*this; return old; }
+		BFloat16 operator--(int) { BFloat16 old = *this; --*this; return old; }
+	};
+
+	static_assert(sizeof(Half) == 2 && DVTL::Is_trivially_copyable_v<Half>, "Half must be a trivially copyable 16 bit type");
+	static_assert(sizeof(BFloat16) == 2 && DVTL::Is_trivially_copyable_v<BFloat16>, "BFloat16 must be a trivially copyable 16 bit type");
+
+	template<> constexpr Half getEpsilon<Half>() { return Half::FromBits(0x1400); }
+	template<> constexpr BFloat16 getEpsilon<BFloat16>() { return BFloat16::FromBits(0x3C00); }
+
+	inline void ToHalfBatch(const float* in, Half* out, size_t count)
+	{
+		size_t i = 0;
+		uint16_t* bits = reinterpret_cast<uint16_t*>(out);
+
+#if defined(DVM_SIMD_F16C)
+		for (; i + 8 <= count; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(bits + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+		for (; i < count; ++i)
+			bits[i] = Detail::FloatToHalfBits(in[i]);
+	}
+
+	inline void ToFloatBatch(const Half* in, float* out, size_t count)
+	{
+		size_t i = 0;
+		const uint16_t* bits = reinterpret_cast<const uint16_t*>(in);
+
+#if defined(DVM_SIMD_F16C)
+		for (; i + 8 <= count; i += 8)
+			_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + i))));
+#endif
+		for (; i < count; ++i)
+			out[i] = Detail::HalfBitsToFloat(bits[i]);
+	}
+
+	inline void ToBFloat16Batch(const float* in, BFloat16* out, size_t count)
+	{
+		size_t i = 0;
+		uint16_t* bits = reinterpret_cast<uint16_t*>(out);
+
+#if defined(DVM_SIMD_SSE2)
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i bias = _mm_set1_epi32(0x7FFF);
+		const __m128i quiet = _mm_set1_epi32(0x40);
+
+		//Two registers of rounded upper halves, sign extended so the signed pack keeps all 16 bits
+		auto Round = [&](__m128 value)
+		{
+			__m128i raw = _mm_castps_si128(value);
+			__m128i rounded = _mm_add_epi32(_mm_add_epi32(raw, bias), _mm_and_si128(_mm_srli_epi32(raw, 16), one));
+			__m128i nan = _mm_castps_si128(_mm_cmpunord_ps(value, value));
+			__m128i upper = _mm_or_si128(_mm_and_si128(nan, _mm_or_si128(raw, _mm_slli_epi32(quiet, 16))), _mm_andnot_si128(nan, rounded));
+			return _mm_srai_epi32(upper, 16);
+		};
+
+		for (; i + 8 <= count; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(bits + i), _mm_packs_epi32(Round(_mm_loadu_ps(in + i)), Round(_mm_loadu_ps(in + i + 4))));
+#endif
+		for (; i < count; ++i)
+			bits[i] = Detail::FloatToBFloat16Bits(in[i]);
+	}
+
+	inline void ToFloatBatch(const BFloat16* in, float* out, size_t count)
+	{
+		size_t i = 0;
+		const uint16_t* bits = reinterpret_cast<const uint16_t*>(in);
+
+#if defined(DVM_SIMD_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + i));
+			_mm_storeu_ps(out + i, _mm_castsi128_ps(_mm_unpacklo_epi16(zero, value)));
+			_mm_storeu_ps(out + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, value)));
+		}
+#endif
+		for (; i < count; ++i)
+			out[i] = Detail::BFloat16BitsToFloat(bits[i]);
+	}
+
+	//Arrays of vectors and matrices, the elements are unpadded so they convert as one flat array
+	template<size_t N>
+	inline void ToHalfBatch(const VecTemplate<float, N>* in, VecTemplate<Half, N>* out, size_t count) { ToHalfBatch(in->data, out->data, N * count); }
+
+	template<size_t N>
+	inline void ToFloatBatch(const VecTemplate<Half, N>* in, VecTemplate<float, N>* out, size_t count) { ToFloatBatch(in->data, out->data, N * count); }
+
+	template<size_t N>
+	inline void ToBFloat16Batch(const VecTemplate<float, N>* in, VecTemplate<BFloat16, N>* out, size_t count) { ToBFloat16Batch(in->data, out->data, N * count); }
+
+	template<size_t N>
+	inline void ToFloatBatch(const VecTemplate<BFloat16, N>* in, VecTemplate<float, N>* out, size_t count) { ToFloatBatch(in->data, out->data, N * count); }
+
+	template<size_t C, size_t R>
+	inline void ToHalfBatch(const MatTemplate<float, C, R>* in, MatTemplate<Half, C, R>* out, size_t count) { ToHalfBatch(in->data, out->data, C * R * count); }
+
+	template<size_t C, size_t R>
+	inline void ToFloatBatch(const MatTemplate<Half, C, R>* in, MatTemplate<float, C, R>* out, size_t count) { ToFloatBatch(in->data, out->data, C * R * count); }
+
+	template<size_t C, size_t R>
+	inline void ToBFloat16Batch(const MatTemplate<float, C, R>* in, MatTemplate<BFloat16, C, R>* out, size_t count) { ToBFloat16Batch(in->data, out->data, C * R * count); }
+
+	template<size_t C, size_t R>
+	inline void ToFloatBatch(const MatTemplate<BFloat16, C, R>* in, MatTemplate<float, C, R>* out, size_t count) { ToFloatBatch(in->data, out->data, C * R * count); }
+
+	using Vec2h		= VecTemplate<Half, 2>;
+	using Vec3h		= VecTemplate<Half, 3>;
+	using Vec4h		= VecTemplate<Half, 4>;
+	using Vec2bf	= VecTemplate<BFloat16, 2>;
+	using Vec3bf	= VecTemplate<BFloat16, 3>;
+	using Vec4bf	= VecTemplate<BFloat16, 4>;
+
+	using Mat2h		= MatTemplate<Half, 2, 2>;
+	using Mat3h		= MatTemplate<Half, 3, 3>;
+	using Mat4h		= MatTemplate<Half, 4, 4>;
+	using Mat2bf	= MatTemplate<BFloat16, 2, 2>;
+	using Mat3bf	= MatTemplate<BFloat16, 3, 3>;
+	using Mat4bf	= MatTemplate<BFloat16, 4, 4>;
+
+	static_assert(sizeof(Vec4h) == 8 && sizeof(Mat4h) == 32, "Half vectors and matrices must not be padded");
+}
+
+#endif // !DVM_HALF_H
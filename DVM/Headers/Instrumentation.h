@@ -0,0 +1,243 @@
+#ifndef DVM_INSTRUMENTATION_H
+#define DVM_INSTRUMENTATION_H
+
+//Opt-in call, iteration and cycle counters for the iterative functions of DVM. Define DVM_INSTRUMENTATION
+//before including any DVM header to enable them, without it both macros expand to their bare operand:
+//
+//DVM_INSTRUMENT_CALL(expression)		evaluates expression and counts one call and its cycles against the
+//										enclosing function, one record per template instantiation
+//DVM_INSTRUMENT_ITERATIONS(count)		adds count loop iterations to the innermost call being measured
+//
+//Nothing is recorded during constant evaluation, the constexpr functions stay constexpr. Cycles include
+//nested instrumented calls. DVM::Instrumentation::Report(stream) prints the aggregated records.
+
+#if defined(DVM_INSTRUMENTATION)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#define DVM_FUNCTION_SIGNATURE __FUNCSIG__
+#else
+	#define DVM_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+#endif
+
+//The lambda type is unique per call site and template instantiation, Measure keeps one record per lambda type
+#define DVM_INSTRUMENT_CALL(expression) ::DVM::Instrumentation::Detail::Call(DVM_FUNCTION_SIGNATURE, [&]() { return (expression); })
+#define DVM_INSTRUMENT_ITERATIONS(count) ::DVM::Instrumentation::Detail::CountIterations(static_cast<uint64_t>(count))
+
+namespace DVM
+{
+	namespace Instrumentation
+	{
+		//Counters of one instrumented function, updated with relaxed atomics from any thread
+		struct Record
+		{
+			const char* function;
+			std::atomic<uint64_t> calls{ 0 };
+			std::atomic<uint64_t> iterations{ 0 };
+			std::atomic<uint64_t> cycles{ 0 };
+			Record* next = nullptr;
+		};
+
+		//Copy of a Record at the time of Snapshot
+		struct Entry
+		{
+			const char* function;
+			uint64_t calls;
+			uint64_t iterations;
+			uint64_t cycles;
+		};
+
+		namespace Detail
+		{
+			struct Registry
+			{
+				std::mutex mutex;
+				Record* first = nullptr;
+			};
+
+			inline Registry& GetRegistry()
+			{
+				static Registry registry;
+				return registry;
+			}
+
+			//Record of the innermost call being measured on this thread
+			inline Record*& Current()
+			{
+				thread_local Record* current = nullptr;
+				return current;
+			}
+
+			//Time stamp counter on x86, nanoseconds elsewhere
+			inline uint64_t ReadCycles()
+			{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+				return __rdtsc();
+#else
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+			}
+
+			inline bool Register(Record& record)
+			{
+				Registry& registry = GetRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+
+				record.next = registry.first;
+				registry.first = &record;
+				return true;
+			}
+
+			//Makes record the current one for its lifetime and counts one call with the cycles it lasted
+			struct Scope
+			{
+				Record& record;
+				Record* previous;
+				uint64_t start;
+
+				explicit Scope(Record& measured) : record(measured), previous(Current()), start(0)
+				{
+					Current() = &record;
+					start = ReadCycles();
+				}
+
+				~Scope()
+				{
+					uint64_t cycles = ReadCycles() - start;
+
+					Current() = previous;
+					record.calls.fetch_add(1, std::memory_order_relaxed);
+					record.cycles.fetch_add(cycles, std::memory_order_relaxed);
+				}
+
+				Scope(const Scope&) = delete;
+				Scope& operator=(const Scope&) = delete;
+			};
+
+			template<typename F>
+			inline auto Measure(const char* function, F evaluate) -> decltype(evaluate())
+			{
+				static Record record{ function };
+				static const bool registered = Register(record);
+				(void)registered;
+
+				//The scope also covers functions returning void
+				Scope scope(record);
+				return evaluate();
+			}
+
+			inline void AddIterations(uint64_t count)
+			{
+				if (Record* record = Current())
+					record->iterations.fetch_add(count, std::memory_order_relaxed);
+			}
+
+			template<typename F>
+			constexpr auto Call(const char* function, F evaluate) -> decltype(evaluate())
+			{
+				if (DVM_IS_CONSTANT_EVALUATED())
+					return evaluate();
+
+				return Measure(function, evaluate);
+			}
+
+			constexpr void CountIterations(uint64_t count)
+			{
+				if (!DVM_IS_CONSTANT_EVALUATED())
+					AddIterations(count);
+			}
+		}
+
+		//Every function called at least once, most cycles first
+		inline std::vector<Entry> Snapshot()
+		{
+			std::vector<Entry> entries;
+			Detail::Registry& registry = Detail::GetRegistry();
+
+			{
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				for (Record* record = registry.first; record; record = record->next)
+				{
+					Entry entry{ record->function, record->calls.load(std::memory_order_relaxed),
+						record->iterations.load(std::memory_order_relaxed), record->cycles.load(std::memory_order_relaxed) };
+
+					//Several call sites in one function share its entry
+					auto same = std::find_if(entries.begin(), entries.end(), [&](const Entry& other) { return !std::strcmp(other.function, entry.function); });
+					if (same == entries.end())
+						entries.push_back(entry);
+					else
+					{
+						same->calls += entry.calls;
+						same->iterations += entry.iterations;
+						same->cycles += entry.cycles;
+					}
+				}
+			}
+
+			entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry& entry) { return entry.calls == 0; }), entries.end());
+			std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.cycles > b.cycles; });
+			return entries;
+		}
+
+		//Calls, iterations and cycles in total and per call. Safe to call while other threads are counting
+		inline void Report(std::ostream& stream)
+		{
+			std::vector<Entry> entries = Snapshot();
+			std::streamsize precision = stream.precision();
+
+			stream << std::setw(12) << "calls" << std::setw(14) << "iterations" << std::setw(10) << "iter/call"
+				<< std::setw(16) << "cycles" << std::setw(12) << "cycles/call" << "  function\n";
+
+			for (const Entry& entry : entries)
+			{
+				double calls = static_cast<double>(entry.calls);
+				stream << std::setw(12) << entry.calls << std::setw(14) << entry.iterations
+					<< std::setw(10) << std::fixed << std::setprecision(2) << entry.iterations / calls
+					<< std::setw(16) << entry.cycles << std::setw(12) << std::setprecision(1) << entry.cycles / calls
+					<< "  " << entry.function << '\n';
+			}
+
+			stream.unsetf(std::ios_base::floatfield);
+			stream.precision(precision);
+		}
+
+		//Zeroes every counter, records stay registered
+		inline void Reset()
+		{
+			Detail::Registry& registry = Detail::GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			for (Record* record = registry.first; record; record = record->next)
+			{
+				record->calls.store(0, std::memory_order_relaxed);
+				record->iterations.store(0, std::memory_order_relaxed);
+				record->cycles.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+#else
+
+#define DVM_INSTRUMENT_CALL(expression) (expression)
+#define DVM_INSTRUMENT_ITERATIONS(count) ((void)0)
+
+#endif
+
+#endif // !DVM_INSTRUMENTATION_H
@@ -1,7 +1,22 @@
 #ifndef DVM_MATH_H
 #define DVM_MATH_H
 
+#include<cmath>
 #include<iostream>
+#include<limits>
+
+#include "SIMD.h"
+#include "Utility.h"
+
+//True while the enclosing constexpr function is being evaluated by the compiler
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+    #define DVM_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+    #define DVM_IS_CONSTANT_EVALUATED() false
+#endif
+
+//After DVM_IS_CONSTANT_EVALUATED, the instrumentation macros expand to it
+#include "Instrumentation.h"
 
 namespace DVM 
 {
@@ -18,25 +33,169 @@ namespace DVM
     template<>              constexpr double        getE<double>() { return 2.7182'8182'8459'045; }
     template<>              constexpr long double   getE<long double>() { return 2.7182'8182'8459'045L; }
 
+    template<typename T>    constexpr T             getPi() { return template_cast<T>(3); }
+    template<>              constexpr float         getPi<float>() { return 3.1415'9265f; }
+    template<>              constexpr double        getPi<double>() { return 3.1415'9265'3589'7932; }
+    template<>              constexpr long double   getPi<long double>() { return 3.1415'9265'3589'7932'3846L; }
+
     template<typename T>    struct floatingPoint                {using type = float;};
     template<>              struct floatingPoint<double>        { using type = double; };
     template<>              struct floatingPoint<long double>   { using type = long double; };
 
     template<typename T> using floatingPoint_t = typename floatingPoint<T>::type;
 
-    template <typename T>
-    constexpr T Sqrt(T value) {
-        if (value < template_cast<T>(0)) return template_cast<T>(0);
-        if (value < template_cast<T>(1)) return template_cast<T>(1) / Sqrt(template_cast<T>(1) / value);
+    namespace Detail
+    {
+        //2^exponent by repeated squaring, usable in constant expressions
+        template<typename T>
+        constexpr T Pow2(int exponent)
+        {
+            T base = exponent < 0 ? template_cast<T>(0.5L) : template_cast<T>(2);
+            unsigned int power = static_cast<unsigned int>(exponent < 0 ? -exponent : exponent);
+            T result = template_cast<T>(1);
+
+            while (true)
+            {
+                if (power & 1u)
+                    result *= base;
+
+                power >>= 1;
+                if (!power) break;
+
+                base *= base;
+            }
+
+            return result;
+        }
+
+        //Splits a finite value > 0 into mantissa * 2^exponent, mantissa in [1, 2).
+        //Binary search over the exponent, so the cost is bounded by the exponent width of T
+        template<typename T>
+        constexpr T SplitExponent(T value, int& exponent)
+        {
+            //powers[i] = 2^(2^i) for every power that fits into T
+            constexpr int steps = [] { int count = 0; while ((1 << count) < std::numeric_limits<T>::max_exponent) ++count; return count; }();
+            T powers[steps] = {};
+            powers[0] = template_cast<T>(2);
+            for (int i = 1; i < steps; ++i)
+                powers[i] = powers[i - 1] * powers[i - 1];
+
+            exponent = 0;
+            if (value < std::numeric_limits<T>::min())
+            {
+                value *= Pow2<T>(std::numeric_limits<T>::digits);
+                exponent -= std::numeric_limits<T>::digits;
+            }
 
-        T result = value;
-        T epsilon = getEpsilon<T>()*value;
-        floatingPoint_t<T> half = template_cast<floatingPoint_t<T>>(0.5L);
+            for (int i = steps - 1; i >= 0; --i)
+            {
+                if (value >= powers[i])
+                {
+                    value /= powers[i];
+                    exponent += 1 << i;
+                }
+                else if (value * powers[i] < template_cast<T>(1))
+                {
+                    value *= powers[i];
+                    exponent -= 1 << i;
+                }
+            }
 
-        for (int i = 0; i<520 && (result * result - value) > epsilon; ++i)
-            result = static_cast<T>(half * static_cast<floatingPoint_t<T>>((result + value / result)));
+            if (value < template_cast<T>(1))
+            {
+                value *= template_cast<T>(2);
+                --exponent;
+            }
+
+            return value;
+        }
 
-        return result;
+        //Newton's method with a fixed iteration count, from a linear seed on the reduced range
+        template<typename T>
+        constexpr T SqrtNewton(T value)
+        {
+            if (value == template_cast<T>(0) || !(value < std::numeric_limits<T>::infinity())) return value;
+
+            int exponent = 0;
+            T mantissa = SplitExponent(value, exponent);
+            if (exponent % 2)
+            {
+                mantissa *= template_cast<T>(2);
+                --exponent;
+            }
+
+            //mantissa in [1, 4), minimax line seed accurate to ~4%
+            T result = template_cast<T>(17) / template_cast<T>(24) + mantissa / template_cast<T>(3);
+            constexpr int iterations = std::numeric_limits<T>::digits > 24 ? 4 : 3;
+            DVM_INSTRUMENT_ITERATIONS(iterations);
+
+            for (int i = 0; i < iterations; ++i)
+                result = template_cast<T>(0.5L) * (result + mantissa / result);
+
+            return result * Pow2<T>(exponent / 2);
+        }
+
+        inline float SqrtRuntime(float value)
+        {
+#if defined(DVM_SIMD_SSE2)
+            return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value)));
+#else
+            if (value == 0.f || !(value < std::numeric_limits<float>::infinity())) return value;
+
+            //The exponent bits of a subnormal say nothing about its magnitude, scale it into the normal range first
+            if (value < std::numeric_limits<float>::min())
+                return SqrtRuntime(value * 16777216.f) * (1.f / 4096.f);
+
+            //Halving the biased exponent bits gives a seed within ~6%
+            union { float floatValue; int intValue; } converter{ value };
+            converter.intValue = (converter.intValue >> 1) + 0x1FC00000;
+
+            float result = converter.floatValue;
+            DVM_INSTRUMENT_ITERATIONS(3);
+            for (int i = 0; i < 3; ++i)
+                result = 0.5f * (result + value / result);
+
+            return result;
+#endif
+        }
+
+        inline double SqrtRuntime(double value)
+        {
+#if defined(DVM_SIMD_SSE2)
+            __m128d vec = _mm_set_sd(value);
+            return _mm_cvtsd_f64(_mm_sqrt_sd(vec, vec));
+#else
+            if (value == 0. || !(value < std::numeric_limits<double>::infinity())) return value;
+
+            if (value < std::numeric_limits<double>::min())
+                return SqrtRuntime(value * 18014398509481984.) * (1. / 134217728.);
+
+            union { double doubleValue; long long intValue; } converter{ value };
+            converter.intValue = (converter.intValue >> 1) + 0x1FF8000000000000LL;
+
+            double result = converter.doubleValue;
+            DVM_INSTRUMENT_ITERATIONS(4);
+            for (int i = 0; i < 4; ++i)
+                result = 0.5 * (result + value / result);
+
+            return result;
+#endif
+        }
+
+        inline long double SqrtRuntime(long double value) { return SqrtNewton(value); }
+    }
+
+    template <typename T>
+    constexpr T Sqrt(T value)
+    {
+        if (value < template_cast<T>(0)) return template_cast<T>(0);
+
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Sqrt(template_cast<floatingPoint_t<T>>(value)));
+        else if (DVM_IS_CONSTANT_EVALUATED())
+            return Detail::SqrtNewton(value);
+        else
+            return DVM_INSTRUMENT_CALL(Detail::SqrtRuntime(value));
     }
 
     template<typename T>
@@ -73,38 +232,70 @@ namespace DVM
         return converter.uintValue;
     }
 
-    template<typename T> constexpr T Ceil(T val) { return val; }
-    template<> constexpr float         Ceil(float val)         { return static_cast<float>(static_cast<long long int>(val + 1)); }
-    template<> constexpr double        Ceil(double val)        { return static_cast<double>(static_cast<long long int>(val + 1)); }
-    template<> constexpr long double   Ceil(long double val)   { return static_cast<long double>(static_cast<long long int>(val + 1)); }
+    namespace Detail
+    {
+        //2^(digits - 1), every floating point value of at least this magnitude is an integer
+        template<typename T>
+        constexpr T IntegralThreshold() { return Pow2<T>(std::numeric_limits<T>::digits - 1); }
+
+        //Same arithmetic as SIMD::RoundBySum with selects instead of sign bits, for constant evaluation and
+        //types without lanes. Nearest integer, ties to even
+        template<typename T>
+        constexpr T RoundSelect(T x)
+        {
+            T threshold = IntegralThreshold<T>();
+            T magic = x < template_cast<T>(0) ? -threshold : threshold;
+            T rounded = (x + magic) - magic;
+            rounded = rounded == template_cast<T>(0) ? x * template_cast<T>(0) : rounded;
+            return Abs(x) < threshold ? rounded : x;
+        }
 
-    template<typename T> constexpr T Floor(T val) { return val; }
-    template<> constexpr float         Floor(float val)        { return static_cast<float>(static_cast<long long int>(val)); }
-    template<> constexpr double        Floor(double val)       { return static_cast<double>(static_cast<long long int>(val)); }
-    template<> constexpr long double   Floor(long double val)  { return static_cast<long double>(static_cast<long long int>(val)); }
+        template<typename T>
+        constexpr T FloorSelect(T x)
+        {
+            T rounded = RoundSelect(x);
+            return rounded - (rounded > x ? template_cast<T>(1) : template_cast<T>(0));
+        }
 
-    template<typename T> constexpr T Round(T val) { return val; }
+        template<typename T>
+        constexpr T CeilSelect(T x)
+        {
+            T rounded = RoundSelect(x);
+            T result = rounded + (rounded < x ? template_cast<T>(1) : template_cast<T>(0));
+            return result == template_cast<T>(0) ? x * template_cast<T>(0) : result;
+        }
 
-    template<>
-    constexpr float Round(float val) {
-        float res = Floor(val);
-        if (val - res > 0.5f) return Ceil(val);
-        else return res;
+#if defined(DVM_SIMD_SSE2)
+        //One lane of the SIMD rounding, roundss/roundsd with SSE4.1
+        inline float RoundRuntime(float x) { return _mm_cvtss_f32(SIMD::Round(SIMD::Float4{ _mm_set_ss(x) }).v); }
+        inline float FloorRuntime(float x) { return _mm_cvtss_f32(SIMD::Floor(SIMD::Float4{ _mm_set_ss(x) }).v); }
+        inline float CeilRuntime(float x) { return _mm_cvtss_f32(SIMD::Ceil(SIMD::Float4{ _mm_set_ss(x) }).v); }
+        inline double RoundRuntime(double x) { return _mm_cvtsd_f64(SIMD::Round(SIMD::Double2{ _mm_set_sd(x) }).v); }
+        inline double FloorRuntime(double x) { return _mm_cvtsd_f64(SIMD::Floor(SIMD::Double2{ _mm_set_sd(x) }).v); }
+        inline double CeilRuntime(double x) { return _mm_cvtsd_f64(SIMD::Ceil(SIMD::Double2{ _mm_set_sd(x) }).v); }
+#else
+        template<typename T> inline T RoundRuntime(T x) { return RoundSelect(x); }
+        template<typename T> inline T FloorRuntime(T x) { return FloorSelect(x); }
+        template<typename T> inline T CeilRuntime(T x) { return CeilSelect(x); }
+#endif
     }
 
-    template<>
-    constexpr double Round(double val) {
-        double res = Floor(val);
-        if (val - res > 0.5) return Ceil(val);
-        else return res;
-    }
+    //Branch free for float and double, exact over the whole range. Integral types are returned unchanged
+    template<typename T> constexpr T Ceil(T val) { return val; }
+    template<> constexpr float         Ceil(float val)         { return DVM_IS_CONSTANT_EVALUATED() ? Detail::CeilSelect(val) : Detail::CeilRuntime(val); }
+    template<> constexpr double        Ceil(double val)        { return DVM_IS_CONSTANT_EVALUATED() ? Detail::CeilSelect(val) : Detail::CeilRuntime(val); }
+    template<> constexpr long double   Ceil(long double val)   { return Detail::CeilSelect(val); }
 
-    template<>
-    constexpr long double Round(long double val) {
-        long double res = Floor(val);
-        if (val - res > 0.5L) return Ceil(val);
-        else return res;
-    }
+    template<typename T> constexpr T Floor(T val) { return val; }
+    template<> constexpr float         Floor(float val)        { return DVM_IS_CONSTANT_EVALUATED() ? Detail::FloorSelect(val) : Detail::FloorRuntime(val); }
+    template<> constexpr double        Floor(double val)       { return DVM_IS_CONSTANT_EVALUATED() ? Detail::FloorSelect(val) : Detail::FloorRuntime(val); }
+    template<> constexpr long double   Floor(long double val)  { return Detail::FloorSelect(val); }
+
+    //Halfway cases round to the even integer
+    template<typename T> constexpr T Round(T val) { return val; }
+    template<> constexpr float         Round(float val)        { return DVM_IS_CONSTANT_EVALUATED() ? Detail::RoundSelect(val) : Detail::RoundRuntime(val); }
+    template<> constexpr double        Round(double val)       { return DVM_IS_CONSTANT_EVALUATED() ? Detail::RoundSelect(val) : Detail::RoundRuntime(val); }
+    template<> constexpr long double   Round(long double val)  { return Detail::RoundSelect(val); }
 
     template<typename T>
     constexpr T Fma(const T& a, const T& b, const T& c) { return a + b + c; }
@@ -135,10 +326,10 @@ namespace DVM
     }
 
     template<typename T>
-    constexpr bool Isinf(T val) { return val == INFINITY || val == -INFINITY; }
+    constexpr bool Isinf(T val) { return val == std::numeric_limits<T>::infinity() || val == -std::numeric_limits<T>::infinity(); }
 
     template<typename T>
-    constexpr bool Isnan(T val) { return val == NAN; }
+    constexpr bool Isnan(T val) { return val != val; }
 
     template<typename T1, typename T2>
     constexpr T1 Mix(T1 x, T1 y, T2 a)
@@ -172,42 +363,362 @@ namespace DVM
 
     template<typename T> constexpr T Sign(T val) { return val > template_cast<floatingPoint_t<T>>(0) ? template_cast<floatingPoint_t<T>>(1) : template_cast<floatingPoint_t<T>>(-1); }
 
-    template<typename T>
-    constexpr T Exp(T x)
+    namespace Detail
     {
-        T result = 1;
-        T term = 1;
+        //ln(2) split so that k * hi is exact for every exponent k of T (Cody-Waite reduction)
+        template<typename T> struct Ln2 {};
+        template<> struct Ln2<float>        { static constexpr float hi = 0.693359375f;                 static constexpr float lo = -2.12194440e-4f; };
+        template<> struct Ln2<double>       { static constexpr double hi = 6.93147180369123816490e-01;  static constexpr double lo = 1.90821492927058770002e-10; };
+        template<> struct Ln2<long double>  { static constexpr long double hi = 0.693145751953125L;     static constexpr long double lo = 1.428606820309417232121458176568e-6L; };
+
+        template<typename T> constexpr T Ln2Value() { return Ln2<T>::hi + Ln2<T>::lo; }
+        template<typename T> constexpr T Log2E() { return template_cast<T>(1.442695040888963407359924681001892137L); }
+
+        //e^r for |r| <= ln(2) / 2
+        constexpr float ExpPolynomial(float r)
+        {
+            //Cephes expf minimax coefficients
+            float p = 1.9875691500e-4f;
+            p = p * r + 1.3981999507e-3f;
+            p = p * r + 8.3334519073e-3f;
+            p = p * r + 4.1665795894e-2f;
+            p = p * r + 1.6666665459e-1f;
+            p = p * r + 5.0000001201e-1f;
+            return p * r * r + r + 1.f;
+        }
+
+        constexpr double ExpPolynomial(double r)
+        {
+            //fdlibm minimax rational form: e^r = 1 + r + r * c / (2 - c)
+            double t = r * r;
+            double c = r - t * (1.66666666666666019037e-01 + t * (-2.77777777770155933842e-03 + t * (6.61375632143793436117e-05
+                + t * (-1.65339022054652515390e-06 + t * 4.13813679705723846039e-08))));
+            return 1. + (r + r * c / (2. - c));
+        }
+
+        constexpr long double ExpPolynomial(long double r)
+        {
+            //Degree 17 Taylor polynomial, the truncation error is below the long double epsilon on this range
+            long double p = 1.L;
+            DVM_INSTRUMENT_ITERATIONS(17);
+            for (int n = 17; n > 0; --n)
+                p = 1.L + p * r / n;
+            return p;
+        }
+
+        //ln(m) = f - (f^2 / 2 - s * (f^2 / 2 + R(s^2))) with f = m - 1, s = f / (2 + f), for m in [sqrt(1/2), sqrt(2))
+        constexpr float LogPolynomial(float z)
+        {
+            //fdlibm logf coefficients
+            return z * (0.66666662693f + z * (0.40000972152f + z * (0.28498786688f + z * 0.24279078841f)));
+        }
+
+        constexpr double LogPolynomial(double z)
+        {
+            //fdlibm log coefficients
+            return z * (6.666666666666735130e-01 + z * (3.999999999940941908e-01 + z * (2.857142874366239149e-01 + z * (2.222219843214978396e-01
+                + z * (1.818357216161805012e-01 + z * (1.531383769920937332e-01 + z * 1.479819860511658591e-01))))));
+        }
+
+        constexpr long double LogPolynomial(long double z)
+        {
+            //2 / (2k + 1) series coefficients truncated at a fixed degree, |s| <= 0.172
+            long double p = 0.L;
+            DVM_INSTRUMENT_ITERATIONS(14);
+            for (int k = 14; k > 0; --k)
+                p = z * (2.L / (2 * k + 1) + p);
+            return p;
+        }
+
+        inline double LongBitsToDouble(long long value)
+        {
+            union { long long intValue; double doubleValue; } converter{ value };
+            return converter.doubleValue;
+        }
+
+        inline long long DoubleBitsToLong(double value)
+        {
+            union { double doubleValue; long long intValue; } converter{ value };
+            return converter.intValue;
+        }
+
+        //value * 2^exponent
+        template<typename T>
+        constexpr T ScaleRuntime(T value, int exponent) { return value * Pow2<T>(exponent / 2) * Pow2<T>(exponent - exponent / 2); }
 
-        for (int n = 1; !Isinf(result); n++)
+        template<>
+        inline float ScaleRuntime(float value, int exponent)
         {
-            term *= x / n;
-            result += term;
+            if (exponent > 127) { value *= 1.70141183e+38f; exponent -= 127; }
+            if (exponent < -126) { value *= 1.17549435e-38f; exponent += 126; }
+            if (exponent < -126) { value *= 1.17549435e-38f; exponent += 126; }
+            exponent = Clamp(exponent, -126, 127);
+            return value * IntBitsToFloat((exponent + 127) << 23);
+        }
 
-            if (term == 0)
-                break;
+        template<>
+        inline double ScaleRuntime(double value, int exponent)
+        {
+            if (exponent > 1023) { value *= 0x1p1023; exponent -= 1023; }
+            if (exponent < -1022) { value *= 0x1p-1022; exponent += 1022; }
+            if (exponent < -1022) { value *= 0x1p-1022; exponent += 1022; }
+            exponent = Clamp(exponent, -1022, 1023);
+            return value * LongBitsToDouble(static_cast<long long>(exponent + 1023) << 52);
         }
 
-        return result;
+        template<typename T>
+        constexpr T Scale(T value, int exponent)
+        {
+            if (DVM_IS_CONSTANT_EVALUATED())
+                return value * Pow2<T>(exponent / 2) * Pow2<T>(exponent - exponent / 2);
+
+            return ScaleRuntime(value, exponent);
+        }
+
+        //Same contract as SplitExponent, reading the exponent field directly
+        template<typename T>
+        inline T SplitExponentRuntime(T value, int& exponent) { return SplitExponent(value, exponent); }
+
+        template<>
+        inline float SplitExponentRuntime(float value, int& exponent)
+        {
+            int offset = 0;
+            if (value < std::numeric_limits<float>::min())
+            {
+                value *= 8388608.f;
+                offset = 23;
+            }
+
+            int bits = FloatBitsToInt(value);
+            exponent = ((bits >> 23) & 0xFF) - 127 - offset;
+            return IntBitsToFloat((bits & 0x007FFFFF) | 0x3F800000);
+        }
+
+        template<>
+        inline double SplitExponentRuntime(double value, int& exponent)
+        {
+            int offset = 0;
+            if (value < std::numeric_limits<double>::min())
+            {
+                value *= 0x1p52;
+                offset = 52;
+            }
+
+            long long bits = DoubleBitsToLong(value);
+            exponent = static_cast<int>((bits >> 52) & 0x7FF) - 1023 - offset;
+            return LongBitsToDouble((bits & 0x000FFFFFFFFFFFFFLL) | 0x3FF0000000000000LL);
+        }
+
+        template<typename T>
+        constexpr T Split(T value, int& exponent)
+        {
+            if (DVM_IS_CONSTANT_EVALUATED())
+                return SplitExponent(value, exponent);
+
+            return SplitExponentRuntime(value, exponent);
+        }
+
+        //e^(x + xLo) for finite x, cost does not depend on the magnitude of x. xLo is a correction far below
+        //the last place of x, it joins the reduced argument
+        template<typename T>
+        constexpr T ExpReduced(T x, T xLo = template_cast<T>(0))
+        {
+            constexpr T overflow = template_cast<T>(std::numeric_limits<T>::max_exponent) * Ln2Value<T>();
+            constexpr T underflow = template_cast<T>(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1) * Ln2Value<T>();
+
+            if (x > overflow) return std::numeric_limits<T>::infinity();
+            if (x < underflow) return template_cast<T>(0);
+
+            T scaled = x * Log2E<T>();
+            int k = static_cast<int>(scaled + (scaled < template_cast<T>(0) ? template_cast<T>(-0.5L) : template_cast<T>(0.5L)));
+            T r = ((x - template_cast<T>(k) * Ln2<T>::hi) - template_cast<T>(k) * Ln2<T>::lo) + xLo;
+
+            return Scale(ExpPolynomial(r), k);
+        }
+
+        //x = 2^exponent * (1 + f) with 1 + f in [sqrt(1/2), sqrt(2)), f is exact
+        template<typename T>
+        constexpr T LogMantissa(T x, int& exponent)
+        {
+            T mantissa = Split(x, exponent);
+            if (mantissa > template_cast<T>(1.41421356237309504880L))
+            {
+                mantissa *= template_cast<T>(0.5L);
+                ++exponent;
+            }
+            return mantissa - template_cast<T>(1);
+        }
+
+        //ln(x) as exponent * ln(2) + ln(mantissa), split to keep the precision of the hi/lo constants
+        template<typename T>
+        constexpr T LogReduced(T x, int& exponent, T& f, T& correction)
+        {
+            f = LogMantissa(x, exponent);
+            T s = f / (template_cast<T>(2) + f);
+            T hfsq = template_cast<T>(0.5L) * f * f;
+            correction = hfsq - s * (hfsq + LogPolynomial(s * s));
+            return f - correction;
+        }
+
+        //a * b as product + error exactly. Fused where the hardware has it, where it does not the compiler cannot
+        //contract Dekker's split either
+        template<typename T>
+        constexpr T TwoProduct(T a, T b, T& error)
+        {
+            T product = a * b;
+#if defined(__FP_FAST_FMA) || defined(DVM_SIMD_FMA)
+            if constexpr (!DVTL::Is_same_v<T, long double>)
+                if (!DVM_IS_CONSTANT_EVALUATED())
+                {
+                    error = std::fma(a, b, -product);
+                    return product;
+                }
+#endif
+            constexpr T split = Pow2<T>((std::numeric_limits<T>::digits + 1) / 2) + template_cast<T>(1);
+            T aHi = split * a;
+            aHi = aHi - (aHi - a);
+            T bHi = split * b;
+            bHi = bHi - (bHi - b);
+            T aLo = a - aHi, bLo = b - bHi;
+            error = ((aHi * bHi - product) + aHi * bLo + aLo * bHi) + aLo * bLo;
+            return product;
+        }
+
+        //R(z) = sum of 2 z^k / (2k + 1) for LogExtended. The minimax polynomials above stop at an absolute error
+        //of 2^-58 for double, the series runs until its remainder is about 2^-(digits + 12) on |s| <= 0.172
+        template<typename T>
+        struct LogSeries
+        {
+            static constexpr int Terms = (std::numeric_limits<T>::digits + 12) / 5;
+
+            //2/3 in two parts, the first coefficient dominates R
+            T leading;
+            T leadingLo;
+            //2 / (2k + 1) for k = 2 .. Terms
+            T tail[Terms - 1];
+
+            constexpr LogSeries() : leading(template_cast<T>(2.L / 3.L)), leadingLo(0), tail{}
+            {
+                //2 - 3 * leading is exact in two parts
+                T error = 0;
+                T product = TwoProduct(template_cast<T>(3), leading, error);
+                leadingLo = ((template_cast<T>(2) - product) - error) / template_cast<T>(3);
+
+                for (int k = 2; k <= Terms; ++k)
+                    tail[k - 2] = template_cast<T>(2.L / (2 * k + 1));
+            }
+        };
+
+        template<typename T>
+        constexpr LogSeries<T> LogSeriesCoefficients{};
+
+        //ln(x) = result + lo for finite x > 0, about 2^-(digits + 10) relative error. Pow multiplies the logarithm
+        //by exponents up to 1/ulp, the error of a plain Log would be multiplied with it.
+        //Same reduction as LogReduced with ln(1 + f) = 2s + s * R(s^2) and s, R and their product in two parts
+        template<typename T>
+        constexpr T LogExtended(T x, T& lo)
+        {
+            int exponent = 0;
+            T f = LogMantissa(x, exponent);
+
+            T u = template_cast<T>(2) + f;
+            T uLo = f - (u - template_cast<T>(2));
+            T s = f / u;
+            T error = 0;
+            T product = TwoProduct(s, u, error);
+            T sLo = (((f - product) - error) - s * uLo) / u;
+
+            T zLo = 0;
+            T z = TwoProduct(s, s, zLo);
+            zLo += template_cast<T>(2) * s * sLo;
+
+            const LogSeries<T>& series = LogSeriesCoefficients<T>;
+            T tail = series.tail[LogSeries<T>::Terms - 2];
+            for (int i = LogSeries<T>::Terms - 3; i >= 0; --i)
+                tail = series.tail[i] + z * tail;
+            tail *= z;
+
+            T p = series.leading + tail;
+            T pLo = ((series.leading - p) + tail) + series.leadingLo;
+
+            T rLo = 0;
+            T r = TwoProduct(z, p, rLo);
+            rLo += z * pLo + zLo * p;
+
+            T srLo = 0;
+            T sr = TwoProduct(s, r, srLo);
+            srLo += s * rLo + sLo * r;
+
+            T twoS = template_cast<T>(2) * s;
+            T mantissa = twoS + sr;
+            T mantissaLo = ((twoS - mantissa) + sr) + (srLo + template_cast<T>(2) * sLo);
+
+            //k * hi is exact, k * lo is kept whole
+            T k = template_cast<T>(exponent);
+            T kLo = 0;
+            T kMid = TwoProduct(k, Ln2<T>::lo, kLo);
+            T kHi = k * Ln2<T>::hi;
+
+            T sum = kHi + mantissa;
+            lo = (((kHi - sum) + mantissa) + (mantissaLo + kLo)) + kMid;
+            T result = sum + lo;
+            lo = (sum - result) + lo;
+            return result;
+        }
+
+        //base^exp = e^(exp * ln(base)) with the logarithm and the product in two parts, for finite base > 0
+        template<typename T>
+        constexpr T PowPositive(T base, T exp)
+        {
+            T logLo = 0;
+            T logHi = LogExtended(base, logLo);
+            T productLo = 0;
+            T product = TwoProduct(exp, logHi, productLo);
+            return ExpReduced(product, productLo + exp * logLo);
+        }
+    }
+
+    template<typename T>
+    constexpr T Exp(T x)
+    {
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Exp(template_cast<floatingPoint_t<T>>(x)));
+        else
+        {
+            if (Isnan(x)) return x;
+            return DVM_INSTRUMENT_CALL(Detail::ExpReduced(x));
+        }
     }
 
+    //One shift for integral types, exponents outside [0, digits) give 0
     template<typename T>
     constexpr T Exp2(T x)
     {
-        if (x < 0)
+        if (x < 0 || x >= template_cast<T>(std::numeric_limits<T>::digits))
             return 0;
 
-        T result = 1;
-        for (T i = 0; i < x; ++i)
+        return template_cast<T>(1ull << x);
+    }
+
+    namespace Detail
+    {
+        template<typename T>
+        constexpr T Exp2Floating(T x)
         {
-            result *= 2;
-        }
+            if (Isnan(x)) return x;
+            if (x > template_cast<T>(std::numeric_limits<T>::max_exponent)) return std::numeric_limits<T>::infinity();
+            if (x < template_cast<T>(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1)) return template_cast<T>(0);
+
+            int k = static_cast<int>(x + (x < template_cast<T>(0) ? template_cast<T>(-0.5L) : template_cast<T>(0.5L)));
+            T r = (x - template_cast<T>(k)) * Ln2Value<T>();
 
-        return result;
+            return Scale(ExpPolynomial(r), k);
+        }
     }
 
-    template<>constexpr float          Exp2(float x)       { const float ln2 = 0.69314718f; return Exp(x * ln2);}
-    template<>constexpr double         Exp2(double x)      { const double ln2 = 0.693147180559945; return Exp(x * ln2);}
-    template<>constexpr long double    Exp2(long double x) { const  double ln2 = 0.693147180559945L; return Exp(x * ln2);}
+    template<>constexpr float          Exp2(float x)       { return DVM_INSTRUMENT_CALL(Detail::Exp2Floating(x)); }
+    template<>constexpr double         Exp2(double x)      { return DVM_INSTRUMENT_CALL(Detail::Exp2Floating(x)); }
+    template<>constexpr long double    Exp2(long double x) { return DVM_INSTRUMENT_CALL(Detail::Exp2Floating(x)); }
 
     template<typename T>
     constexpr T Inversesqrt(T x) { return template_cast<T>(1) / Sqrt(x); }
@@ -215,129 +726,343 @@ namespace DVM
     template<typename T>
     constexpr T Log(T x)
     {
-        constexpr T E = getE<T>();
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Log(template_cast<floatingPoint_t<T>>(x)));
+        else
+        {
+            if (Isnan(x)) return x;
+            if (x <= 0) return template_cast<T>(-1);
+            if (Isinf(x)) return x;
+
+            int exponent = 0;
+            T f = 0, correction = 0;
+            DVM_INSTRUMENT_CALL(Detail::LogReduced(x, exponent, f, correction));
 
-        if (x <= 0) return template_cast<T>(-1);
+            T k = template_cast<T>(exponent);
+            return k * Detail::Ln2<T>::hi - ((correction - k * Detail::Ln2<T>::lo) - f);
+        }
+    }
 
-        if (x < E)
+    template<typename T>
+    constexpr T Log2(T x) 
+    {
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Log2(template_cast<floatingPoint_t<T>>(x)));
+        else
         {
-            T res = template_cast<T>(0);
+            if (Isnan(x)) return x;
+            if (x <= 0) return template_cast<T>(-1);
+            if (Isinf(x)) return x;
 
-            while (x < E) {
-                x *= E;
-                res += template_cast<T>(1);
-            }
+            int exponent = 0;
+            T f = 0, correction = 0;
+            T logMantissa = DVM_INSTRUMENT_CALL(Detail::LogReduced(x, exponent, f, correction));
 
-            return Log(x) - res;
+            return template_cast<T>(exponent) + logMantissa * Detail::Log2E<T>();
         }
+    }
 
-        if (x > E * E)
+    namespace Detail
+    {
+        //Number of significant bits of value, 0 for 0
+        constexpr int BitWidth(unsigned long long value)
         {
-            T res = template_cast<T>(0);
+            int width = 0;
+            for (; value; value >>= 1)
+                ++width;
+            return width;
+        }
 
-            while (x > E * E) {
-                x /= E;
-                res += template_cast<T>(1);
+        //Exponentiation by squaring, one squaring per bit of power
+        template<typename T>
+        constexpr T PowSquaring(T base, unsigned long long power)
+        {
+            DVM_INSTRUMENT_ITERATIONS(BitWidth(power));
+
+            T result = template_cast<T>(1);
+            while (power)
+            {
+                if (power & 1ull)
+                    result *= base;
+
+                power >>= 1;
+                if (power)
+                    base *= base;
             }
+            return result;
+        }
+    }
+
+    //Integral exponents, floating point exponents take the overloads below
+    template<typename T, typename U, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<T>, int> = 0>
+    constexpr T Pow(T base, U exp) 
+    {
+        //Magnitude through unsigned so that the minimum of a signed U does not overflow
+        unsigned long long power = exp < 0 ? 0ull - static_cast<unsigned long long>(exp) : static_cast<unsigned long long>(exp);
+
+        if (exp < 0)
+            return template_cast<T>(1) / DVM_INSTRUMENT_CALL(Detail::PowSquaring(base, power));
+        return DVM_INSTRUMENT_CALL(Detail::PowSquaring(base, power));
+    }
+
+    //Exponent known at compile time, unrolled into the squaring chain, Pow<5>(x) is three multiplies
+    template<int Exponent, typename T, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<T>, int> = 0>
+    constexpr T Pow(T base)
+    {
+        if constexpr (Exponent < 0)
+            return template_cast<T>(1) / Pow<-Exponent>(base);
+        else if constexpr (Exponent == 0)
+            return template_cast<T>(1);
+        else if constexpr (Exponent == 1)
+            return base;
+        else
+        {
+            T half = Pow<Exponent / 2>(base);
+            if constexpr (Exponent % 2)
+                return half * half * base;
+            else
+                return half * half;
+        }
+    }
 
-            return Log(x) + res;
+    //Within 1 ULP for base > 0. 1^exp is 1 for every exp, negative bases keep the convention of Log
+    template<typename T, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<T>, int> = 0>
+    constexpr float Pow(T base, float exp)
+    {
+        float value = static_cast<float>(base);
+        if (exp == 0.f || value == 1.f) return 1.f;
+        if (value == 0.f) return 0.f;
+        if (!(value > 0.f) || Isinf(value) || Isnan(exp)) return Exp(exp * Log(value));
+        return DVM_INSTRUMENT_CALL(Detail::PowPositive(value, exp));
+    }
+
+    template<typename T, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<T>, int> = 0>
+    constexpr double Pow(T base, double exp)
+    {
+        double value = static_cast<double>(base);
+        if (exp == 0. || value == 1.) return 1.;
+        if (value == 0.) return 0.;
+        if (!(value > 0.) || Isinf(value) || Isnan(exp)) return Exp(exp * Log(value));
+        return DVM_INSTRUMENT_CALL(Detail::PowPositive(value, exp));
+    }
+
+    template<typename T, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<T>, int> = 0>
+    constexpr long double Pow(T base, long double exp)
+    {
+        long double value = static_cast<long double>(base);
+        if (exp == 0.L || value == 1.L) return 1.L;
+        if (value == 0.L) return 0.L;
+        if (!(value > 0.L) || Isinf(value) || Isnan(exp)) return Exp(exp * Log(value));
+        return DVM_INSTRUMENT_CALL(Detail::PowPositive(value, exp));
+    }
+
+    namespace Detail
+    {
+        //pi/2 split in three parts so that k * hi and k * mid are exact for moderate k (Cody-Waite reduction).
+        //Sin and Cos lose accuracy above about 2^20 * pi/2 for double and 2^10 * pi/2 for float
+        template<typename T> struct PiOver2 { static constexpr T hi = 1.57079632673412561417e+00L; static constexpr T mid = 6.07710050630396597660e-11L; static constexpr T lo = 2.02226624879595063154e-21L; };
+        template<> struct PiOver2<float> { static constexpr float hi = 1.5703125f; static constexpr float mid = 4.837512969970703125e-4f; static constexpr float lo = 7.54978995489188216e-8f; };
+
+        //sin(r) and cos(r) for |r| <= pi/4
+        constexpr float SinPolynomial(float r)
+        {
+            //Cephes sinf minimax coefficients
+            float z = r * r;
+            return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
         }
 
-        T result = 0;
-        T next_term = (x - 1) / (x + 1);
-        T term_squared = next_term * next_term;
-        T denom = 1;
+        constexpr float CosPolynomial(float r)
+        {
+            float z = r * r;
+            return 1.f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+        }
+
+        template<typename T>
+        constexpr T SinPolynomial(T r)
+        {
+            //fdlibm __kernel_sin coefficients
+            T z = r * r;
+            T p = template_cast<T>(1.58969099521155010221e-10L);
+            p = p * z + template_cast<T>(-2.50507602534068634195e-08L);
+            p = p * z + template_cast<T>(2.75573137070700676789e-06L);
+            p = p * z + template_cast<T>(-1.98412698298579493134e-04L);
+            p = p * z + template_cast<T>(8.33333333332248946124e-03L);
+            p = p * z + template_cast<T>(-1.66666666666666324348e-01L);
+            return r + r * z * p;
+        }
 
-        for (int i = 1; i <= 100; ++i) {
-            result += next_term / denom;
-            next_term *= term_squared;
-            denom += 2;
+        template<typename T>
+        constexpr T CosPolynomial(T r)
+        {
+            //fdlibm __kernel_cos coefficients
+            T z = r * r;
+            T p = template_cast<T>(-1.13596475577881948265e-11L);
+            p = p * z + template_cast<T>(2.08757232129817482790e-09L);
+            p = p * z + template_cast<T>(-2.75573143513906633035e-07L);
+            p = p * z + template_cast<T>(2.48015872894767294178e-05L);
+            p = p * z + template_cast<T>(-1.38888888888741095749e-03L);
+            p = p * z + template_cast<T>(4.16666666666666019037e-02L);
+
+            T half = template_cast<T>(0.5L) * z;
+            T w = template_cast<T>(1) - half;
+            return w + (((template_cast<T>(1) - w) - half) + z * z * p);
         }
 
-        result *= 2;
+        //x = r + quadrant * pi/2 with |r| <= pi/4, quadrant is returned modulo 4
+        template<typename T>
+        constexpr T ReducePiOver2(T x, int& quadrant)
+        {
+            T scaled = x * template_cast<T>(0.636619772367581343075535053490057448L);
+            long long k = static_cast<long long>(scaled + (scaled < template_cast<T>(0) ? template_cast<T>(-0.5L) : template_cast<T>(0.5L)));
+            T kf = template_cast<T>(k);
 
-        return result;
+            quadrant = static_cast<int>(k & 3);
+            return ((x - kf * PiOver2<T>::hi) - kf * PiOver2<T>::mid) - kf * PiOver2<T>::lo;
+        }
     }
 
     template<typename T>
-    constexpr T Log2(T x) 
+    constexpr T Sin(T x)
     {
-        constexpr floatingPoint_t<T> divider = Log(template_cast<floatingPoint_t<T>>(2));
-        return template_cast<T>(Log<floatingPoint_t<T>>(template_cast<floatingPoint_t<T>>(x)) / divider);
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Sin(template_cast<floatingPoint_t<T>>(x)));
+        else
+        {
+            if (Isnan(x) || Isinf(x)) return std::numeric_limits<T>::quiet_NaN();
+
+            int quadrant = 0;
+            T r = Detail::ReducePiOver2(x, quadrant);
+
+            switch (quadrant)
+            {
+            case 0: return Detail::SinPolynomial(r);
+            case 1: return Detail::CosPolynomial(r);
+            case 2: return -Detail::SinPolynomial(r);
+            default: return -Detail::CosPolynomial(r);
+            }
+        }
     }
 
-    template<typename T, typename U>
-    constexpr T Pow(T base, U exp) 
+    template<typename T>
+    constexpr T Cos(T x)
     {
-        if (exp == 0) return template_cast<T>(1);
-        else if (exp < 0)
-            return  template_cast<T>(1) / Pow(base, -exp);
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Cos(template_cast<floatingPoint_t<T>>(x)));
         else
         {
-            T result = 1;
-            while (exp > 0)
+            if (Isnan(x) || Isinf(x)) return std::numeric_limits<T>::quiet_NaN();
+
+            int quadrant = 0;
+            T r = Detail::ReducePiOver2(x, quadrant);
+
+            switch (quadrant)
             {
-                result *= base;
-                --exp;
+            case 0: return Detail::CosPolynomial(r);
+            case 1: return -Detail::SinPolynomial(r);
+            case 2: return -Detail::CosPolynomial(r);
+            default: return Detail::SinPolynomial(r);
             }
-            return result;
         }
-        return 0;
     }
 
     template<typename T>
-    constexpr float Pow(T base, float exp)
+    constexpr T Tan(T x) { return Sin(x) / Cos(x); }
+
+    namespace Detail
     {
-        if (exp == 0.f) return 1.f;
-        float result = Exp(exp * Log(static_cast<float>(base)));
-        return result;
+        //asin(r) for 0 <= r <= 0.5
+        constexpr float AsinPolynomial(float r)
+        {
+            //Cephes asinf coefficients
+            float z = r * r;
+            return r + r * z * (1.6666752422e-1f + z * (7.4953002686e-2f + z * (4.5470025998e-2f + z * (2.4181311049e-2f + z * 4.2163199048e-2f))));
+        }
+
+        //Taylor series, every term is at most a quarter of the previous one. The terms after r are summed
+        //on their own, so their rounding errors stay small next to r
+        template<typename T>
+        constexpr T AsinPolynomial(T r)
+        {
+            T z = r * r;
+            T term = r;
+            T tail = 0;
+            int n = 0;
+
+            for (; r + (tail + term) != r + tail; ++n)
+            {
+                T odd = template_cast<T>(2 * n + 1);
+                term *= z * odd * odd / (template_cast<T>(2 * n + 2) * template_cast<T>(2 * n + 3));
+                tail += term;
+            }
+
+            DVM_INSTRUMENT_ITERATIONS(n);
+            return r + tail;
+        }
     }
 
+    //Arguments outside [-1, 1] give NaN. Above 0.5 the argument is reduced with asin(x) = pi/2 - 2 * asin(sqrt((1 - x) / 2))
     template<typename T>
-    constexpr double Pow(T base, double exp)
+    constexpr T Asin(T x)
     {
-        if (exp == 0.) return 1.;
-        double result = Exp(exp * Log(static_cast<double>(base)));
-        return result;
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Asin(template_cast<floatingPoint_t<T>>(x)));
+        else
+        {
+            if (Isnan(x) || Abs(x) > template_cast<T>(1)) return std::numeric_limits<T>::quiet_NaN();
+
+            T a = Abs(x);
+            T result = DVM_INSTRUMENT_CALL(a <= template_cast<T>(0.5)
+                ? Detail::AsinPolynomial(a)
+                : getPi<T>() / template_cast<T>(2) - template_cast<T>(2) * Detail::AsinPolynomial(Sqrt((template_cast<T>(1) - a) / template_cast<T>(2))));
+
+            return x < template_cast<T>(0) ? -result : result;
+        }
     }
 
     template<typename T>
-    constexpr long double Pow(T base, long double exp)
+    constexpr T Acos(T x)
     {
-        if (exp == 0.L) return 1.L;
-        long double result = Exp(exp * Log(static_cast<long double>(base)));
-        return result;
+        if constexpr (!DVTL::Is_floating_point_v<T>)
+            return template_cast<T>(Acos(template_cast<floatingPoint_t<T>>(x)));
+        else
+        {
+            if (Isnan(x) || Abs(x) > template_cast<T>(1)) return std::numeric_limits<T>::quiet_NaN();
+
+            if (x > template_cast<T>(0.5))
+                return template_cast<T>(2) * DVM_INSTRUMENT_CALL(Detail::AsinPolynomial(Sqrt((template_cast<T>(1) - x) / template_cast<T>(2))));
+            if (x < template_cast<T>(-0.5))
+                return getPi<T>() - template_cast<T>(2) * DVM_INSTRUMENT_CALL(Detail::AsinPolynomial(Sqrt((template_cast<T>(1) + x) / template_cast<T>(2))));
+
+            return getPi<T>() / template_cast<T>(2) - DVM_INSTRUMENT_CALL(x < template_cast<T>(0) ? -Detail::AsinPolynomial(-x) : Detail::AsinPolynomial(x));
+        }
     }
-        
+
+    //x = fraction * 2^exp, fraction in [0.5, 1)
     template<typename T>
     constexpr T Frexp(T x, int& exp)
     {
-        if (x == 0) {
+        if (x == 0 || Isnan(x) || Isinf(x)) {
             exp = 0;
             return x;
         }
 
-        exp = static_cast<int>(Log2(Abs(x))) + 1;
-
-        if (Abs(x) >= 0.5 && Abs(x) < 1) 
-            exp--;
+        T mantissa = Detail::Split(Abs(x), exp);
+        ++exp;
 
-        T scaledValue = x * Pow(2, -exp);
-
-        return scaledValue;
+        mantissa *= template_cast<T>(0.5L);
+        return x < 0 ? -mantissa : mantissa;
     }
 
+    //x * 2^exp, exp is updated to the Frexp exponent of the result
     template<typename T>
     constexpr T Idexp(const T& x, int& exp)
     {
-        int oldExp;
+        int oldExp = 0;
         T fraction = Frexp(x, oldExp);
 
         exp = oldExp + exp;
 
-        T result = fraction * Pow(2, exp);
-
-        return result;
+        return Detail::Scale(fraction, exp);
     }
 }
 
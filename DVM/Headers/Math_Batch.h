@@ -0,0 +1,513 @@
+#ifndef DVM_MATH_BATCH_H
+#define DVM_MATH_BATCH_H
+
+#include "Math.h"
+#include "SIMD.h"
+
+//Transcendental and rounding functions over contiguous arrays. Each call processes SIMD::Float8/Float4 (or Double4/Double2)
+//lanes with branch-free range reduction, the results match the scalar functions to within 1 ULP and exactly for
+//Floor, Ceil, Round and Fract. Pow carries the logarithm in two parts like the scalar Pow. in and out may point to
+//the same array.
+namespace DVM
+{
+	namespace Detail
+	{
+#if defined(DVM_SIMD_SSE2)
+		template<typename L>
+		inline L ExpPolynomialLanes(L r)
+		{
+			using T = typename L::Scalar;
+
+			if constexpr (DVTL::Is_same_v<T, float>)
+			{
+				L p = L::Set(1.9875691500e-4f);
+				p = SIMD::MulAdd(p, r, L::Set(1.3981999507e-3f));
+				p = SIMD::MulAdd(p, r, L::Set(8.3334519073e-3f));
+				p = SIMD::MulAdd(p, r, L::Set(4.1665795894e-2f));
+				p = SIMD::MulAdd(p, r, L::Set(1.6666665459e-1f));
+				p = SIMD::MulAdd(p, r, L::Set(5.0000001201e-1f));
+				return SIMD::MulAdd(p, r * r, r) + L::Set(1.f);
+			}
+			else
+			{
+				L t = r * r;
+				L p = L::Set(4.13813679705723846039e-08);
+				p = SIMD::MulAdd(p, t, L::Set(-1.65339022054652515390e-06));
+				p = SIMD::MulAdd(p, t, L::Set(6.61375632143793436117e-05));
+				p = SIMD::MulAdd(p, t, L::Set(-2.77777777770155933842e-03));
+				p = SIMD::MulAdd(p, t, L::Set(1.66666666666666019037e-01));
+				L c = r - t * p;
+				return L::Set(1.) + (r + r * c / (L::Set(2.) - c));
+			}
+		}
+
+		template<typename L>
+		inline L LogPolynomialLanes(L z)
+		{
+			using T = typename L::Scalar;
+
+			if constexpr (DVTL::Is_same_v<T, float>)
+			{
+				L p = L::Set(0.24279078841f);
+				p = SIMD::MulAdd(p, z, L::Set(0.28498786688f));
+				p = SIMD::MulAdd(p, z, L::Set(0.40000972152f));
+				p = SIMD::MulAdd(p, z, L::Set(0.66666662693f));
+				return p * z;
+			}
+			else
+			{
+				L p = L::Set(1.479819860511658591e-01);
+				p = SIMD::MulAdd(p, z, L::Set(1.531383769920937332e-01));
+				p = SIMD::MulAdd(p, z, L::Set(1.818357216161805012e-01));
+				p = SIMD::MulAdd(p, z, L::Set(2.222219843214978396e-01));
+				p = SIMD::MulAdd(p, z, L::Set(2.857142874366239149e-01));
+				p = SIMD::MulAdd(p, z, L::Set(3.999999999940941908e-01));
+				p = SIMD::MulAdd(p, z, L::Set(6.666666666666735130e-01));
+				return p * z;
+			}
+		}
+
+		//p * 2^k, split in two factors so subnormal and near-overflow results stay exact
+		template<typename L>
+		inline L ScaleLanes(L p, L k)
+		{
+			L half = SIMD::RoundToInt(k * L::Set(0.5f));
+			return p * SIMD::Pow2(half) * SIMD::Pow2(k - half);
+		}
+
+		//e^(x + xLo), xLo is the low part of an argument carried in two parts
+		template<typename L>
+		inline L ExpLanes(L x, L xLo)
+		{
+			using T = typename L::Scalar;
+			constexpr T overflow = template_cast<T>(std::numeric_limits<T>::max_exponent) * Ln2Value<T>();
+			constexpr T underflow = template_cast<T>(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1) * Ln2Value<T>();
+
+			L clamped = SIMD::Min(SIMD::Max(x, L::Set(underflow)), L::Set(overflow));
+			L k = SIMD::RoundToInt(clamped * L::Set(Log2E<T>()));
+			L r = ((clamped - k * L::Set(Ln2<T>::hi)) - k * L::Set(Ln2<T>::lo)) + xLo;
+
+			L result = ScaleLanes(ExpPolynomialLanes(r), k);
+			result = SIMD::Select(x > L::Set(overflow), L::Set(std::numeric_limits<T>::infinity()), result);
+			result = SIMD::Select(x < L::Set(underflow), L::Set(T(0)), result);
+			return SIMD::Select(x != x, x, result);
+		}
+
+		template<typename L>
+		inline L ExpLanes(L x) { return ExpLanes(x, L::Set(typename L::Scalar(0))); }
+
+		template<typename L>
+		inline L Exp2Lanes(L x)
+		{
+			using T = typename L::Scalar;
+			constexpr T overflow = template_cast<T>(std::numeric_limits<T>::max_exponent);
+			constexpr T underflow = template_cast<T>(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1);
+
+			L clamped = SIMD::Min(SIMD::Max(x, L::Set(underflow)), L::Set(overflow));
+			L k = SIMD::RoundToInt(clamped);
+			L r = (clamped - k) * L::Set(Ln2Value<T>());
+
+			L result = ScaleLanes(ExpPolynomialLanes(r), k);
+			result = SIMD::Select(x > L::Set(overflow), L::Set(std::numeric_limits<T>::infinity()), result);
+			result = SIMD::Select(x < L::Set(underflow), L::Set(T(0)), result);
+			return SIMD::Select(x != x, x, result);
+		}
+
+		//x = 2^exponent * (1 + f) with 1 + f in [sqrt(2)/2, sqrt(2)], returns f
+		template<typename L>
+		inline L LogMantissaLanes(L x, L& exponent)
+		{
+			using T = typename L::Scalar;
+
+			L subnormal = x < L::Set(std::numeric_limits<T>::min());
+			L scaled = SIMD::Select(subnormal, x * L::Set(Pow2<T>(std::numeric_limits<T>::digits)), x);
+
+			L mantissa = L::Set(T(1));
+			exponent = SIMD::SplitExponent(scaled, mantissa);
+			exponent = exponent - (subnormal & L::Set(template_cast<T>(std::numeric_limits<T>::digits)));
+
+			L big = mantissa > L::Set(template_cast<T>(1.41421356237309504880L));
+			mantissa = SIMD::Select(big, mantissa * L::Set(T(0.5)), mantissa);
+			exponent = exponent + (big & L::Set(T(1)));
+			return mantissa - L::Set(T(1));
+		}
+
+		//Shared reduction of Log and Log2: x = 2^exponent * (1 + f), returns ln(1 + f) - f as -correction
+		template<typename L>
+		inline L LogReducedLanes(L x, L& exponent, L& f)
+		{
+			using T = typename L::Scalar;
+
+			f = LogMantissaLanes(x, exponent);
+			L s = f / (L::Set(T(2)) + f);
+			L hfsq = L::Set(T(0.5)) * f * f;
+			return hfsq - s * (hfsq + LogPolynomialLanes(s * s));
+		}
+
+		//Same special values as the scalar Log: NaN stays NaN, x <= 0 gives -1, +inf stays +inf
+		template<typename L>
+		inline L LogSpecialLanes(L x, L result)
+		{
+			using T = typename L::Scalar;
+
+			result = SIMD::Select(x <= L::Set(T(0)), L::Set(T(-1)), result);
+			result = SIMD::Select(x == L::Set(std::numeric_limits<T>::infinity()), x, result);
+			return SIMD::Select(x != x, x, result);
+		}
+
+		template<typename L>
+		inline L LogLanes(L x)
+		{
+			using T = typename L::Scalar;
+
+			L exponent, f;
+			L correction = LogReducedLanes(x, exponent, f);
+			L result = exponent * L::Set(Ln2<T>::hi) - ((correction - exponent * L::Set(Ln2<T>::lo)) - f);
+			return LogSpecialLanes(x, result);
+		}
+
+		template<typename L>
+		inline L Log2Lanes(L x)
+		{
+			using T = typename L::Scalar;
+
+			L exponent, f;
+			L correction = LogReducedLanes(x, exponent, f);
+			L result = exponent + (f - correction) * L::Set(Log2E<T>());
+			return LogSpecialLanes(x, result);
+		}
+
+		template<typename L>
+		inline L SqrtLanes(L x)
+		{
+			using T = typename L::Scalar;
+			return SIMD::Select(x < L::Set(T(0)), L::Set(T(0)), SIMD::Sqrt(x));
+		}
+
+		//TwoProduct of Math.h per lane. The fused product cannot be contracted into the sums that use it, a plain
+		//a * b can be, which would count the error twice
+		template<typename L>
+		inline L TwoProductLanes(L a, L b, L& error)
+		{
+			using T = typename L::Scalar;
+
+#if defined(DVM_SIMD_FMA)
+			L product = SIMD::MulAdd(a, b, L::Set(T(0)));
+			error = SIMD::MulAdd(a, b, L::Set(T(0)) - product);
+#else
+			L product = a * b;
+			constexpr T split = Pow2<T>((std::numeric_limits<T>::digits + 1) / 2) + T(1);
+			L aHi = L::Set(split) * a;
+			aHi = aHi - (aHi - a);
+			L bHi = L::Set(split) * b;
+			bHi = bHi - (bHi - b);
+			L aLo = a - aHi, bLo = b - bHi;
+			error = ((aHi * bHi - product) + aHi * bLo + aLo * bHi) + aLo * bLo;
+#endif
+			return product;
+		}
+
+		//LogExtended of Math.h per lane, ln(x) = result + lo for finite x > 0
+		template<typename L>
+		inline L LogExtendedLanes(L x, L& lo)
+		{
+			using T = typename L::Scalar;
+			using Series = LogSeries<T>;
+			const Series& series = LogSeriesCoefficients<T>;
+
+			L exponent;
+			L f = LogMantissaLanes(x, exponent);
+
+			L u = L::Set(T(2)) + f;
+			L uLo = f - (u - L::Set(T(2)));
+			L s = f / u;
+			L error;
+			L product = TwoProductLanes(s, u, error);
+			L sLo = (((f - product) - error) - s * uLo) / u;
+
+			L zLo;
+			L z = TwoProductLanes(s, s, zLo);
+			zLo = zLo + L::Set(T(2)) * s * sLo;
+
+			L tail = L::Set(series.tail[Series::Terms - 2]);
+			for (int i = Series::Terms - 3; i >= 0; --i)
+				tail = SIMD::MulAdd(z, tail, L::Set(series.tail[i]));
+			tail = tail * z;
+
+			L p = L::Set(series.leading) + tail;
+			L pLo = ((L::Set(series.leading) - p) + tail) + L::Set(series.leadingLo);
+
+			L rLo;
+			L r = TwoProductLanes(z, p, rLo);
+			rLo = rLo + z * pLo + zLo * p;
+
+			L srLo;
+			L sr = TwoProductLanes(s, r, srLo);
+			srLo = srLo + s * rLo + sLo * r;
+
+			L twoS = L::Set(T(2)) * s;
+			L mantissa = twoS + sr;
+			L mantissaLo = ((twoS - mantissa) + sr) + (srLo + L::Set(T(2)) * sLo);
+
+			L kLo;
+			L kMid = TwoProductLanes(exponent, L::Set(Ln2<T>::lo), kLo);
+			L kHi = exponent * L::Set(Ln2<T>::hi);
+
+			L sum = kHi + mantissa;
+			lo = (((kHi - sum) + mantissa) + (mantissaLo + kLo)) + kMid;
+			L result = sum + lo;
+			lo = (sum - result) + lo;
+			return result;
+		}
+
+		//Same special values as the scalar Pow: exp == 0 and base == 1 give 1, base == 0 gives 0 and other bases
+		//outside (0, inf) go through the plain logarithm with its special values
+		template<typename L>
+		inline L PowLanes(L base, L exp)
+		{
+			using T = typename L::Scalar;
+
+			L logLo;
+			L logHi = LogExtendedLanes(base, logLo);
+			L special = (base <= L::Set(T(0))) | (base == L::Set(std::numeric_limits<T>::infinity())) | (base != base);
+			logHi = LogSpecialLanes(base, logHi);
+
+			L productLo;
+			L product = TwoProductLanes(exp, logHi, productLo);
+			productLo = SIMD::Select(special | (exp != exp), L::Set(T(0)), productLo + exp * logLo);
+
+			L result = ExpLanes(product, productLo);
+			result = SIMD::Select(base == L::Set(T(0)), L::Set(T(0)), result);
+			return SIMD::Select((exp == L::Set(T(0))) | (base == L::Set(T(1))), L::Set(T(1)), result);
+		}
+
+		template<typename L>
+		inline L FractLanes(L x) { return x - SIMD::Floor(x); }
+
+		//Same formula as the scalar Mod, the result has the sign of mod
+		template<typename L>
+		inline L ModLanes(L x, L mod) { return x - mod * SIMD::Floor(x / mod); }
+
+		//Runs kernel over whole lanes, the tail goes through one padded lane so every element takes the same path
+		template<typename L, typename F>
+		inline void ApplyLanes(const typename L::Scalar* in, typename L::Scalar* out, size_t count, F kernel)
+		{
+			using T = typename L::Scalar;
+
+			size_t i = 0;
+			for (; i + L::Width <= count; i += L::Width)
+				kernel(L::Load(in + i)).Store(out + i);
+
+			if (i < count)
+			{
+				T buffer[L::Width];
+				for (size_t j = 0; j < L::Width; ++j)
+					buffer[j] = i + j < count ? in[i + j] : T(1);
+
+				kernel(L::Load(buffer)).Store(buffer);
+
+				for (size_t j = 0; i + j < count; ++j)
+					out[i + j] = buffer[j];
+			}
+		}
+
+		template<typename L, typename F>
+		inline void ApplyLanes(const typename L::Scalar* in, const typename L::Scalar* in2, typename L::Scalar* out, size_t count, F kernel)
+		{
+			using T = typename L::Scalar;
+
+			size_t i = 0;
+			for (; i + L::Width <= count; i += L::Width)
+				kernel(L::Load(in + i), L::Load(in2 + i)).Store(out + i);
+
+			if (i < count)
+			{
+				T buffer[L::Width];
+				T buffer2[L::Width];
+				for (size_t j = 0; j < L::Width; ++j)
+				{
+					buffer[j] = i + j < count ? in[i + j] : T(1);
+					buffer2[j] = i + j < count ? in2[i + j] : T(1);
+				}
+
+				kernel(L::Load(buffer), L::Load(buffer2)).Store(buffer);
+
+				for (size_t j = 0; i + j < count; ++j)
+					out[i + j] = buffer[j];
+			}
+		}
+
+		template<typename T>
+		constexpr bool HasLanes = DVTL::Is_same_v<T, float> || DVTL::Is_same_v<T, double>;
+#else
+		template<typename T>
+		constexpr bool HasLanes = false;
+#endif
+	}
+
+	template<typename T>
+	inline void ExpBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return Detail::ExpLanes(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Exp(in[i]);
+	}
+
+	template<typename T>
+	inline void Exp2Batch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return Detail::Exp2Lanes(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Exp2(in[i]);
+	}
+
+	template<typename T>
+	inline void LogBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return Detail::LogLanes(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Log(in[i]);
+	}
+
+	template<typename T>
+	inline void Log2Batch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return Detail::Log2Lanes(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Log2(in[i]);
+	}
+
+	template<typename T>
+	inline void SqrtBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return Detail::SqrtLanes(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Sqrt(in[i]);
+	}
+
+	template<typename T>
+	inline void PowBatch(const T* base, const T* exp, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(base, exp, out, count, [](auto x, auto y) { return Detail::PowLanes(x, y); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Pow(base[i], exp[i]);
+	}
+
+	template<typename T>
+	inline void PowBatch(const T* base, T exp, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+		{
+			using L = SIMD::WideLane_t<T>;
+			L exponent = L::Set(exp);
+			Detail::ApplyLanes<L>(base, out, count, [exponent](L x) { return Detail::PowLanes(x, exponent); });
+		}
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Pow(base[i], exp);
+	}
+
+	template<typename T>
+	inline void FloorBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return SIMD::Floor(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Floor(in[i]);
+	}
+
+	template<typename T>
+	inline void CeilBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return SIMD::Ceil(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Ceil(in[i]);
+	}
+
+	template<typename T>
+	inline void RoundBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return SIMD::Round(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Round(in[i]);
+	}
+
+	template<typename T>
+	inline void FractBatch(const T* in, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, out, count, [](auto x) { return Detail::FractLanes(x); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Fract(in[i]);
+	}
+
+	template<typename T>
+	inline void ModBatch(const T* in, const T* mod, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+			Detail::ApplyLanes<SIMD::WideLane_t<T>>(in, mod, out, count, [](auto x, auto y) { return Detail::ModLanes(x, y); });
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Mod(in[i], mod[i]);
+	}
+
+	template<typename T>
+	inline void ModBatch(const T* in, T mod, T* out, size_t count)
+	{
+#if defined(DVM_SIMD_SSE2)
+		if constexpr (Detail::HasLanes<T>)
+		{
+			using L = SIMD::WideLane_t<T>;
+			L modulus = L::Set(mod);
+			Detail::ApplyLanes<L>(in, out, count, [modulus](L x) { return Detail::ModLanes(x, modulus); });
+		}
+		else
+#endif
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Mod(in[i], mod);
+	}
+}
+
+#endif // !DVM_MATH_BATCH_H
@@ -1,6 +1,11 @@
 #ifndef DVM_MATRIX_H
 #define DVM_MATRIX_H
 
+#include <cstddef>
+
+#include "Expression.h"
+#include "Utility.h"
+
 namespace DVM 
 {
 
@@ -12,13 +17,9 @@ namespace DVM
 
 		T data[C * R];
 
-		MatTemplate()
-		{
-			for (size_t i = 0; i < C * R; ++i)
-					data[i] = T{};
-		}
+		constexpr MatTemplate() : data{} {}
 
-		MatTemplate(T diagonalValue)
+		constexpr MatTemplate(T diagonalValue) : data{}
 		{
 			static_assert(C == R, "Diagonal matrix requires square matrix");
 
@@ -27,13 +28,13 @@ namespace DVM
 					data[i * R + j] = (i == j) ? diagonalValue : T{};
 		}
 
-		MatTemplate(T initValues[C * R])
+		constexpr MatTemplate(T initValues[C * R]) : data{}
 		{
 			for (size_t i = 0; i < C * R; ++i)
 				data[i] = initValues[i];
 		}
 
-		MatTemplate(T initValues[C][R])
+		constexpr MatTemplate(T initValues[C][R]) : data{}
 		{
 			for (size_t i = 0; i < C; ++i)
 				for (size_t j = 0; j < R; ++j)
@@ -41,7 +42,7 @@ namespace DVM
 		}
 
 		template<typename... Args>
-		MatTemplate(Args... args)
+		constexpr MatTemplate(Args... args) : data{}
 		{
 			static_assert(sizeof...(Args) == C * R, "Number of arguments must match matrix size");
 
@@ -52,14 +53,11 @@ namespace DVM
 
 		}
 
-		MatTemplate(const MatTemplate& right)
-		{
-			for (size_t i = 0; i < C * R; ++i)
-				data[i] = right[i / R][i % R];
-		}
+		//Defaulted copies and destructor keep the type trivially copyable, arrays of matrices copy as memcpy
+		constexpr MatTemplate(const MatTemplate& right) = default;
 
-		template<typename U>
-		MatTemplate(U diagonalValue)
+		template<typename U, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<U>, int> = 0>
+		constexpr MatTemplate(U diagonalValue) : data{}
 		{
 			static_assert(C == R, "Diagonal matrix requires square matrix");
 
@@ -69,14 +67,14 @@ namespace DVM
 		}
 
 		template<typename U>
-		MatTemplate(U initValues[C * R])
+		constexpr MatTemplate(U initValues[C * R]) : data{}
 		{
 			for (size_t i = 0; i < C * R; ++i)
 				data[i] = static_cast<T>(initValues[i]);
 		}
 
 		template<typename U>
-		MatTemplate(U initValues[C][R])
+		constexpr MatTemplate(U initValues[C][R]) : data{}
 		{
 			for (size_t i = 0; i < C; ++i)
 				for (size_t j = 0; j < R; ++j)
@@ -84,56 +82,68 @@ namespace DVM
 		}
 
 		template<typename U>
-		MatTemplate(const MatTemplate<U, C, R>& right)
+		constexpr MatTemplate(const MatTemplate<U, C, R>& right) : data{}
 		{
 			for (size_t i = 0; i < C * R; ++i)
-				data[i] = static_cast<T>(right[i / R][i % R]);
+				data[i] = static_cast<T>(right.data[i]);
 		}
 
-		MatTemplate& operator=(const MatTemplate& right)
+		//Evaluates an Expression.h expression in one pass
+		template<typename E, DVTL::Enable_if_t<Detail::IsExpression_v<E>, int> = 0>
+		constexpr MatTemplate(const E& expression) : data{}
 		{
-			if (this != &right)
-				for (size_t i = 0; i < C * R; ++i)
-					data[i] = right[i / R][i % R];
-
-			return *this;
+			static_assert(DVTL::Is_same_v<typename Detail::ExpressionTraits<E>::Result, MatTemplate>, "Expression must have the matrix type");
+			Detail::EvaluateExpression<C * R>(data, expression);
 		}
 
+		constexpr MatTemplate& operator=(const MatTemplate& right) = default;
+
 		template<typename U>
-		MatTemplate& operator=(const MatTemplate<U, C, R>& right)
+		constexpr MatTemplate& operator=(const MatTemplate<U, C, R>& right)
 		{
-			if (this != &right)
-				for (size_t i = 0; i < R * R; ++i)
-					data[i] = static_cast<T>(right[i / R][i % R]);
+			for (size_t i = 0; i < C * R; ++i)
+				data[i] = static_cast<T>(right.data[i]);
 
 			return *this;
 		}
 
-		~MatTemplate() {};
+		//Operands of an expression are only read at the index being written, so it may refer to this matrix
+		template<typename E, DVTL::Enable_if_t<Detail::IsExpression_v<E>, int> = 0>
+		constexpr MatTemplate& operator=(const E& expression)
+		{
+			static_assert(DVTL::Is_same_v<typename Detail::ExpressionTraits<E>::Result, MatTemplate>, "Expression must have the matrix type");
+			Detail::EvaluateExpression<C * R>(data, expression);
+			return *this;
+		}
+
+		~MatTemplate() = default;
 
 		constexpr size_t Size() const { return C*R; }
 
-		inline			T* operator[](size_t index)			{ return &data[index * R]; }
-		inline const	T* operator[](size_t index) const	{ return &data[index * R]; }
-		inline			T& operator()(size_t i, size_t j)		{ return data[i * R + j]; }
-		inline const	T& operator()(size_t i, size_t j) const	{ return data[i * R + j]; }
+		constexpr		T* operator[](size_t index)			{ return &data[index * R]; }
+		constexpr const	T* operator[](size_t index) const	{ return &data[index * R]; }
+		constexpr		T& operator()(size_t i, size_t j)		{ return data[i * R + j]; }
+		constexpr const	T& operator()(size_t i, size_t j) const	{ return data[i * R + j]; }
 
-		MatTemplate& operator++();
-		MatTemplate& operator--();
-		const MatTemplate operator++(int);
-		const MatTemplate operator--(int);
+		constexpr MatTemplate& operator++();
+		constexpr MatTemplate& operator--();
+		constexpr const MatTemplate operator++(int);
+		constexpr const MatTemplate operator--(int);
 
 		//Composite statements of the MatTemplate class
-		MatTemplate& operator*=(T value);
-		MatTemplate& operator*=(const MatTemplate& value);
-		MatTemplate& operator/=(T value);
-		MatTemplate& operator/=(const MatTemplate& value);
-		MatTemplate& operator+=(T value);
-		MatTemplate& operator+=(const MatTemplate& value);
-		MatTemplate& operator-=(T value);
-		MatTemplate& operator-=(const MatTemplate& value);
+		constexpr MatTemplate& operator*=(T value);
+		constexpr MatTemplate& operator*=(const MatTemplate& value);
+		constexpr MatTemplate& operator/=(T value);
+		constexpr MatTemplate& operator/=(const MatTemplate& value);
+		constexpr MatTemplate& operator+=(T value);
+		constexpr MatTemplate& operator+=(const MatTemplate& value);
+		constexpr MatTemplate& operator-=(T value);
+		constexpr MatTemplate& operator-=(const MatTemplate& value);
 	};
 
+	static_assert(DVTL::Is_trivially_copyable_v<MatTemplate<float, 4, 4>> && DVTL::Is_trivially_copyable_v<MatTemplate<double, 3, 3>>, "MatTemplate must be trivially copyable");
+	static_assert(DVTL::Is_standard_layout_v<MatTemplate<float, 4, 4>> && DVTL::Is_standard_layout_v<MatTemplate<double, 3, 3>>, "MatTemplate must be standard layout");
+
 	using Mat2i = MatTemplate<int, 2, 2>;
 	using Mat2c = MatTemplate<char, 2, 2>;
 	using Mat2f = MatTemplate<float, 2, 2>;
@@ -171,7 +181,7 @@ namespace DVM
 	using Mat4ulli = MatTemplate<unsigned long long int, 4, 4>;
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator++()
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator++()
 	{
 		for (size_t i = 0; i < C * R; ++i)
 			++data[i];
@@ -180,7 +190,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator--()
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator--()
 	{
 		for (size_t i = 0; i < C * R; ++i)
 			--data[i];
@@ -189,7 +199,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline const MatTemplate<T, C, R> MatTemplate<T, C, R>::operator++(int)
+	constexpr const MatTemplate<T, C, R> MatTemplate<T, C, R>::operator++(int)
 	{
 		MatTemplate temp(*this);
 		++(*this);
@@ -197,7 +207,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline const MatTemplate<T, C, R> MatTemplate<T, C, R>::operator--(int)
+	constexpr const MatTemplate<T, C, R> MatTemplate<T, C, R>::operator--(int)
 	{
 		MatTemplate temp(*this);
 		--(*this);
@@ -206,7 +216,7 @@ namespace DVM
 
 	//Composite statements of the MatTemplate class
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator*=(T value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator*=(T value)
 	{
 		for (size_t i = 0; i < C * R; ++i)
 			data[i] *= value;
@@ -215,7 +225,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator*=(const MatTemplate& value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator*=(const MatTemplate& value)
 	{
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
@@ -225,7 +235,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator/=(T value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator/=(T value)
 	{
 		for (size_t i = 0; i < C * R; ++i)
 				data[i] /= value;
@@ -234,17 +244,17 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator/=(const MatTemplate& value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator/=(const MatTemplate& value)
 	{
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
-				data[i * R + j] /= value;
+				data[i * R + j] /= value[i][j];
 
 		return *this;
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator+=(T value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator+=(T value)
 	{
 		for (size_t i = 0; i < C * R; ++i)
 				data[i] += value;
@@ -253,7 +263,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator+=(const MatTemplate& value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator+=(const MatTemplate& value)
 	{
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
@@ -263,7 +273,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator-=(T value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator-=(T value)
 	{
 		for (size_t i = 0; i < C * R; ++i)
 				data[i] -= value;
@@ -272,7 +282,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t C, size_t R>
-	inline MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator-=(const MatTemplate& value)
+	constexpr MatTemplate<T, C, R>& MatTemplate<T, C, R>::operator-=(const MatTemplate& value)
 	{
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
@@ -282,68 +292,70 @@ namespace DVM
 	}
 
 	//External operators of the MatTemplate class
+#if !defined(DVM_EXPRESSION_TEMPLATES)
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator*(MatTemplate<T, C, R> lhs, T rhs) 
+	constexpr MatTemplate<T, C, R> operator*(MatTemplate<T, C, R> lhs, T rhs) 
 	{
 		lhs *= rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator*(T lhs, MatTemplate<T, C, R> rhs) 
+	constexpr MatTemplate<T, C, R> operator*(T lhs, MatTemplate<T, C, R> rhs) 
 	{
 		rhs *= lhs;
 		return rhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator*(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
+	constexpr MatTemplate<T, C, R> operator*(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
 	{
 		lhs *= rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator/(MatTemplate<T, C, R> lhs, T rhs) 
+	constexpr MatTemplate<T, C, R> operator/(MatTemplate<T, C, R> lhs, T rhs) 
 	{
 		lhs /= rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator/(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
+	constexpr MatTemplate<T, C, R> operator/(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
 	{
 		lhs /= rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator+(MatTemplate<T, C, R> lhs, T rhs) 
+	constexpr MatTemplate<T, C, R> operator+(MatTemplate<T, C, R> lhs, T rhs) 
 	{
 		lhs += rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator+(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
+	constexpr MatTemplate<T, C, R> operator+(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
 	{
 		lhs += rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator-(MatTemplate<T, C, R> lhs, T rhs) 
+	constexpr MatTemplate<T, C, R> operator-(MatTemplate<T, C, R> lhs, T rhs) 
 	{
 		lhs -= rhs;
 		return lhs;
 	}
 
 	template<typename T, size_t C, size_t R>
-	MatTemplate<T, C, R> operator-(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
+	constexpr MatTemplate<T, C, R> operator-(MatTemplate<T, C, R> lhs, const MatTemplate<T, C, R>& rhs) 
 	{
 		lhs -= rhs;
 		return lhs;
 	}
+#endif
 }
 
 #endif // !DVM_MATRIX_H
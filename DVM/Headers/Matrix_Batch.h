@@ -0,0 +1,295 @@
+#ifndef DVM_MATRIX_BATCH_H
+#define DVM_MATRIX_BATCH_H
+
+#include "Math.h"
+#include "Math_Batch.h"
+#include "Matrix.h"
+#include "Matrix_Math.h"
+#include "SIMD.h"
+#include "ThreadPool.h"
+#include "Utility.h"
+#include "VecArray.h"
+#include "Vector.h"
+
+//One matrix applied to many vectors, with the matrix loaded into registers once per call.
+//Arrays of vectors take in, out and count like Math_Batch.h, VecArray overloads write the last argument
+//like VecArray_Math.h. Outputs may be the same array or object as the input.
+//TransformPoint treats Vec3 as (x, y, z, 1) and drops w, ProjectPoint also divides by w
+namespace DVM
+{
+	namespace Detail
+	{
+		//Parts of a batch split over a ThreadPool start on multiples of this many vectors. SIMD blocks and
+		//scalar tails then fall on the same vectors as in the serial call and the results match it bit for bit
+		constexpr size_t TransformBlock = 4096;
+
+		template<typename F>
+		inline void ParallelTransform(ThreadPool& pool, size_t count, F function)
+		{
+			size_t blocks = (count + TransformBlock - 1) / TransformBlock;
+			pool.ParallelFor(0, blocks, 1, [&](size_t first, size_t last)
+			{
+				function(first * TransformBlock, Min(last * TransformBlock, count));
+			});
+		}
+
+#if defined(DVM_SIMD_SSE2)
+		//m[j * 4 + i] holds mat[j][i] in every lane, the order of operations matches TransformPoint
+		template<bool Projective, typename L>
+		inline void TransformPointLanes(const L* m, L x, L y, L z, L& rx, L& ry, L& rz)
+		{
+			rx = SIMD::MulAdd(m[8], z, SIMD::MulAdd(m[4], y, SIMD::MulAdd(m[0], x, m[12])));
+			ry = SIMD::MulAdd(m[9], z, SIMD::MulAdd(m[5], y, SIMD::MulAdd(m[1], x, m[13])));
+			rz = SIMD::MulAdd(m[10], z, SIMD::MulAdd(m[6], y, SIMD::MulAdd(m[2], x, m[14])));
+
+			if constexpr (Projective)
+			{
+				L w = SIMD::MulAdd(m[11], z, SIMD::MulAdd(m[7], y, SIMD::MulAdd(m[3], x, m[15])));
+				rx = rx / w;
+				ry = ry / w;
+				rz = rz / w;
+			}
+		}
+
+		template<typename L, typename T, size_t N>
+		inline void BroadcastMatrix(const MatTemplate<T, N, N>& mat, L* m)
+		{
+			for (size_t i = 0; i < N * N; ++i)
+				m[i] = L::Set(mat.data[i]);
+		}
+#endif
+
+		template<typename T, size_t N>
+		inline void LinearTransformStreams(const MatTemplate<T, N, N>& mat, const VecArray<T, N>& vec, VecArray<T, N>& result, size_t first, size_t last)
+		{
+			size_t i = first;
+
+#if defined(DVM_SIMD_SSE2)
+			if constexpr (HasLanes<T>)
+			{
+				using L = SIMD::WideLane_t<T>;
+
+				L m[N * N];
+				BroadcastMatrix(mat, m);
+
+				for (; i + L::Width <= last; i += L::Width)
+				{
+					L x[N];
+					for (size_t j = 0; j < N; ++j)
+						x[j] = L::Load(vec.Stream(j) + i);
+
+					for (size_t r = 0; r < N; ++r)
+					{
+						L sum = m[r] * x[0];
+						for (size_t j = 1; j < N; ++j)
+							sum = SIMD::MulAdd(m[j * N + r], x[j], sum);
+						sum.Store(result.Stream(r) + i);
+					}
+				}
+			}
+#endif
+
+			for (; i < last; ++i)
+				result.Set(i, linearTransformation(mat, vec.Get(i)));
+		}
+
+		template<bool Projective, typename T>
+		inline void TransformPointStreams(const MatTemplate<T, 4, 4>& mat, const VecArray<T, 3>& vec, VecArray<T, 3>& result, size_t first, size_t last)
+		{
+			size_t i = first;
+
+#if defined(DVM_SIMD_SSE2)
+			if constexpr (HasLanes<T>)
+			{
+				using L = SIMD::WideLane_t<T>;
+
+				L m[16];
+				BroadcastMatrix(mat, m);
+
+				for (; i + L::Width <= last; i += L::Width)
+				{
+					L rx, ry, rz;
+					TransformPointLanes<Projective>(m, L::Load(vec.X() + i), L::Load(vec.Y() + i), L::Load(vec.Z() + i), rx, ry, rz);
+					rx.Store(result.X() + i);
+					ry.Store(result.Y() + i);
+					rz.Store(result.Z() + i);
+				}
+			}
+#endif
+
+			for (; i < last; ++i)
+				result.Set(i, Projective ? ProjectPoint(mat, vec.Get(i)) : TransformPoint(mat, vec.Get(i)));
+		}
+
+#if defined(DVM_SIMD_SSE2)
+		//Four Vec3f at a time, split into x, y and z lanes with SIMD::Deinterleave3
+		template<bool Projective>
+		inline void TransformPointArray(const Mat4f& mat, const Vec3f* in, Vec3f* out, size_t count)
+		{
+			using SIMD::Float4;
+
+			Float4 m[16];
+			BroadcastMatrix(mat, m);
+
+			size_t blockEnd = count - count % 4;
+			size_t i = 0;
+			for (; i < blockEnd; i += 4)
+			{
+				const float* ptr = in[i].data;
+				Float4 x, y, z, rx, ry, rz;
+				SIMD::Deinterleave3(_mm_loadu_ps(ptr), _mm_loadu_ps(ptr + 4), _mm_loadu_ps(ptr + 8), x.v, y.v, z.v);
+
+				TransformPointLanes<Projective>(m, x, y, z, rx, ry, rz);
+
+				__m128 a, b, c;
+				SIMD::Interleave3(rx.v, ry.v, rz.v, a, b, c);
+				_mm_storeu_ps(out[i].data, a);
+				_mm_storeu_ps(out[i].data + 4, b);
+				_mm_storeu_ps(out[i].data + 8, c);
+			}
+
+			for (; i < count; ++i)
+				out[i] = Projective ? ProjectPoint(mat, in[i]) : TransformPoint(mat, in[i]);
+		}
+#endif
+	}
+
+	template<typename T, size_t N>
+	inline void linearTransformationBatch(const MatTemplate<T, N, N>& mat, const VecTemplate<T, N>* in, VecTemplate<T, N>* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = linearTransformation(mat, in[i]);
+	}
+
+	template<typename T>
+	inline void TransformPointBatch(const MatTemplate<T, 4, 4>& mat, const VecTemplate<T, 3>* in, VecTemplate<T, 3>* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = TransformPoint(mat, in[i]);
+	}
+
+	template<typename T>
+	inline void ProjectPointBatch(const MatTemplate<T, 4, 4>& mat, const VecTemplate<T, 3>* in, VecTemplate<T, 3>* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = ProjectPoint(mat, in[i]);
+	}
+
+#if defined(DVM_SIMD_SSE2)
+	//Result is the sum of the columns weighted by the broadcast components
+	inline void linearTransformationBatch(const Mat4f& mat, const Vec4f* in, Vec4f* out, size_t count)
+	{
+		using SIMD::Float4;
+
+		Float4 c0 = Float4::Load(mat[0]);
+		Float4 c1 = Float4::Load(mat[1]);
+		Float4 c2 = Float4::Load(mat[2]);
+		Float4 c3 = Float4::Load(mat[3]);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float* vec = in[i].data;
+			Float4 sum = c0 * Float4::Set(vec[0]);
+			sum = SIMD::MulAdd(c1, Float4::Set(vec[1]), sum);
+			sum = SIMD::MulAdd(c2, Float4::Set(vec[2]), sum);
+			sum = SIMD::MulAdd(c3, Float4::Set(vec[3]), sum);
+			sum.Store(out[i].data);
+		}
+	}
+
+	inline void TransformPointBatch(const Mat4f& mat, const Vec3f* in, Vec3f* out, size_t count)
+	{
+		Detail::TransformPointArray<false>(mat, in, out, count);
+	}
+
+	inline void ProjectPointBatch(const Mat4f& mat, const Vec3f* in, Vec3f* out, size_t count)
+	{
+		Detail::TransformPointArray<true>(mat, in, out, count);
+	}
+#endif
+
+#if defined(DVM_SIMD_AVX)
+	inline void linearTransformationBatch(const Mat4d& mat, const Vec4d* in, Vec4d* out, size_t count)
+	{
+		using SIMD::Double4;
+
+		Double4 c0 = Double4::Load(mat[0]);
+		Double4 c1 = Double4::Load(mat[1]);
+		Double4 c2 = Double4::Load(mat[2]);
+		Double4 c3 = Double4::Load(mat[3]);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const double* vec = in[i].data;
+			Double4 sum = c0 * Double4::Set(vec[0]);
+			sum = SIMD::MulAdd(c1, Double4::Set(vec[1]), sum);
+			sum = SIMD::MulAdd(c2, Double4::Set(vec[2]), sum);
+			sum = SIMD::MulAdd(c3, Double4::Set(vec[3]), sum);
+			sum.Store(out[i].data);
+		}
+	}
+#endif
+
+	template<typename T, size_t N>
+	inline void linearTransformation(const MatTemplate<T, N, N>& mat, const VecArray<T, N>& vec, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		Detail::LinearTransformStreams(mat, vec, result, 0, vec.Size());
+	}
+
+	template<typename T>
+	inline void TransformPoint(const MatTemplate<T, 4, 4>& mat, const VecArray<T, 3>& vec, VecArray<T, 3>& result)
+	{
+		result.Resize(vec.Size());
+		Detail::TransformPointStreams<false>(mat, vec, result, 0, vec.Size());
+	}
+
+	template<typename T>
+	inline void ProjectPoint(const MatTemplate<T, 4, 4>& mat, const VecArray<T, 3>& vec, VecArray<T, 3>& result)
+	{
+		result.Resize(vec.Size());
+		Detail::TransformPointStreams<true>(mat, vec, result, 0, vec.Size());
+	}
+
+	//Same as the serial versions, split over pool in blocks of Detail::TransformBlock vectors
+	template<typename T, size_t N>
+	inline void linearTransformationBatch(ThreadPool& pool, const MatTemplate<T, N, N>& mat, const VecTemplate<T, N>* in, VecTemplate<T, N>* out, size_t count)
+	{
+		Detail::ParallelTransform(pool, count, [&](size_t first, size_t last) { linearTransformationBatch(mat, in + first, out + first, last - first); });
+	}
+
+	template<typename T>
+	inline void TransformPointBatch(ThreadPool& pool, const MatTemplate<T, 4, 4>& mat, const VecTemplate<T, 3>* in, VecTemplate<T, 3>* out, size_t count)
+	{
+		Detail::ParallelTransform(pool, count, [&](size_t first, size_t last) { TransformPointBatch(mat, in + first, out + first, last - first); });
+	}
+
+	template<typename T>
+	inline void ProjectPointBatch(ThreadPool& pool, const MatTemplate<T, 4, 4>& mat, const VecTemplate<T, 3>* in, VecTemplate<T, 3>* out, size_t count)
+	{
+		Detail::ParallelTransform(pool, count, [&](size_t first, size_t last) { ProjectPointBatch(mat, in + first, out + first, last - first); });
+	}
+
+	template<typename T, size_t N>
+	inline void linearTransformation(ThreadPool& pool, const MatTemplate<T, N, N>& mat, const VecArray<T, N>& vec, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		Detail::ParallelTransform(pool, vec.Size(), [&](size_t first, size_t last) { Detail::LinearTransformStreams(mat, vec, result, first, last); });
+	}
+
+	template<typename T>
+	inline void TransformPoint(ThreadPool& pool, const MatTemplate<T, 4, 4>& mat, const VecArray<T, 3>& vec, VecArray<T, 3>& result)
+	{
+		result.Resize(vec.Size());
+		Detail::ParallelTransform(pool, vec.Size(), [&](size_t first, size_t last) { Detail::TransformPointStreams<false>(mat, vec, result, first, last); });
+	}
+
+	template<typename T>
+	inline void ProjectPoint(ThreadPool& pool, const MatTemplate<T, 4, 4>& mat, const VecArray<T, 3>& vec, VecArray<T, 3>& result)
+	{
+		result.Resize(vec.Size());
+		Detail::ParallelTransform(pool, vec.Size(), [&](size_t first, size_t last) { Detail::TransformPointStreams<true>(mat, vec, result, first, last); });
+	}
+}
+
+#endif // !DVM_MATRIX_BATCH_H
@@ -0,0 +1,682 @@
+#ifndef DVM_MATRIX_KERNELS_H
+#define DVM_MATRIX_KERNELS_H
+
+#include <cstddef>
+
+#include "Math.h"
+#include "SIMD.h"
+#include "Utility.h"
+
+//Kernels over plain row major arrays (a[i * n + j] for n columns), shared by MatTemplate and the dynamic matrices.
+//Scratch memory is passed in by the caller so the kernels never allocate.
+namespace DVM
+{
+	namespace Detail
+	{
+		//Integral matrices are inverted and solved in double and rounded back
+		template<typename T>
+		using LUValue_t = DVTL::Conditional_t<DVTL::Is_floating_point_v<T>, T, double>;
+
+		template<typename T, typename F>
+		constexpr T FromLUValue(F value)
+		{
+			if constexpr (DVTL::Is_floating_point_v<T>)
+				return template_cast<T>(value);
+			else
+				return template_cast<T>(value < F(0) ? value - F(0.5) : value + F(0.5));
+		}
+
+		//Gemm blocking: a GemmBlockK x GemmBlockN panel of b stays in L2 while every row of a passes over it,
+		//GemmRows rows of c are accumulated in registers for each strip of columns
+		constexpr size_t GemmBlockK = 128;
+		constexpr size_t GemmBlockN = 512;
+		constexpr size_t GemmRows = 4;
+
+#if defined(DVM_SIMD_SSE2)
+		//Rows x (Cols * Width) tile of c += a * b, a and c point at the first row, b and c at the first column.
+		//lda, ldb and ldc are the row strides of a, b and c
+		template<typename L, size_t Rows, size_t Cols>
+		inline void GemmTile(const typename L::Scalar* a, size_t lda, const typename L::Scalar* b, size_t ldb, typename L::Scalar* c, size_t ldc, size_t depth)
+		{
+			L acc[Rows][Cols];
+			for (size_t r = 0; r < Rows; ++r)
+				for (size_t q = 0; q < Cols; ++q)
+					acc[r][q] = L::Load(c + r * ldc + q * L::Width);
+
+			for (size_t p = 0; p < depth; ++p)
+			{
+				L row[Cols];
+				for (size_t q = 0; q < Cols; ++q)
+					row[q] = L::Load(b + p * ldb + q * L::Width);
+
+				for (size_t r = 0; r < Rows; ++r)
+				{
+					L value = L::Set(a[r * lda + p]);
+					for (size_t q = 0; q < Cols; ++q)
+						acc[r][q] = SIMD::MulAdd(value, row[q], acc[r][q]);
+				}
+			}
+
+			for (size_t r = 0; r < Rows; ++r)
+				for (size_t q = 0; q < Cols; ++q)
+					acc[r][q].Store(c + r * ldc + q * L::Width);
+		}
+
+		//The hot 4 x 2 tile, written out so the accumulators stay in registers
+		template<typename L>
+		inline void GemmTile4x2(const typename L::Scalar* a, size_t lda, const typename L::Scalar* b, size_t ldb, typename L::Scalar* c, size_t ldc, size_t depth)
+		{
+			constexpr size_t w = L::Width;
+
+			L c00 = L::Load(c),			c01 = L::Load(c + w);
+			L c10 = L::Load(c + ldc),		c11 = L::Load(c + ldc + w);
+			L c20 = L::Load(c + 2 * ldc),	c21 = L::Load(c + 2 * ldc + w);
+			L c30 = L::Load(c + 3 * ldc),	c31 = L::Load(c + 3 * ldc + w);
+
+			for (size_t p = 0; p < depth; ++p)
+			{
+				L b0 = L::Load(b + p * ldb);
+				L b1 = L::Load(b + p * ldb + w);
+
+				L a0 = L::Set(a[p]);
+				c00 = SIMD::MulAdd(a0, b0, c00); c01 = SIMD::MulAdd(a0, b1, c01);
+				L a1 = L::Set(a[lda + p]);
+				c10 = SIMD::MulAdd(a1, b0, c10); c11 = SIMD::MulAdd(a1, b1, c11);
+				L a2 = L::Set(a[2 * lda + p]);
+				c20 = SIMD::MulAdd(a2, b0, c20); c21 = SIMD::MulAdd(a2, b1, c21);
+				L a3 = L::Set(a[3 * lda + p]);
+				c30 = SIMD::MulAdd(a3, b0, c30); c31 = SIMD::MulAdd(a3, b1, c31);
+			}
+
+			c00.Store(c);			c01.Store(c + w);
+			c10.Store(c + ldc);		c11.Store(c + ldc + w);
+			c20.Store(c + 2 * ldc);	c21.Store(c + 2 * ldc + w);
+			c30.Store(c + 3 * ldc);	c31.Store(c + 3 * ldc + w);
+		}
+
+		template<typename L, size_t Rows>
+		inline void GemmStrip(const typename L::Scalar* a, size_t lda, const typename L::Scalar* b, size_t ldb, typename L::Scalar* c, size_t ldc, size_t depth, size_t width)
+		{
+			size_t j = 0;
+			for (; j + 2 * L::Width <= width; j += 2 * L::Width)
+			{
+				if constexpr (Rows == 4)
+					GemmTile4x2<L>(a, lda, b + j, ldb, c + j, ldc, depth);
+				else
+					GemmTile<L, Rows, 2>(a, lda, b + j, ldb, c + j, ldc, depth);
+			}
+			for (; j + L::Width <= width; j += L::Width)
+				GemmTile<L, Rows, 1>(a, lda, b + j, ldb, c + j, ldc, depth);
+
+			for (size_t r = 0; r < Rows; ++r)
+				for (size_t p = 0; p < depth; ++p)
+					for (size_t jj = j; jj < width; ++jj)
+						c[r * ldc + jj] += a[r * lda + p] * b[p * ldb + jj];
+		}
+#endif
+
+		//c += a * b for row major a (m x n), b (n x k) and c (m x k) with row strides lda, ldb and ldc.
+		//c must not overlap a or b
+		template<typename T>
+		inline void GemmAccumulate(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t m, size_t n, size_t k)
+		{
+			for (size_t p0 = 0; p0 < n; p0 += GemmBlockK)
+			{
+				size_t depth = Min(GemmBlockK, n - p0);
+
+				for (size_t j0 = 0; j0 < k; j0 += GemmBlockN)
+				{
+					size_t width = Min(GemmBlockN, k - j0);
+					const T* panel = b + p0 * ldb + j0;
+
+#if defined(DVM_SIMD_SSE2)
+					if constexpr (DVTL::Is_same_v<T, float> || DVTL::Is_same_v<T, double>)
+					{
+						using L = SIMD::WideLane_t<T>;
+
+						size_t rows = m - m % GemmRows;
+						for (size_t i = 0; i < rows; i += GemmRows)
+							GemmStrip<L, GemmRows>(a + i * lda + p0, lda, panel, ldb, c + i * ldc + j0, ldc, depth, width);
+						for (size_t i = rows; i < m; ++i)
+							GemmStrip<L, 1>(a + i * lda + p0, lda, panel, ldb, c + i * ldc + j0, ldc, depth, width);
+						continue;
+					}
+#endif
+					for (size_t i = 0; i < m; ++i)
+						for (size_t p = 0; p < depth; ++p)
+						{
+							T value = a[i * lda + p0 + p];
+							for (size_t j = 0; j < width; ++j)
+								c[i * ldc + j0 + j] += value * panel[p * ldb + j];
+						}
+				}
+			}
+		}
+
+		//c = a * b for contiguous row major a (m x n), b (n x k) and c (m x k)
+		template<typename T>
+		inline void Gemm(const T* a, const T* b, T* c, size_t m, size_t n, size_t k)
+		{
+			for (size_t i = 0; i < m * k; ++i)
+				c[i] = T{};
+
+			GemmAccumulate(a, n, b, k, c, k, m, n, k);
+		}
+
+		//Calls function(first, last) once over [0, count). Kernels that can split their work take an executor
+		//with this signature, the parallel versions pass one backed by a ThreadPool
+		struct SerialExecutor
+		{
+			template<typename F>
+			void operator()(size_t count, size_t, F&& function) const { function(size_t(0), count); }
+		};
+
+		//Gemm over row groups of GemmRows split by executor
+		template<typename T, typename Executor>
+		inline void GemmAccumulate(const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t m, size_t n, size_t k, const Executor& executor)
+		{
+			executor((m + GemmRows - 1) / GemmRows, 4, [=](size_t first, size_t last)
+			{
+				size_t rowFirst = first * GemmRows;
+				size_t rowLast = Min(last * GemmRows, m);
+				GemmAccumulate(a + rowFirst * lda, lda, b, ldb, c + rowFirst * ldc, ldc, rowLast - rowFirst, n, k);
+			});
+		}
+
+		//Columns factored per panel by the blocked LU, the trailing update then runs through GemmAccumulate
+		constexpr size_t LUBlock = 64;
+
+		//Right looking blocked LU with the same result layout as LUDecompose
+		template<typename T, typename Executor = SerialExecutor>
+		inline bool LUDecomposeBlocked(T* a, size_t n, size_t* pivot, T& sign, const Executor& executor = Executor())
+		{
+			sign = template_cast<T>(1);
+
+			for (size_t k0 = 0; k0 < n; k0 += LUBlock)
+			{
+				size_t k1 = Min(k0 + LUBlock, n);
+
+				//Panel: columns k0..k1 of every row below k0, swaps move whole rows
+				for (size_t k = k0; k < k1; ++k)
+				{
+					size_t best = k;
+					for (size_t i = k + 1; i < n; ++i)
+						if (Abs(a[i * n + k]) > Abs(a[best * n + k]))
+							best = i;
+
+					pivot[k] = best;
+					if (a[best * n + k] == template_cast<T>(0))
+						return false;
+
+					if (best != k)
+					{
+						for (size_t j = 0; j < n; ++j)
+						{
+							T temp = a[k * n + j];
+							a[k * n + j] = a[best * n + j];
+							a[best * n + j] = temp;
+						}
+						sign = -sign;
+					}
+
+					T inv = template_cast<T>(1) / a[k * n + k];
+					for (size_t i = k + 1; i < n; ++i)
+					{
+						T factor = a[i * n + k] * inv;
+						a[i * n + k] = factor;
+
+						for (size_t j = k + 1; j < k1; ++j)
+							a[i * n + j] -= factor * a[k * n + j];
+					}
+				}
+
+				if (k1 == n) break;
+
+				//U12 = L11^-1 * A12
+				for (size_t k = k0; k < k1; ++k)
+					for (size_t i = k + 1; i < k1; ++i)
+					{
+						T factor = a[i * n + k];
+						for (size_t j = k1; j < n; ++j)
+							a[i * n + j] -= factor * a[k * n + j];
+					}
+
+				//A22 -= L21 * U12, run as A22 += L21 * (-U12) so the kernel only has to accumulate
+				for (size_t i = k0; i < k1; ++i)
+					for (size_t j = k1; j < n; ++j)
+						a[i * n + j] = -a[i * n + j];
+
+				GemmAccumulate(a + k1 * n + k0, n, a + k0 * n + k1, n, a + k1 * n + k1, n, n - k1, k1 - k0, n - k1, executor);
+
+				for (size_t i = k0; i < k1; ++i)
+					for (size_t j = k1; j < n; ++j)
+						a[i * n + j] = -a[i * n + j];
+			}
+
+			return true;
+		}
+
+		//In place LU decomposition with partial pivoting, L has a unit diagonal and is stored below it.
+		//pivot[i] is the row swapped into row i, sign is the permutation parity. Returns false if a is singular.
+		template<typename T>
+		constexpr bool LUDecompose(T* a, size_t n, size_t* pivot, T& sign)
+		{
+			if (n > LUBlock && !DVM_IS_CONSTANT_EVALUATED())
+			{
+				DVM_INSTRUMENT_ITERATIONS(n);
+				return LUDecomposeBlocked(a, n, pivot, sign);
+			}
+
+			sign = template_cast<T>(1);
+
+			for (size_t k = 0; k < n; ++k)
+			{
+				DVM_INSTRUMENT_ITERATIONS(1);
+
+				size_t best = k;
+				for (size_t i = k + 1; i < n; ++i)
+					if (Abs(a[i * n + k]) > Abs(a[best * n + k]))
+						best = i;
+
+				pivot[k] = best;
+				if (a[best * n + k] == template_cast<T>(0))
+					return false;
+
+				if (best != k)
+				{
+					for (size_t j = 0; j < n; ++j)
+					{
+						T temp = a[k * n + j];
+						a[k * n + j] = a[best * n + j];
+						a[best * n + j] = temp;
+					}
+					sign = -sign;
+				}
+
+				T inv = template_cast<T>(1) / a[k * n + k];
+				for (size_t i = k + 1; i < n; ++i)
+				{
+					T factor = a[i * n + k] * inv;
+					a[i * n + k] = factor;
+
+					for (size_t j = k + 1; j < n; ++j)
+						a[i * n + j] -= factor * a[k * n + j];
+				}
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		constexpr T LUDeterminant(const T* lu, size_t n, T sign)
+		{
+			T result = sign;
+			for (size_t i = 0; i < n; ++i)
+				result *= lu[i * n + i];
+			return result;
+		}
+
+		//Solves a * x = b for the LU decomposed a, b and x may be the same array
+		template<typename T>
+		constexpr void LUSolve(const T* lu, size_t n, const size_t* pivot, const T* b, T* x)
+		{
+			if (x != b)
+				for (size_t i = 0; i < n; ++i)
+					x[i] = b[i];
+
+			for (size_t i = 0; i < n; ++i)
+				if (pivot[i] != i)
+				{
+					T temp = x[i];
+					x[i] = x[pivot[i]];
+					x[pivot[i]] = temp;
+				}
+
+			for (size_t i = 1; i < n; ++i)
+			{
+				T sum = x[i];
+				for (size_t j = 0; j < i; ++j)
+					sum -= lu[i * n + j] * x[j];
+				x[i] = sum;
+			}
+
+			for (size_t i = n; i-- > 0;)
+			{
+				T sum = x[i];
+				for (size_t j = i + 1; j < n; ++j)
+					sum -= lu[i * n + j] * x[j];
+				x[i] = sum / lu[i * n + i];
+			}
+		}
+
+		//Columns [first, last) of the inverse of the LU decomposed matrix, one column of the identity at a time
+		//through column (n values). Disjoint column ranges can run on different threads
+		template<typename T>
+		constexpr void LUInverseColumns(const T* lu, size_t n, const size_t* pivot, T* result, T* column, size_t first, size_t last)
+		{
+			for (size_t j = first; j < last; ++j)
+			{
+				for (size_t i = 0; i < n; ++i)
+					column[i] = i == j ? template_cast<T>(1) : template_cast<T>(0);
+
+				LUSolve(lu, n, pivot, column, column);
+
+				for (size_t i = 0; i < n; ++i)
+					result[i * n + j] = column[i];
+			}
+		}
+
+		template<typename T>
+		constexpr void LUInverse(const T* lu, size_t n, const size_t* pivot, T* result, T* column)
+		{
+			LUInverseColumns(lu, n, pivot, result, column, 0, n);
+		}
+
+		//Fraction free elimination (Bareiss), exact for integral types. a is overwritten
+		template<typename T>
+		constexpr T BareissDeterminant(T* a, size_t n)
+		{
+			T sign = template_cast<T>(1);
+			T previous = template_cast<T>(1);
+
+			for (size_t k = 0; k + 1 < n; ++k)
+			{
+				DVM_INSTRUMENT_ITERATIONS(1);
+
+				if (a[k * n + k] == template_cast<T>(0))
+				{
+					size_t row = k + 1;
+					while (row < n && a[row * n + k] == template_cast<T>(0))
+						++row;
+
+					if (row == n)
+						return template_cast<T>(0);
+
+					for (size_t j = 0; j < n; ++j)
+					{
+						T temp = a[k * n + j];
+						a[k * n + j] = a[row * n + j];
+						a[row * n + j] = temp;
+					}
+					sign = -sign;
+				}
+
+				for (size_t i = k + 1; i < n; ++i)
+					for (size_t j = k + 1; j < n; ++j)
+						a[i * n + j] = (a[i * n + j] * a[k * n + k] - a[i * n + k] * a[k * n + j]) / previous;
+
+				previous = a[k * n + k];
+			}
+
+			return sign * a[(n - 1) * n + (n - 1)];
+		}
+
+		//In place Cholesky decomposition a = L * L^T of the symmetric positive definite a, only the lower triangle
+		//is read. L replaces it and the upper triangle is zeroed. Returns false if a is not positive definite
+		template<typename T>
+		constexpr bool CholeskyDecompose(T* a, size_t n)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				T diagonal = a[j * n + j];
+				for (size_t k = 0; k < j; ++k)
+					diagonal -= a[j * n + k] * a[j * n + k];
+
+				if (!(diagonal > template_cast<T>(0)))
+					return false;
+
+				diagonal = Sqrt(diagonal);
+				a[j * n + j] = diagonal;
+
+				T inv = template_cast<T>(1) / diagonal;
+				for (size_t i = j + 1; i < n; ++i)
+				{
+					T sum = a[i * n + j];
+					for (size_t k = 0; k < j; ++k)
+						sum -= a[i * n + k] * a[j * n + k];
+
+					a[i * n + j] = sum * inv;
+					a[j * n + i] = template_cast<T>(0);
+				}
+			}
+
+			return true;
+		}
+
+		//Solves L * L^T * x = b for the Cholesky factor L, b and x may be the same array
+		template<typename T>
+		constexpr void CholeskySolve(const T* l, size_t n, const T* b, T* x)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				T sum = b[i];
+				for (size_t j = 0; j < i; ++j)
+					sum -= l[i * n + j] * x[j];
+				x[i] = sum / l[i * n + i];
+			}
+
+			for (size_t i = n; i-- > 0;)
+			{
+				T sum = x[i];
+				for (size_t j = i + 1; j < n; ++j)
+					sum -= l[j * n + i] * x[j];
+				x[i] = sum / l[i * n + i];
+			}
+		}
+
+		//In place Householder QR of the m x n matrix a. R replaces the upper triangle, the reflector of column k is
+		//(1, a[k + 1][k], ..., a[m - 1][k]) with the scale tau[k], min(m, n) values. Q = H(0) * ... * H(min(m, n) - 1)
+		//with H(k) = I - tau[k] * v * v^T
+		template<typename T>
+		constexpr void QRDecompose(T* a, size_t m, size_t n, T* tau)
+		{
+			size_t steps = Min(m, n);
+
+			for (size_t k = 0; k < steps; ++k)
+			{
+				T below = template_cast<T>(0);
+				for (size_t i = k + 1; i < m; ++i)
+					below += a[i * n + k] * a[i * n + k];
+
+				//Nothing to eliminate, H(k) is the identity
+				if (below == template_cast<T>(0))
+				{
+					tau[k] = template_cast<T>(0);
+					continue;
+				}
+
+				T head = a[k * n + k];
+				T norm = Sqrt(head * head + below);
+				T beta = head > template_cast<T>(0) ? -norm : norm;
+
+				T inv = template_cast<T>(1) / (head - beta);
+				for (size_t i = k + 1; i < m; ++i)
+					a[i * n + k] *= inv;
+
+				tau[k] = (beta - head) / beta;
+				a[k * n + k] = beta;
+
+				for (size_t j = k + 1; j < n; ++j)
+				{
+					T dot = a[k * n + j];
+					for (size_t i = k + 1; i < m; ++i)
+						dot += a[i * n + k] * a[i * n + j];
+					dot *= tau[k];
+
+					a[k * n + j] -= dot;
+					for (size_t i = k + 1; i < m; ++i)
+						a[i * n + j] -= dot * a[i * n + k];
+				}
+			}
+		}
+
+		//b = Q^T * b for the QR decomposed m x n matrix, b has m values
+		template<typename T>
+		constexpr void QRApplyTranspose(const T* qr, size_t m, size_t n, const T* tau, T* b)
+		{
+			size_t steps = Min(m, n);
+
+			for (size_t k = 0; k < steps; ++k)
+			{
+				T dot = b[k];
+				for (size_t i = k + 1; i < m; ++i)
+					dot += qr[i * n + k] * b[i];
+				dot *= tau[k];
+
+				b[k] -= dot;
+				for (size_t i = k + 1; i < m; ++i)
+					b[i] -= dot * qr[i * n + k];
+			}
+		}
+
+		//The m x m orthogonal Q of the QR decomposed m x n matrix, written to q
+		template<typename T>
+		constexpr void QRFormQ(const T* qr, size_t m, size_t n, const T* tau, T* q)
+		{
+			for (size_t i = 0; i < m; ++i)
+				for (size_t j = 0; j < m; ++j)
+					q[i * m + j] = i == j ? template_cast<T>(1) : template_cast<T>(0);
+
+			//Q = H(0) * (H(1) * (... * I)), each H(k) only touches rows k and below
+			for (size_t k = Min(m, n); k-- > 0;)
+				for (size_t j = k; j < m; ++j)
+				{
+					T dot = q[k * m + j];
+					for (size_t i = k + 1; i < m; ++i)
+						dot += qr[i * n + k] * q[i * m + j];
+					dot *= tau[k];
+
+					q[k * m + j] -= dot;
+					for (size_t i = k + 1; i < m; ++i)
+						q[i * m + j] -= dot * qr[i * n + k];
+				}
+		}
+
+		//Least squares solution x (n values) of a * x = b for the QR decomposed m x n matrix, m >= n. b (m values)
+		//is overwritten with Q^T * b. Returns false if R is singular
+		template<typename T>
+		constexpr bool QRSolve(const T* qr, size_t m, size_t n, const T* tau, T* b, T* x)
+		{
+			QRApplyTranspose(qr, m, n, tau, b);
+
+			for (size_t i = n; i-- > 0;)
+			{
+				if (qr[i * n + i] == template_cast<T>(0))
+					return false;
+
+				T sum = b[i];
+				for (size_t j = i + 1; j < n; ++j)
+					sum -= qr[i * n + j] * x[j];
+				x[i] = sum / qr[i * n + i];
+			}
+
+			return true;
+		}
+
+		//Cyclic sweeps give up after this many, they converge quadratically and usually stop within 10
+		constexpr int JacobiMaxSweeps = 50;
+
+		//Eigen decomposition of the symmetric n x n matrix a by cyclic Jacobi rotations. a is overwritten and ends
+		//up diagonal, values gets the eigenvalues in ascending order and row i of vectors the unit eigenvector of
+		//values[i]. Returns false if the sweeps did not converge
+		template<typename T>
+		constexpr bool JacobiEigen(T* a, size_t n, T* values, T* vectors)
+		{
+			for (size_t i = 0; i < n; ++i)
+				for (size_t j = 0; j < n; ++j)
+					vectors[i * n + j] = i == j ? template_cast<T>(1) : template_cast<T>(0);
+
+			T scale = template_cast<T>(0);
+			for (size_t i = 0; i < n * n; ++i)
+				scale += a[i] * a[i];
+			T tolerance = scale * std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+			bool converged = false;
+			for (int sweep = 0; sweep < JacobiMaxSweeps && !converged; ++sweep)
+			{
+				DVM_INSTRUMENT_ITERATIONS(1);
+
+				T off = template_cast<T>(0);
+				for (size_t p = 0; p < n; ++p)
+					for (size_t q = p + 1; q < n; ++q)
+						off += a[p * n + q] * a[p * n + q];
+
+				converged = off <= tolerance;
+				if (converged)
+					break;
+
+				for (size_t p = 0; p < n; ++p)
+					for (size_t q = p + 1; q < n; ++q)
+					{
+						T apq = a[p * n + q];
+						if (apq == template_cast<T>(0))
+							continue;
+
+						//Smaller root t = tan(angle) of t^2 + 2 * theta * t - 1 = 0 with theta = difference / (2 * apq),
+						//multiplied through by 2 * apq to save a division. The angle stays below pi/4
+						T difference = a[q * n + q] - a[p * n + p];
+						T twice = template_cast<T>(2) * apq;
+						T t = twice / (Abs(difference) + Sqrt(difference * difference + twice * twice));
+						if (difference < template_cast<T>(0))
+							t = -t;
+
+						T c = template_cast<T>(1) / Sqrt(t * t + template_cast<T>(1));
+						T s = t * c;
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							T akp = a[k * n + p];
+							T akq = a[k * n + q];
+							a[k * n + p] = c * akp - s * akq;
+							a[k * n + q] = s * akp + c * akq;
+						}
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							T apk = a[p * n + k];
+							T aqk = a[q * n + k];
+							a[p * n + k] = c * apk - s * aqk;
+							a[q * n + k] = s * apk + c * aqk;
+
+							T vpk = vectors[p * n + k];
+							T vqk = vectors[q * n + k];
+							vectors[p * n + k] = c * vpk - s * vqk;
+							vectors[q * n + k] = s * vpk + c * vqk;
+						}
+
+						a[p * n + q] = template_cast<T>(0);
+						a[q * n + p] = template_cast<T>(0);
+					}
+			}
+
+			for (size_t i = 0; i < n; ++i)
+				values[i] = a[i * n + i];
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				size_t smallest = i;
+				for (size_t j = i + 1; j < n; ++j)
+					if (values[j] < values[smallest])
+						smallest = j;
+
+				if (smallest == i)
+					continue;
+
+				T temp = values[i];
+				values[i] = values[smallest];
+				values[smallest] = temp;
+
+				for (size_t k = 0; k < n; ++k)
+				{
+					temp = vectors[i * n + k];
+					vectors[i * n + k] = vectors[smallest * n + k];
+					vectors[smallest * n + k] = temp;
+				}
+			}
+
+			return converged;
+		}
+	}
+}
+
+#endif // !DVM_MATRIX_KERNELS_H
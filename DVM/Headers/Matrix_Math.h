@@ -3,6 +3,9 @@
 
 #include "Math.h"
 #include "Matrix.h"
+#include "Matrix_Kernels.h"
+#include "SIMD.h"
+#include "Utility.h"
 #include "Vector.h"
 
 namespace DVM
@@ -16,53 +19,270 @@ namespace DVM
 				mat[0][1] * (mat[1][0] * mat[2][2] - mat[1][2] * mat[2][0]) +
 				mat[0][2] * (mat[1][0] * mat[2][1] - mat[1][1] * mat[2][0]);
 	}
+	template<typename T> constexpr T Determinant(const MatTemplate<T, 4, 4>& mat)
+	{
+		T s0 = mat[0][0] * mat[1][1] - mat[1][0] * mat[0][1];
+		T s1 = mat[0][0] * mat[1][2] - mat[1][0] * mat[0][2];
+		T s2 = mat[0][0] * mat[1][3] - mat[1][0] * mat[0][3];
+		T s3 = mat[0][1] * mat[1][2] - mat[1][1] * mat[0][2];
+		T s4 = mat[0][1] * mat[1][3] - mat[1][1] * mat[0][3];
+		T s5 = mat[0][2] * mat[1][3] - mat[1][2] * mat[0][3];
+
+		T c5 = mat[2][2] * mat[3][3] - mat[3][2] * mat[2][3];
+		T c4 = mat[2][1] * mat[3][3] - mat[3][1] * mat[2][3];
+		T c3 = mat[2][1] * mat[3][2] - mat[3][1] * mat[2][2];
+		T c2 = mat[2][0] * mat[3][3] - mat[3][0] * mat[2][3];
+		T c1 = mat[2][0] * mat[3][2] - mat[3][0] * mat[2][2];
+		T c0 = mat[2][0] * mat[3][1] - mat[3][0] * mat[2][1];
+
+		return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	}
+
+	//Above 4x4: LU with partial pivoting for floating point, exact Bareiss elimination for integral types
 	template<typename T, size_t C, size_t R>
 	constexpr T Determinant(const MatTemplate<T, C, R>& mat)
 	{
 		static_assert(C == R, "the matrix must be square");
-		
-		T result = 0;
-		T sign = 1;
-		MatTemplate<T, C - 1, R - 1> subMat;
 
-		for (size_t i = 0; i < C; ++i)
+		MatTemplate<T, C, R> temp(mat);
+
+		if constexpr (DVTL::Is_floating_point_v<T>)
 		{
-			for (size_t x = 0; x < C - 1; ++x)
-				for (size_t y = 0; y < R - 1; ++y)
-						subMat[x][y] = mat[x < i ? x : x + 1][y + 1];
+			size_t pivot[C]{};
+			T sign = 1;
+			if (!DVM_INSTRUMENT_CALL(Detail::LUDecompose(temp.data, C, pivot, sign))) return template_cast<T>(0);
 
-			result += sign * mat[i][0] * Determinant(subMat);
-			sign *= -1;
+			return Detail::LUDeterminant(temp.data, C, sign);
 		}
+		else
+			return DVM_INSTRUMENT_CALL(Detail::BareissDeterminant(temp.data, C));
+	}
 
-		return result;
+	//Inverse returns a zero matrix if mat is singular
+	template<typename T>
+	constexpr MatTemplate<T, 1, 1> Inverse(const MatTemplate<T, 1, 1>& mat)
+	{
+		if (mat[0][0] == template_cast<T>(0)) return MatTemplate<T, 1, 1>();
+
+		MatTemplate<T, 1, 1> resultMat;
+		resultMat[0][0] = template_cast<T>(1) / mat[0][0];
+		return resultMat;
+	}
+
+	template<typename T>
+	constexpr MatTemplate<T, 2, 2> Inverse(const MatTemplate<T, 2, 2>& mat)
+	{
+		T deter = Determinant(mat);
+		if (deter == template_cast<T>(0)) return MatTemplate<T, 2, 2>();
+
+		MatTemplate<T, 2, 2> resultMat;
+		resultMat[0][0] = mat[1][1];
+		resultMat[0][1] = -mat[0][1];
+		resultMat[1][0] = -mat[1][0];
+		resultMat[1][1] = mat[0][0];
+
+		resultMat *= template_cast<T>(1) / deter;
+		return resultMat;
+	}
+
+	template<typename T>
+	constexpr MatTemplate<T, 3, 3> Inverse(const MatTemplate<T, 3, 3>& mat)
+	{
+		T deter = Determinant(mat);
+		if (deter == template_cast<T>(0)) return MatTemplate<T, 3, 3>();
+
+		MatTemplate<T, 3, 3> resultMat;
+		resultMat[0][0] = mat[1][1] * mat[2][2] - mat[1][2] * mat[2][1];
+		resultMat[0][1] = mat[0][2] * mat[2][1] - mat[0][1] * mat[2][2];
+		resultMat[0][2] = mat[0][1] * mat[1][2] - mat[0][2] * mat[1][1];
+		resultMat[1][0] = mat[1][2] * mat[2][0] - mat[1][0] * mat[2][2];
+		resultMat[1][1] = mat[0][0] * mat[2][2] - mat[0][2] * mat[2][0];
+		resultMat[1][2] = mat[0][2] * mat[1][0] - mat[0][0] * mat[1][2];
+		resultMat[2][0] = mat[1][0] * mat[2][1] - mat[1][1] * mat[2][0];
+		resultMat[2][1] = mat[0][1] * mat[2][0] - mat[0][0] * mat[2][1];
+		resultMat[2][2] = mat[0][0] * mat[1][1] - mat[0][1] * mat[1][0];
+
+		resultMat *= template_cast<T>(1) / deter;
+		return resultMat;
+	}
+
+	//Unrolled cofactor inverse from 2x2 sub-determinants, the common case for transforms
+	template<typename T>
+	constexpr MatTemplate<T, 4, 4> Inverse(const MatTemplate<T, 4, 4>& mat)
+	{
+		T s0 = mat[0][0] * mat[1][1] - mat[1][0] * mat[0][1];
+		T s1 = mat[0][0] * mat[1][2] - mat[1][0] * mat[0][2];
+		T s2 = mat[0][0] * mat[1][3] - mat[1][0] * mat[0][3];
+		T s3 = mat[0][1] * mat[1][2] - mat[1][1] * mat[0][2];
+		T s4 = mat[0][1] * mat[1][3] - mat[1][1] * mat[0][3];
+		T s5 = mat[0][2] * mat[1][3] - mat[1][2] * mat[0][3];
+
+		T c5 = mat[2][2] * mat[3][3] - mat[3][2] * mat[2][3];
+		T c4 = mat[2][1] * mat[3][3] - mat[3][1] * mat[2][3];
+		T c3 = mat[2][1] * mat[3][2] - mat[3][1] * mat[2][2];
+		T c2 = mat[2][0] * mat[3][3] - mat[3][0] * mat[2][3];
+		T c1 = mat[2][0] * mat[3][2] - mat[3][0] * mat[2][2];
+		T c0 = mat[2][0] * mat[3][1] - mat[3][0] * mat[2][1];
+
+		T deter = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		if (deter == template_cast<T>(0)) return MatTemplate<T, 4, 4>();
+
+		MatTemplate<T, 4, 4> resultMat;
+		resultMat[0][0] =  mat[1][1] * c5 - mat[1][2] * c4 + mat[1][3] * c3;
+		resultMat[0][1] = -mat[0][1] * c5 + mat[0][2] * c4 - mat[0][3] * c3;
+		resultMat[0][2] =  mat[3][1] * s5 - mat[3][2] * s4 + mat[3][3] * s3;
+		resultMat[0][3] = -mat[2][1] * s5 + mat[2][2] * s4 - mat[2][3] * s3;
+
+		resultMat[1][0] = -mat[1][0] * c5 + mat[1][2] * c2 - mat[1][3] * c1;
+		resultMat[1][1] =  mat[0][0] * c5 - mat[0][2] * c2 + mat[0][3] * c1;
+		resultMat[1][2] = -mat[3][0] * s5 + mat[3][2] * s2 - mat[3][3] * s1;
+		resultMat[1][3] =  mat[2][0] * s5 - mat[2][2] * s2 + mat[2][3] * s1;
+
+		resultMat[2][0] =  mat[1][0] * c4 - mat[1][1] * c2 + mat[1][3] * c0;
+		resultMat[2][1] = -mat[0][0] * c4 + mat[0][1] * c2 - mat[0][3] * c0;
+		resultMat[2][2] =  mat[3][0] * s4 - mat[3][1] * s2 + mat[3][3] * s0;
+		resultMat[2][3] = -mat[2][0] * s4 + mat[2][1] * s2 - mat[2][3] * s0;
+
+		resultMat[3][0] = -mat[1][0] * c3 + mat[1][1] * c1 - mat[1][2] * c0;
+		resultMat[3][1] =  mat[0][0] * c3 - mat[0][1] * c1 + mat[0][2] * c0;
+		resultMat[3][2] = -mat[3][0] * s3 + mat[3][1] * s1 - mat[3][2] * s0;
+		resultMat[3][3] =  mat[2][0] * s3 - mat[2][1] * s1 + mat[2][2] * s0;
+
+		resultMat *= template_cast<T>(1) / deter;
+		return resultMat;
 	}
 
+	//Above 4x4: LU with partial pivoting, O(n^3)
 	template<typename T, size_t C, size_t R>
 	constexpr MatTemplate<T, R, C> Inverse(const MatTemplate<T, C, R>& mat)
 	{
 		static_assert(C == R, "the matrix must be square");
 
-		T deter = Determinant(mat);
-		if (deter == template_cast<T>(0)) return MatTemplate<T, R, C>();
+		using F = Detail::LUValue_t<T>;
+
+		MatTemplate<F, C, R> lu(mat);
+		size_t pivot[C]{};
+		F sign = 1;
+		if (!DVM_INSTRUMENT_CALL(Detail::LUDecompose(lu.data, C, pivot, sign))) return MatTemplate<T, R, C>();
+
+		MatTemplate<F, R, C> inverse;
+		F column[C]{};
+		Detail::LUInverse(lu.data, C, pivot, inverse.data, column);
 
-		T sign = 1;
 		MatTemplate<T, R, C> resultMat;
-		MatTemplate<T, C - 1, R - 1> subMat;
+		for (size_t i = 0; i < C * R; ++i)
+			resultMat.data[i] = Detail::FromLUValue<T>(inverse.data[i]);
 
+		return resultMat;
+	}
+
+	//x such that linearTransformation(mat, x) == vec, a zero vector if mat is singular
+	template<typename T, size_t C, size_t R>
+	constexpr VecTemplate<T, C> Solve(const MatTemplate<T, C, R>& mat, const VecTemplate<T, C>& vec)
+	{
+		static_assert(C == R, "the matrix must be square");
+
+		using F = Detail::LUValue_t<T>;
+
+		//linearTransformation reads mat[j][i] as row i, column j
+		MatTemplate<F, C, R> lu;
 		for (size_t i = 0; i < C; ++i)
-			for(size_t j = 0; j < R; ++j)
-			{
-				for (size_t x = 0; x < C - 1; ++x)
-					for (size_t y = 0; y < R - 1; ++y)
-						subMat[x][y] = mat[x < i ? x : x + 1][y < j ? y : y + 1];
+			for (size_t j = 0; j < R; ++j)
+				lu[i][j] = template_cast<F>(mat[j][i]);
 
-				resultMat[j][i] = sign * Determinant(subMat);
-				sign *= -1;
-			}
+		size_t pivot[C]{};
+		F sign = 1;
+		if (!DVM_INSTRUMENT_CALL(Detail::LUDecompose(lu.data, C, pivot, sign))) return VecTemplate<T, C>();
 
-		resultMat *= 1 / deter;
-		return resultMat;
+		F x[C]{};
+		for (size_t i = 0; i < C; ++i)
+			x[i] = template_cast<F>(vec[i]);
+
+		Detail::LUSolve(lu.data, C, pivot, x, x);
+
+		VecTemplate<T, C> result;
+		for (size_t i = 0; i < C; ++i)
+			result[i] = Detail::FromLUValue<T>(x[i]);
+
+		return result;
+	}
+
+	//The decompositions below read mat[i] as row i, as matrixMultiplication does. They run on the stack and
+	//the loops are unrolled by the compiler for the fixed sizes up to 4x4
+
+	//lower * Transpose(lower) == mat for the symmetric positive definite mat, only its lower triangle is read.
+	//Returns false if mat is not positive definite
+	template<typename T, size_t C, size_t R>
+	constexpr bool Cholesky(const MatTemplate<T, C, R>& mat, MatTemplate<T, C, R>& lower)
+	{
+		static_assert(C == R, "the matrix must be square");
+		static_assert(DVTL::Is_floating_point_v<T>, "the decomposition requires a floating point type");
+
+		lower = mat;
+		return DVM_INSTRUMENT_CALL(Detail::CholeskyDecompose(lower.data, C));
+	}
+
+	//x such that Dot(mat[i], x) == vec[i] for the symmetric positive definite mat, a zero vector if mat is not
+	//positive definite. Half the work of Solve, the usual way to solve normal equations
+	template<typename T, size_t C, size_t R>
+	constexpr VecTemplate<T, C> CholeskySolve(const MatTemplate<T, C, R>& mat, const VecTemplate<T, C>& vec)
+	{
+		MatTemplate<T, C, R> lower;
+		if (!Cholesky(mat, lower)) return VecTemplate<T, C>();
+
+		VecTemplate<T, C> result;
+		Detail::CholeskySolve(lower.data, C, vec.data, result.data);
+		return result;
+	}
+
+	//Householder QR of the C x R matrix, matrixMultiplication(q, r) == mat with q orthogonal and r upper triangular
+	template<typename T, size_t C, size_t R>
+	constexpr void QRDecompose(const MatTemplate<T, C, R>& mat, MatTemplate<T, C, C>& q, MatTemplate<T, C, R>& r)
+	{
+		static_assert(DVTL::Is_floating_point_v<T>, "the decomposition requires a floating point type");
+
+		constexpr size_t steps = C < R ? C : R;
+		T tau[steps]{};
+
+		r = mat;
+		DVM_INSTRUMENT_CALL(Detail::QRDecompose(r.data, C, R, tau));
+		Detail::QRFormQ(r.data, C, R, tau, q.data);
+
+		//The reflectors are stored below the diagonal
+		for (size_t i = 1; i < C; ++i)
+			for (size_t j = 0; j < i && j < R; ++j)
+				r[i][j] = template_cast<T>(0);
+	}
+
+	//x minimizing the sum over rows of (Dot(mat[i], x) - vec[i])^2 through QR, without forming the normal
+	//equations. A zero vector if the columns of mat are linearly dependent
+	template<typename T, size_t C, size_t R>
+	constexpr VecTemplate<T, R> LeastSquares(const MatTemplate<T, C, R>& mat, const VecTemplate<T, C>& vec)
+	{
+		static_assert(C >= R, "the system must not be underdetermined");
+		static_assert(DVTL::Is_floating_point_v<T>, "the decomposition requires a floating point type");
+
+		MatTemplate<T, C, R> qr(mat);
+		T tau[R]{};
+		DVM_INSTRUMENT_CALL(Detail::QRDecompose(qr.data, C, R, tau));
+
+		VecTemplate<T, C> rhs(vec);
+		VecTemplate<T, R> result;
+		if (!Detail::QRSolve(qr.data, C, R, tau, rhs.data, result.data)) return VecTemplate<T, R>();
+
+		return result;
+	}
+
+	//Eigenvalues of the symmetric mat in ascending order and vectors[i], the unit eigenvector of values[i].
+	//Cyclic Jacobi rotations, returns false if they did not converge
+	template<typename T, size_t C, size_t R>
+	constexpr bool SymmetricEigen(const MatTemplate<T, C, R>& mat, VecTemplate<T, C>& values, MatTemplate<T, C, R>& vectors)
+	{
+		static_assert(C == R, "the matrix must be square");
+		static_assert(DVTL::Is_floating_point_v<T>, "the decomposition requires a floating point type");
+
+		MatTemplate<T, C, R> temp(mat);
+		return DVM_INSTRUMENT_CALL(Detail::JacobiEigen(temp.data, C, values.data, vectors.data));
 	}
 
 	template<typename T, size_t M, size_t N, size_t K>
@@ -70,6 +290,14 @@ namespace DVM
 	{
 		MatTemplate<T, M, K> result;
 
+		//Up to 4x4 the loops below are unrolled by the compiler, larger sizes go through the blocked kernel
+		if constexpr (M * N * K > 64)
+			if (!DVM_IS_CONSTANT_EVALUATED())
+			{
+				Detail::Gemm(matX.data, matY.data, result.data, M, N, K);
+				return result;
+			}
+
 		for (size_t i = 0; i < M; ++i) 
 			for (size_t j = 0; j < K; ++j) {
 				T sum = 0;
@@ -90,7 +318,7 @@ namespace DVM
 
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
-				result.data[i][j] = matX.data[i][j] * matY.data[i][j];
+				result[i][j] = matX[i][j] * matY[i][j];
 
 		return result;
 	}
@@ -102,7 +330,7 @@ namespace DVM
 
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
-				result.data[i][j] = vecC[i] * vecR[j];
+				result[i][j] = vecC[i] * vecR[j];
 
 		return result;
 	}
@@ -114,7 +342,7 @@ namespace DVM
 
 		for (size_t i = 0; i < C; ++i)
 			for (size_t j = 0; j < R; ++j)
-				result.data[j][i] = matX.data[i][j];
+				result[j][i] = matX[i][j];
 
 		return result;
 
@@ -136,6 +364,107 @@ namespace DVM
 
 		return result;
 	}
+
+	//mat applied to (vec, 1) with the last row dropped, for affine transforms
+	template<typename T>
+	constexpr VecTemplate<T, 3> TransformPoint(const MatTemplate<T, 4, 4>& mat, const VecTemplate<T, 3>& vec)
+	{
+		VecTemplate<T, 3> result;
+		for (size_t i = 0; i < 3; ++i)
+			result[i] = mat[2][i] * vec[2] + (mat[1][i] * vec[1] + (mat[0][i] * vec[0] + mat[3][i]));
+		return result;
+	}
+
+	//mat applied to (vec, 1) and divided by the resulting w, for perspective projections
+	template<typename T>
+	constexpr VecTemplate<T, 3> ProjectPoint(const MatTemplate<T, 4, 4>& mat, const VecTemplate<T, 3>& vec)
+	{
+		T w = mat[2][3] * vec[2] + (mat[1][3] * vec[1] + (mat[0][3] * vec[0] + mat[3][3]));
+
+		VecTemplate<T, 3> result = TransformPoint(mat, vec);
+		for (size_t i = 0; i < 3; ++i)
+			result[i] /= w;
+		return result;
+	}
+
+	//Rotation by angle radians around a unit length axis, applied to a vector by linearTransformation
+	template<typename T>
+	constexpr MatTemplate<T, 4, 4> Rotation(T angle, const VecTemplate<T, 3>& axis)
+	{
+		T c = Cos(angle);
+		T s = Sin(angle);
+		T t = template_cast<T>(1) - c;
+		T x = axis[0], y = axis[1], z = axis[2];
+
+		MatTemplate<T, 4, 4> result(template_cast<T>(1));
+
+		result[0][0] = c + t * x * x;
+		result[0][1] = t * x * y + s * z;
+		result[0][2] = t * x * z - s * y;
+
+		result[1][0] = t * x * y - s * z;
+		result[1][1] = c + t * y * y;
+		result[1][2] = t * y * z + s * x;
+
+		result[2][0] = t * x * z + s * y;
+		result[2][1] = t * y * z - s * x;
+		result[2][2] = c + t * z * z;
+
+		return result;
+	}
+
+#if defined(DVM_SIMD_SSE2)
+	//Row i of the product is the sum of the rows of matY weighted by matX[i]
+	constexpr MatTemplate<float, 4, 4> matrixMultiplication(const MatTemplate<float, 4, 4>& matX, const MatTemplate<float, 4, 4>& matY)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+			return matrixMultiplication<float, 4, 4, 4>(matX, matY);
+
+		MatTemplate<float, 4, 4> result;
+
+		SIMD::Float4 y0 = SIMD::Float4::Load(matY[0]);
+		SIMD::Float4 y1 = SIMD::Float4::Load(matY[1]);
+		SIMD::Float4 y2 = SIMD::Float4::Load(matY[2]);
+		SIMD::Float4 y3 = SIMD::Float4::Load(matY[3]);
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			SIMD::Float4 row = SIMD::Float4::Set(matX[i][0]) * y0;
+			row = SIMD::MulAdd(SIMD::Float4::Set(matX[i][1]), y1, row);
+			row = SIMD::MulAdd(SIMD::Float4::Set(matX[i][2]), y2, row);
+			row = SIMD::MulAdd(SIMD::Float4::Set(matX[i][3]), y3, row);
+			row.Store(result[i]);
+		}
+
+		return result;
+	}
+#endif
+
+#if defined(DVM_SIMD_AVX2)
+	constexpr MatTemplate<double, 4, 4> matrixMultiplication(const MatTemplate<double, 4, 4>& matX, const MatTemplate<double, 4, 4>& matY)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+			return matrixMultiplication<double, 4, 4, 4>(matX, matY);
+
+		MatTemplate<double, 4, 4> result;
+
+		SIMD::Double4 y0 = SIMD::Double4::Load(matY[0]);
+		SIMD::Double4 y1 = SIMD::Double4::Load(matY[1]);
+		SIMD::Double4 y2 = SIMD::Double4::Load(matY[2]);
+		SIMD::Double4 y3 = SIMD::Double4::Load(matY[3]);
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			SIMD::Double4 row = SIMD::Double4::Set(matX[i][0]) * y0;
+			row = SIMD::MulAdd(SIMD::Double4::Set(matX[i][1]), y1, row);
+			row = SIMD::MulAdd(SIMD::Double4::Set(matX[i][2]), y2, row);
+			row = SIMD::MulAdd(SIMD::Double4::Set(matX[i][3]), y3, row);
+			row.Store(result[i]);
+		}
+
+		return result;
+	}
+#endif
 }
 
 #endif // !DVM_MATRIX_MATH_H
@@ -0,0 +1,24 @@
+#ifndef DVTL_MEMORY_H
+#define DVTL_MEMORY_H
+
+#include <cstddef>
+#include <new>
+
+namespace DVTL
+{
+	constexpr size_t CacheLineSize = 64;
+
+	inline void* AlignedAlloc(size_t size, size_t alignment = CacheLineSize)
+	{
+		return ::operator new(size, std::align_val_t(alignment));
+	}
+
+	inline void AlignedFree(void* ptr, size_t alignment = CacheLineSize) noexcept
+	{
+		::operator delete(ptr, std::align_val_t(alignment));
+	}
+
+	constexpr size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+}
+
+#endif // !DVTL_MEMORY_H
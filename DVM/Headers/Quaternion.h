@@ -0,0 +1,153 @@
+#ifndef DVM_QUATERNION_H
+#define DVM_QUATERNION_H
+
+#include "Math.h"
+#include "Utility.h"
+#include "Vector.h"
+
+namespace DVM
+{
+	//x, y, z, w in a VecTemplate<T, 4>, w is the scalar part. Stored like the vector, so arrays of
+	//quaternions can be loaded with the Vec4f and Vec4d SIMD paths
+	template<typename T>
+	struct Quat
+	{
+		VecTemplate<T, 4> value;
+
+		//Identity rotation
+		constexpr Quat() : value(T{}, T{}, T{}, template_cast<T>(1)) {}
+
+		constexpr Quat(T x, T y, T z, T w) : value(x, y, z, w) {}
+
+		constexpr Quat(const VecTemplate<T, 3>& vec, T w) : value(vec[0], vec[1], vec[2], w) {}
+
+		constexpr explicit Quat(const VecTemplate<T, 4>& vec) : value(vec) {}
+
+		constexpr Quat(const Quat& right) = default;
+		constexpr Quat& operator=(const Quat& right) = default;
+		~Quat() = default;
+
+		constexpr Quat& operator*=(const Quat& right);
+		constexpr Quat& operator*=(T scalar);
+		constexpr Quat& operator/=(T scalar);
+		constexpr Quat& operator+=(const Quat& right);
+		constexpr Quat& operator-=(const Quat& right);
+
+		constexpr		T& operator[](size_t index)			{ return value[index]; }
+		constexpr const	T& operator[](size_t index) const	{ return value[index]; }
+
+		constexpr VecTemplate<T, 3> Vector() const { return VecTemplate<T, 3>(value[0], value[1], value[2]); }
+		constexpr T Scalar() const { return value[3]; }
+	};
+
+	static_assert(DVTL::Is_trivially_copyable_v<Quat<float>> && DVTL::Is_standard_layout_v<Quat<float>>, "Quat must be trivially copyable and standard layout");
+	static_assert(sizeof(Quat<float>) == 4 * sizeof(float), "Quat must not be padded");
+
+	using Quatf = Quat<float>;
+	using Quatd = Quat<double>;
+
+	//Hamilton product, rotating by the result is rotating by right and then by this.
+	//Both operands are copied first, right may be this quaternion
+	template<typename T>
+	constexpr Quat<T>& Quat<T>::operator*=(const Quat& right)
+	{
+		T x = value[0], y = value[1], z = value[2], w = value[3];
+		T rx = right[0], ry = right[1], rz = right[2], rw = right[3];
+
+		value[0] = w * rx + x * rw + y * rz - z * ry;
+		value[1] = w * ry - x * rz + y * rw + z * rx;
+		value[2] = w * rz + x * ry - y * rx + z * rw;
+		value[3] = w * rw - x * rx - y * ry - z * rz;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Quat<T>& Quat<T>::operator*=(T scalar)
+	{
+		value *= scalar;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Quat<T>& Quat<T>::operator/=(T scalar)
+	{
+		value /= scalar;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Quat<T>& Quat<T>::operator+=(const Quat& right)
+	{
+		value += right.value;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Quat<T>& Quat<T>::operator-=(const Quat& right)
+	{
+		value -= right.value;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator*(Quat<T> lhs, const Quat<T>& rhs)
+	{
+		lhs *= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator*(Quat<T> lhs, T rhs)
+	{
+		lhs *= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator*(T lhs, Quat<T> rhs)
+	{
+		rhs *= lhs;
+		return rhs;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator/(Quat<T> lhs, T rhs)
+	{
+		lhs /= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator+(Quat<T> lhs, const Quat<T>& rhs)
+	{
+		lhs += rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator-(Quat<T> lhs, const Quat<T>& rhs)
+	{
+		lhs -= rhs;
+		return lhs;
+	}
+
+	template<typename T>
+	constexpr Quat<T> operator-(Quat<T> quat)
+	{
+		quat *= template_cast<T>(-1);
+		return quat;
+	}
+
+	template<typename T>
+	constexpr bool operator==(const Quat<T>& lhs, const Quat<T>& rhs)
+	{
+		for (size_t i = 0; i < 4; ++i)
+			if (lhs[i] != rhs[i]) return false;
+		return true;
+	}
+
+	template<typename T>
+	constexpr bool operator!=(const Quat<T>& lhs, const Quat<T>& rhs) { return !(lhs == rhs); }
+}
+
+#endif // !DVM_QUATERNION_H
@@ -0,0 +1,298 @@
+#ifndef DVM_QUATERNION_MATH_H
+#define DVM_QUATERNION_MATH_H
+
+#include "Math.h"
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "SIMD.h"
+#include "Utility.h"
+#include "Vector.h"
+
+namespace DVM
+{
+	template<typename T>
+	constexpr T Dot(const Quat<T>& x, const Quat<T>& y)
+	{
+		return x[0] * y[0] + x[1] * y[1] + x[2] * y[2] + x[3] * y[3];
+	}
+
+	template<typename T>
+	constexpr T Length(const Quat<T>& quat)
+	{
+		return Sqrt(Dot(quat, quat));
+	}
+
+	//The identity for a zero length quaternion
+	template<typename T>
+	constexpr Quat<T> Normalize(const Quat<T>& quat)
+	{
+		T length = Length(quat);
+
+		if (length < getEpsilon<T>()) return Quat<T>();
+
+		return quat / length;
+	}
+
+	template<typename T>
+	constexpr Quat<T> Conjugate(const Quat<T>& quat)
+	{
+		return Quat<T>(-quat[0], -quat[1], -quat[2], quat[3]);
+	}
+
+	//Same as Conjugate for unit quaternions
+	template<typename T>
+	constexpr Quat<T> Inverse(const Quat<T>& quat)
+	{
+		return Conjugate(quat) / Dot(quat, quat);
+	}
+
+	//Rotation by angle radians around a unit length axis, the same rotation as Rotation(angle, axis) in Matrix_Math.h
+	template<typename T>
+	constexpr Quat<T> AngleAxis(T angle, const VecTemplate<T, 3>& axis)
+	{
+		T half = angle * template_cast<T>(0.5);
+		return Quat<T>(axis * Sin(half), Cos(half));
+	}
+
+	//v + w * t + u x t with t = 2 * u x v, u the vector part of a unit quaternion
+	template<typename T>
+	constexpr VecTemplate<T, 3> Rotate(const Quat<T>& quat, const VecTemplate<T, 3>& vec)
+	{
+		T ux = quat[0], uy = quat[1], uz = quat[2], w = quat[3];
+
+		T tx = template_cast<T>(2) * (uy * vec[2] - uz * vec[1]);
+		T ty = template_cast<T>(2) * (uz * vec[0] - ux * vec[2]);
+		T tz = template_cast<T>(2) * (ux * vec[1] - uy * vec[0]);
+
+		return VecTemplate<T, 3>(
+			vec[0] + w * tx + (uy * tz - uz * ty),
+			vec[1] + w * ty + (uz * tx - ux * tz),
+			vec[2] + w * tz + (ux * ty - uy * tx));
+	}
+
+	template<typename T>
+	constexpr VecTemplate<T, 3> operator*(const Quat<T>& quat, const VecTemplate<T, 3>& vec)
+	{
+		return Rotate(quat, vec);
+	}
+
+	//Rotation matrix of a unit quaternion, mat[j] is column j as in linearTransformation
+	template<typename T>
+	constexpr MatTemplate<T, 3, 3> Mat3Cast(const Quat<T>& quat)
+	{
+		T x = quat[0], y = quat[1], z = quat[2], w = quat[3];
+		T one = template_cast<T>(1);
+		T two = template_cast<T>(2);
+
+		MatTemplate<T, 3, 3> result;
+
+		result[0][0] = one - two * (y * y + z * z);
+		result[0][1] = two * (x * y + w * z);
+		result[0][2] = two * (x * z - w * y);
+
+		result[1][0] = two * (x * y - w * z);
+		result[1][1] = one - two * (x * x + z * z);
+		result[1][2] = two * (y * z + w * x);
+
+		result[2][0] = two * (x * z + w * y);
+		result[2][1] = two * (y * z - w * x);
+		result[2][2] = one - two * (x * x + y * y);
+
+		return result;
+	}
+
+	template<typename T>
+	constexpr MatTemplate<T, 4, 4> Mat4Cast(const Quat<T>& quat)
+	{
+		MatTemplate<T, 3, 3> rotation = Mat3Cast(quat);
+		MatTemplate<T, 4, 4> result(template_cast<T>(1));
+
+		for (size_t i = 0; i < 3; ++i)
+			for (size_t j = 0; j < 3; ++j)
+				result[i][j] = rotation[i][j];
+
+		return result;
+	}
+
+	//Unit quaternion of the rotation in the upper left 3x3 of mat, computed from the largest of w, x, y, z
+	//so the division stays well conditioned
+	template<typename T, size_t N>
+	constexpr Quat<T> QuatCast(const MatTemplate<T, N, N>& mat)
+	{
+		static_assert(N == 3 || N == 4, "QuatCast requires a 3x3 or 4x4 matrix");
+
+		T one = template_cast<T>(1);
+		T quarter = template_cast<T>(0.25);
+		T trace = mat[0][0] + mat[1][1] + mat[2][2];
+
+		if (trace > T{})
+		{
+			T s = Sqrt(trace + one) * template_cast<T>(2);
+			return Quat<T>((mat[1][2] - mat[2][1]) / s, (mat[2][0] - mat[0][2]) / s, (mat[0][1] - mat[1][0]) / s, quarter * s);
+		}
+		if (mat[0][0] > mat[1][1] && mat[0][0] > mat[2][2])
+		{
+			T s = Sqrt(one + mat[0][0] - mat[1][1] - mat[2][2]) * template_cast<T>(2);
+			return Quat<T>(quarter * s, (mat[1][0] + mat[0][1]) / s, (mat[2][0] + mat[0][2]) / s, (mat[1][2] - mat[2][1]) / s);
+		}
+		if (mat[1][1] > mat[2][2])
+		{
+			T s = Sqrt(one + mat[1][1] - mat[0][0] - mat[2][2]) * template_cast<T>(2);
+			return Quat<T>((mat[1][0] + mat[0][1]) / s, quarter * s, (mat[2][1] + mat[1][2]) / s, (mat[2][0] - mat[0][2]) / s);
+		}
+
+		T s = Sqrt(one + mat[2][2] - mat[0][0] - mat[1][1]) * template_cast<T>(2);
+		return Quat<T>((mat[2][0] + mat[0][2]) / s, (mat[2][1] + mat[1][2]) / s, quarter * s, (mat[0][1] - mat[1][0]) / s);
+	}
+
+	//Normalized linear interpolation along the shorter arc. Cheaper than Slerp, the speed along the arc is not constant
+	template<typename T>
+	constexpr Quat<T> Nlerp(const Quat<T>& from, const Quat<T>& to, T t)
+	{
+		T sign = Dot(from, to) < T{} ? template_cast<T>(-1) : template_cast<T>(1);
+		return Normalize(from * (template_cast<T>(1) - t) + to * (sign * t));
+	}
+
+	//Spherical linear interpolation of unit quaternions along the shorter arc
+	template<typename T>
+	constexpr Quat<T> Slerp(const Quat<T>& from, const Quat<T>& to, T t)
+	{
+		T cosTheta = Dot(from, to);
+		T sign = template_cast<T>(1);
+
+		if (cosTheta < T{})
+		{
+			cosTheta = -cosTheta;
+			sign = template_cast<T>(-1);
+		}
+
+		//sin(theta) goes to zero for close rotations, where the arc is a straight line anyway
+		if (cosTheta > template_cast<T>(1) - template_cast<T>(1e-3))
+			return Nlerp(from, to, t);
+
+		T theta = Acos(cosTheta);
+		T invSin = template_cast<T>(1) / Sin(theta);
+
+		return from * (Sin((template_cast<T>(1) - t) * theta) * invSin) + to * (sign * Sin(t * theta) * invSin);
+	}
+
+	template<typename T>
+	inline void SlerpBatch(const Quat<T>* from, const Quat<T>* to, T t, Quat<T>* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Slerp(from[i], to[i], t);
+	}
+
+	template<typename T>
+	inline void SlerpBatch(const Quat<T>* from, const Quat<T>* to, const T* t, Quat<T>* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Slerp(from[i], to[i], t[i]);
+	}
+
+	//Rotates count vectors by one unit quaternion. The quaternion is turned into a matrix once,
+	//so every vector costs 9 multiplications instead of 15. out may be the same array as in
+	template<typename T>
+	inline void RotateBatch(const Quat<T>& quat, const VecTemplate<T, 3>* in, VecTemplate<T, 3>* out, size_t count)
+	{
+		MatTemplate<T, 3, 3> mat = Mat3Cast(quat);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			VecTemplate<T, 3> vec = in[i];
+			for (size_t j = 0; j < 3; ++j)
+				out[i][j] = mat[0][j] * vec[0] + mat[1][j] * vec[1] + mat[2][j] * vec[2];
+		}
+	}
+
+	//Rotates in[i] by quat[i]
+	template<typename T>
+	inline void RotateBatch(const Quat<T>* quat, const VecTemplate<T, 3>* in, VecTemplate<T, 3>* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = Rotate(quat[i], in[i]);
+	}
+
+#if defined(DVM_SIMD_SSE2)
+	namespace Detail
+	{
+		//Four Vec3f are 12 floats, read as three registers and split into x, y and z lanes
+		inline void LoadVec3x4(const Vec3f* vec, SIMD::Float4& x, SIMD::Float4& y, SIMD::Float4& z)
+		{
+			const float* ptr = vec[0].data;
+			SIMD::Deinterleave3(_mm_loadu_ps(ptr), _mm_loadu_ps(ptr + 4), _mm_loadu_ps(ptr + 8), x.v, y.v, z.v);
+		}
+
+		inline void StoreVec3x4(Vec3f* vec, SIMD::Float4 x, SIMD::Float4 y, SIMD::Float4 z)
+		{
+			float* ptr = vec[0].data;
+			__m128 a, b, c;
+			SIMD::Interleave3(x.v, y.v, z.v, a, b, c);
+			_mm_storeu_ps(ptr, a);
+			_mm_storeu_ps(ptr + 4, b);
+			_mm_storeu_ps(ptr + 8, c);
+		}
+	}
+
+	inline void RotateBatch(const Quatf& quat, const Vec3f* in, Vec3f* out, size_t count)
+	{
+		using SIMD::Float4;
+
+		Mat3f mat = Mat3Cast(quat);
+		Float4 m[9];
+		for (size_t i = 0; i < 9; ++i)
+			m[i] = Float4::Set(mat.data[i]);
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			Float4 x, y, z;
+			Detail::LoadVec3x4(in + i, x, y, z);
+
+			Float4 rx = SIMD::MulAdd(m[6], z, SIMD::MulAdd(m[3], y, m[0] * x));
+			Float4 ry = SIMD::MulAdd(m[7], z, SIMD::MulAdd(m[4], y, m[1] * x));
+			Float4 rz = SIMD::MulAdd(m[8], z, SIMD::MulAdd(m[5], y, m[2] * x));
+
+			Detail::StoreVec3x4(out + i, rx, ry, rz);
+		}
+
+		RotateBatch<float>(quat, in + i, out + i, count - i);
+	}
+
+	inline void RotateBatch(const Quatf* quat, const Vec3f* in, Vec3f* out, size_t count)
+	{
+		using SIMD::Float4;
+
+		Float4 two = Float4::Set(2.f);
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			//Four quaternions transposed into x, y, z and w lanes
+			__m128 qx = _mm_loadu_ps(quat[i].value.data);
+			__m128 qy = _mm_loadu_ps(quat[i + 1].value.data);
+			__m128 qz = _mm_loadu_ps(quat[i + 2].value.data);
+			__m128 qw = _mm_loadu_ps(quat[i + 3].value.data);
+			_MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+			Float4 ux{ qx }, uy{ qy }, uz{ qz }, w{ qw };
+			Float4 x, y, z;
+			Detail::LoadVec3x4(in + i, x, y, z);
+
+			Float4 tx = two * (uy * z - uz * y);
+			Float4 ty = two * (uz * x - ux * z);
+			Float4 tz = two * (ux * y - uy * x);
+
+			Float4 rx = SIMD::MulAdd(w, tx, x) + (uy * tz - uz * ty);
+			Float4 ry = SIMD::MulAdd(w, ty, y) + (uz * tx - ux * tz);
+			Float4 rz = SIMD::MulAdd(w, tz, z) + (ux * ty - uy * tx);
+
+			Detail::StoreVec3x4(out + i, rx, ry, rz);
+		}
+
+		RotateBatch<float>(quat + i, in + i, out + i, count - i);
+	}
+#endif
+}
+
+#endif // !DVM_QUATERNION_MATH_H
@@ -0,0 +1,443 @@
+#ifndef DVM_SIMD_H
+#define DVM_SIMD_H
+
+//Instruction set selection. Define DVM_NO_SIMD to force the scalar fallback
+#if !defined(DVM_NO_SIMD)
+	#if defined(__AVX2__)
+		#define DVM_SIMD_AVX2
+	#endif
+
+	#if defined(__AVX__) || defined(DVM_SIMD_AVX2)
+		#define DVM_SIMD_AVX
+	#endif
+
+	#if defined(__FMA__) || (defined(_MSC_VER) && defined(DVM_SIMD_AVX2))
+		#define DVM_SIMD_FMA
+	#endif
+
+	//Half precision conversion, every AVX2 processor has it. It implies AVX
+	#if (defined(__F16C__) && defined(DVM_SIMD_AVX)) || (defined(_MSC_VER) && defined(DVM_SIMD_AVX2))
+		#define DVM_SIMD_F16C
+	#endif
+
+	#if defined(__SSE4_1__) || defined(DVM_SIMD_AVX)
+		#define DVM_SIMD_SSE41
+	#endif
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define DVM_SIMD_SSE2
+	#endif
+#endif
+
+#include <cstddef>
+
+#if defined(DVM_SIMD_SSE2)
+	#include <immintrin.h>
+#endif
+
+namespace DVM
+{
+	namespace SIMD
+	{
+#if defined(DVM_SIMD_SSE2)
+		//x, y, z into the low lanes, w = 0
+		inline __m128 Load3(const float* ptr)
+		{
+			__m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr)));
+			__m128 z = _mm_load_ss(ptr + 2);
+			return _mm_movelh_ps(xy, z);
+		}
+
+		inline void Store3(float* ptr, __m128 value)
+		{
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(ptr), _mm_castps_si128(value));
+			_mm_store_ss(ptr + 2, _mm_movehl_ps(value, value));
+		}
+
+		//Sum of all lanes broadcast to every lane
+		inline __m128 HorizontalSum(__m128 value)
+		{
+			__m128 shuf = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128 sums = _mm_add_ps(value, shuf);
+			shuf = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2));
+			return _mm_add_ps(sums, shuf);
+		}
+
+		inline __m128 Dot4(__m128 a, __m128 b) { return HorizontalSum(_mm_mul_ps(a, b)); }
+
+		//y*z' - z*y', z*x' - x*z', x*y' - y*x' with w = 0 for w = 0 inputs
+		inline __m128 Cross3(__m128 a, __m128 b)
+		{
+			__m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+			return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+
+		//Four packed x, y, z vectors in three registers to one register per component and back
+		inline void Deinterleave3(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z)
+		{
+			x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+		}
+
+		inline void Interleave3(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c)
+		{
+			a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+			b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+			c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		}
+#endif
+
+#if defined(DVM_SIMD_AVX)
+		inline __m256d HorizontalSum(__m256d value)
+		{
+			__m128d low = _mm256_castpd256_pd128(value);
+			__m128d high = _mm256_extractf128_pd(value, 1);
+			__m128d sums = _mm_add_pd(low, high);
+			sums = _mm_add_pd(sums, _mm_unpackhi_pd(sums, sums));
+			__m128d broadcast = _mm_unpacklo_pd(sums, sums);
+			return _mm256_insertf128_pd(_mm256_castpd128_pd256(broadcast), broadcast, 1);
+		}
+
+		inline __m256d Dot4(__m256d a, __m256d b) { return HorizontalSum(_mm256_mul_pd(a, b)); }
+#endif
+
+		//Lane types: one register of Width scalars with elementwise operators, so kernels can be written once
+		//as templates over the lane type. Comparisons return all-ones/all-zeros masks in the same type.
+#if defined(DVM_SIMD_SSE2)
+		//Rounding without SSE4.1. Adding and subtracting 2^(digits - 1) with the sign of a leaves no bits for
+		//the fraction, so the addition rounds to the nearest integer, ties to even. Magnitudes at or above
+		//threshold are integral already and NaN fails the comparison, both are passed through.
+		//Every result takes the sign of a, as floor, ceil and nearbyint do for zero results
+		template<typename L>
+		inline L RoundBySum(L a, L threshold)
+		{
+			L sign = a & L::Set(-0.f);
+			L magic = threshold | sign;
+			L rounded = ((a + magic) - magic) | sign;
+			return Select((a | L::Set(-0.f)) > (threshold | L::Set(-0.f)), rounded, a);
+		}
+
+		template<typename L>
+		inline L FloorFromRound(L a, L rounded) { return (rounded - ((rounded > a) & L::Set(1.f))) | (a & L::Set(-0.f)); }
+
+		template<typename L>
+		inline L CeilFromRound(L a, L rounded) { return (rounded + ((rounded < a) & L::Set(1.f))) | (a & L::Set(-0.f)); }
+
+		struct Float4
+		{
+			using Scalar = float;
+			static constexpr size_t Width = 4;
+			__m128 v;
+
+			static Float4 Load(const float* ptr) { return { _mm_loadu_ps(ptr) }; }
+			static Float4 Set(float value) { return { _mm_set1_ps(value) }; }
+			void Store(float* ptr) const { _mm_storeu_ps(ptr, v); }
+		};
+
+		inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+		inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+		inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+		inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+		inline Float4 operator&(Float4 a, Float4 b) { return { _mm_and_ps(a.v, b.v) }; }
+		inline Float4 operator|(Float4 a, Float4 b) { return { _mm_or_ps(a.v, b.v) }; }
+		inline Float4 operator<(Float4 a, Float4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+		inline Float4 operator>(Float4 a, Float4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+		inline Float4 operator<=(Float4 a, Float4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+		inline Float4 operator==(Float4 a, Float4 b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+		inline Float4 operator!=(Float4 a, Float4 b) { return { _mm_cmpneq_ps(a.v, b.v) }; }
+
+		inline Float4 Min(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+		inline Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+		inline Float4 Sqrt(Float4 a) { return { _mm_sqrt_ps(a.v) }; }
+
+		inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+		{
+#if defined(DVM_SIMD_FMA)
+			return { _mm_fmadd_ps(a.v, b.v, c.v) };
+#else
+			return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) };
+#endif
+		}
+
+		//mask ? a : b
+		inline Float4 Select(Float4 mask, Float4 a, Float4 b)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_blendv_ps(b.v, a.v, mask.v) };
+#else
+			return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+#endif
+		}
+
+		//Nearest integer, for |a| < 2^31
+		inline Float4 RoundToInt(Float4 a) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) }; }
+
+		//Nearest integer for any a, ties to even
+		inline Float4 Round(Float4 a)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+#else
+			return RoundBySum(a, Float4::Set(0x1p23f));
+#endif
+		}
+
+		inline Float4 Floor(Float4 a)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_floor_ps(a.v) };
+#else
+			return FloorFromRound(a, Round(a));
+#endif
+		}
+
+		inline Float4 Ceil(Float4 a)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_ceil_ps(a.v) };
+#else
+			return CeilFromRound(a, Round(a));
+#endif
+		}
+
+		//2^k for integral k in the normal exponent range
+		inline Float4 Pow2(Float4 k)
+		{
+			__m128i biased = _mm_add_epi32(_mm_cvtps_epi32(k.v), _mm_set1_epi32(127));
+			return { _mm_castsi128_ps(_mm_slli_epi32(biased, 23)) };
+		}
+
+		//Unbiased exponent of a positive normal value, mantissa in [1, 2)
+		inline Float4 SplitExponent(Float4 a, Float4& mantissa)
+		{
+			__m128i bits = _mm_castps_si128(a.v);
+			__m128i exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+			mantissa.v = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+			return { _mm_cvtepi32_ps(exponent) };
+		}
+
+		struct Double2
+		{
+			using Scalar = double;
+			static constexpr size_t Width = 2;
+			__m128d v;
+
+			static Double2 Load(const double* ptr) { return { _mm_loadu_pd(ptr) }; }
+			static Double2 Set(double value) { return { _mm_set1_pd(value) }; }
+			void Store(double* ptr) const { _mm_storeu_pd(ptr, v); }
+		};
+
+		inline Double2 operator+(Double2 a, Double2 b) { return { _mm_add_pd(a.v, b.v) }; }
+		inline Double2 operator-(Double2 a, Double2 b) { return { _mm_sub_pd(a.v, b.v) }; }
+		inline Double2 operator*(Double2 a, Double2 b) { return { _mm_mul_pd(a.v, b.v) }; }
+		inline Double2 operator/(Double2 a, Double2 b) { return { _mm_div_pd(a.v, b.v) }; }
+		inline Double2 operator&(Double2 a, Double2 b) { return { _mm_and_pd(a.v, b.v) }; }
+		inline Double2 operator|(Double2 a, Double2 b) { return { _mm_or_pd(a.v, b.v) }; }
+		inline Double2 operator<(Double2 a, Double2 b) { return { _mm_cmplt_pd(a.v, b.v) }; }
+		inline Double2 operator>(Double2 a, Double2 b) { return { _mm_cmpgt_pd(a.v, b.v) }; }
+		inline Double2 operator<=(Double2 a, Double2 b) { return { _mm_cmple_pd(a.v, b.v) }; }
+		inline Double2 operator==(Double2 a, Double2 b) { return { _mm_cmpeq_pd(a.v, b.v) }; }
+		inline Double2 operator!=(Double2 a, Double2 b) { return { _mm_cmpneq_pd(a.v, b.v) }; }
+
+		inline Double2 Min(Double2 a, Double2 b) { return { _mm_min_pd(a.v, b.v) }; }
+		inline Double2 Max(Double2 a, Double2 b) { return { _mm_max_pd(a.v, b.v) }; }
+		inline Double2 Sqrt(Double2 a) { return { _mm_sqrt_pd(a.v) }; }
+
+		inline Double2 MulAdd(Double2 a, Double2 b, Double2 c)
+		{
+#if defined(DVM_SIMD_FMA)
+			return { _mm_fmadd_pd(a.v, b.v, c.v) };
+#else
+			return { _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v) };
+#endif
+		}
+
+		inline Double2 Select(Double2 mask, Double2 a, Double2 b)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_blendv_pd(b.v, a.v, mask.v) };
+#else
+			return { _mm_or_pd(_mm_and_pd(mask.v, a.v), _mm_andnot_pd(mask.v, b.v)) };
+#endif
+		}
+
+		inline Double2 RoundToInt(Double2 a) { return { _mm_cvtepi32_pd(_mm_cvtpd_epi32(a.v)) }; }
+
+		inline Double2 Round(Double2 a)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+#else
+			return RoundBySum(a, Double2::Set(0x1p52));
+#endif
+		}
+
+		inline Double2 Floor(Double2 a)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_floor_pd(a.v) };
+#else
+			return FloorFromRound(a, Round(a));
+#endif
+		}
+
+		inline Double2 Ceil(Double2 a)
+		{
+#if defined(DVM_SIMD_SSE41)
+			return { _mm_ceil_pd(a.v) };
+#else
+			return CeilFromRound(a, Round(a));
+#endif
+		}
+
+		inline Double2 Pow2(Double2 k)
+		{
+			__m128i biased = _mm_add_epi32(_mm_cvtpd_epi32(k.v), _mm_set1_epi32(1023));
+			return { _mm_castsi128_pd(_mm_slli_epi64(_mm_unpacklo_epi32(biased, _mm_setzero_si128()), 52)) };
+		}
+
+		inline Double2 SplitExponent(Double2 a, Double2& mantissa)
+		{
+			__m128i bits = _mm_castpd_si128(a.v);
+			//The biased exponent lands in the low mantissa bits of 2^52, subtracting 2^52 + 1023 converts it
+			__m128i exponent = _mm_or_si128(_mm_srli_epi64(bits, 52), _mm_castpd_si128(_mm_set1_pd(0x1p52)));
+			mantissa.v = _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000FFFFFFFFFFFFFLL)), _mm_set1_epi64x(0x3FF0000000000000LL)));
+			return { _mm_sub_pd(_mm_castsi128_pd(exponent), _mm_set1_pd(0x1p52 + 1023.)) };
+		}
+#endif
+
+#if defined(DVM_SIMD_AVX2)
+		struct Float8
+		{
+			using Scalar = float;
+			static constexpr size_t Width = 8;
+			__m256 v;
+
+			static Float8 Load(const float* ptr) { return { _mm256_loadu_ps(ptr) }; }
+			static Float8 Set(float value) { return { _mm256_set1_ps(value) }; }
+			void Store(float* ptr) const { _mm256_storeu_ps(ptr, v); }
+		};
+
+		inline Float8 operator+(Float8 a, Float8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+		inline Float8 operator-(Float8 a, Float8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+		inline Float8 operator*(Float8 a, Float8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+		inline Float8 operator/(Float8 a, Float8 b) { return { _mm256_div_ps(a.v, b.v) }; }
+		inline Float8 operator&(Float8 a, Float8 b) { return { _mm256_and_ps(a.v, b.v) }; }
+		inline Float8 operator|(Float8 a, Float8 b) { return { _mm256_or_ps(a.v, b.v) }; }
+		inline Float8 operator<(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+		inline Float8 operator>(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+		inline Float8 operator<=(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+		inline Float8 operator==(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; }
+		inline Float8 operator!=(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ) }; }
+
+		inline Float8 Min(Float8 a, Float8 b) { return { _mm256_min_ps(a.v, b.v) }; }
+		inline Float8 Max(Float8 a, Float8 b) { return { _mm256_max_ps(a.v, b.v) }; }
+		inline Float8 Sqrt(Float8 a) { return { _mm256_sqrt_ps(a.v) }; }
+
+		inline Float8 MulAdd(Float8 a, Float8 b, Float8 c)
+		{
+#if defined(DVM_SIMD_FMA)
+			return { _mm256_fmadd_ps(a.v, b.v, c.v) };
+#else
+			return { _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v) };
+#endif
+		}
+
+		inline Float8 Select(Float8 mask, Float8 a, Float8 b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+		inline Float8 RoundToInt(Float8 a) { return { _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+		inline Float8 Round(Float8 a) { return RoundToInt(a); }
+		inline Float8 Floor(Float8 a) { return { _mm256_floor_ps(a.v) }; }
+		inline Float8 Ceil(Float8 a) { return { _mm256_ceil_ps(a.v) }; }
+
+		inline Float8 Pow2(Float8 k)
+		{
+			__m256i biased = _mm256_add_epi32(_mm256_cvtps_epi32(k.v), _mm256_set1_epi32(127));
+			return { _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23)) };
+		}
+
+		inline Float8 SplitExponent(Float8 a, Float8& mantissa)
+		{
+			__m256i bits = _mm256_castps_si256(a.v);
+			__m256i exponent = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+			mantissa.v = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+			return { _mm256_cvtepi32_ps(exponent) };
+		}
+
+		struct Double4
+		{
+			using Scalar = double;
+			static constexpr size_t Width = 4;
+			__m256d v;
+
+			static Double4 Load(const double* ptr) { return { _mm256_loadu_pd(ptr) }; }
+			static Double4 Set(double value) { return { _mm256_set1_pd(value) }; }
+			void Store(double* ptr) const { _mm256_storeu_pd(ptr, v); }
+		};
+
+		inline Double4 operator+(Double4 a, Double4 b) { return { _mm256_add_pd(a.v, b.v) }; }
+		inline Double4 operator-(Double4 a, Double4 b) { return { _mm256_sub_pd(a.v, b.v) }; }
+		inline Double4 operator*(Double4 a, Double4 b) { return { _mm256_mul_pd(a.v, b.v) }; }
+		inline Double4 operator/(Double4 a, Double4 b) { return { _mm256_div_pd(a.v, b.v) }; }
+		inline Double4 operator&(Double4 a, Double4 b) { return { _mm256_and_pd(a.v, b.v) }; }
+		inline Double4 operator|(Double4 a, Double4 b) { return { _mm256_or_pd(a.v, b.v) }; }
+		inline Double4 operator<(Double4 a, Double4 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ) }; }
+		inline Double4 operator>(Double4 a, Double4 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ) }; }
+		inline Double4 operator<=(Double4 a, Double4 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ) }; }
+		inline Double4 operator==(Double4 a, Double4 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ) }; }
+		inline Double4 operator!=(Double4 a, Double4 b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_NEQ_UQ) }; }
+
+		inline Double4 Min(Double4 a, Double4 b) { return { _mm256_min_pd(a.v, b.v) }; }
+		inline Double4 Max(Double4 a, Double4 b) { return { _mm256_max_pd(a.v, b.v) }; }
+		inline Double4 Sqrt(Double4 a) { return { _mm256_sqrt_pd(a.v) }; }
+
+		inline Double4 MulAdd(Double4 a, Double4 b, Double4 c)
+		{
+#if defined(DVM_SIMD_FMA)
+			return { _mm256_fmadd_pd(a.v, b.v, c.v) };
+#else
+			return { _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v) };
+#endif
+		}
+
+		inline Double4 Select(Double4 mask, Double4 a, Double4 b) { return { _mm256_blendv_pd(b.v, a.v, mask.v) }; }
+		inline Double4 RoundToInt(Double4 a) { return { _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+		inline Double4 Round(Double4 a) { return RoundToInt(a); }
+		inline Double4 Floor(Double4 a) { return { _mm256_floor_pd(a.v) }; }
+		inline Double4 Ceil(Double4 a) { return { _mm256_ceil_pd(a.v) }; }
+
+		inline Double4 Pow2(Double4 k)
+		{
+			__m128i biased = _mm_add_epi32(_mm256_cvtpd_epi32(k.v), _mm_set1_epi32(1023));
+			return { _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_cvtepi32_epi64(biased), 52)) };
+		}
+
+		inline Double4 SplitExponent(Double4 a, Double4& mantissa)
+		{
+			__m256i bits = _mm256_castpd_si256(a.v);
+			__m256i exponent = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(_mm256_set1_pd(0x1p52)));
+			mantissa.v = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)), _mm256_set1_epi64x(0x3FF0000000000000LL)));
+			return { _mm256_sub_pd(_mm256_castsi256_pd(exponent), _mm256_set1_pd(0x1p52 + 1023.)) };
+		}
+#endif
+
+		//Widest lane type available for T
+#if defined(DVM_SIMD_AVX2)
+		template<typename T> struct WideLane {};
+		template<> struct WideLane<float> { using type = Float8; };
+		template<> struct WideLane<double> { using type = Double4; };
+#elif defined(DVM_SIMD_SSE2)
+		template<typename T> struct WideLane {};
+		template<> struct WideLane<float> { using type = Float4; };
+		template<> struct WideLane<double> { using type = Double2; };
+#endif
+
+#if defined(DVM_SIMD_SSE2)
+		template<typename T> using WideLane_t = typename WideLane<T>::type;
+#endif
+	}
+}
+
+#endif // !DVM_SIMD_H
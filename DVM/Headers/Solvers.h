@@ -0,0 +1,474 @@
+#ifndef DVM_SOLVERS_H
+#define DVM_SOLVERS_H
+
+#include <cstddef>
+
+#include "Arena.h"
+#include "DynMatrix.h"
+#include "DynVector.h"
+#include "DynVector_Math.h"
+#include "Math.h"
+#include "Matrix.h"
+#include "SparseMatrix.h"
+#include "SparseMatrix_Math.h"
+#include "Utility.h"
+#include "Vector.h"
+
+//Iterative solvers for linearTransformation(mat, x) == b with mat a DynMatrix, a square MatTemplate or a
+//SparseMatrix. Every iteration costs one or two products with mat, so a sparse system of n rows solves in
+//O(iterations * NonZeros()) where Solve and Inverse are O(n^3). x is read as the starting guess and holds the
+//solution on return, the previous frame's solution is a good warm start. Work vectors come from ThreadArena(), a
+//solve into an x of the right size allocates nothing once the arena has grown
+namespace DVM
+{
+	template<typename T>
+	struct SolverOptions
+	{
+		static_assert(DVTL::Is_floating_point_v<T>, "iterative solvers need a floating point type");
+
+		//Stop once Length(b - mat * x) <= tolerance * Length(b), as tracked by the iteration's own residual
+		T tolerance = DVTL::Is_same_v<T, float> ? template_cast<T>(1e-4) : template_cast<T>(1e-8);
+		//Bound on the iterations. ConjugateGradient makes one product with mat per iteration, BiCGSTAB two, and a
+		//solve adds one each for the residual of the starting guess and of the result
+		size_t maxIterations = 1000;
+	};
+
+	template<typename T>
+	struct SolverStats
+	{
+		size_t iterations = 0;
+		//Length(b - mat * x) / Length(b) of the returned x, recomputed on return. The residual the iteration
+		//updates drifts from it by rounding, so a converged solve may end slightly above the tolerance
+		T residual = T{};
+		//The iteration's residual reached the tolerance
+		bool converged = false;
+	};
+
+	namespace Detail
+	{
+		//y = mat * x for the matrix types the solvers accept, y must not alias x
+		template<typename T>
+		inline void SolverMultiply(const DynMatrix<T>& mat, const T* x, T* y)
+		{
+			for (size_t i = 0; i < mat.Rows(); ++i)
+				y[i] = T{};
+
+			for (size_t j = 0; j < mat.Columns(); ++j)
+			{
+				const T* column = mat[j];
+				T weight = x[j];
+				for (size_t i = 0; i < mat.Rows(); ++i)
+					y[i] += column[i] * weight;
+			}
+		}
+
+		template<typename T, size_t N>
+		inline void SolverMultiply(const MatTemplate<T, N, N>& mat, const T* x, T* y)
+		{
+			for (size_t i = 0; i < N; ++i)
+			{
+				T sum = T{};
+				for (size_t j = 0; j < N; ++j)
+					sum += mat[j][i] * x[j];
+				y[i] = sum;
+			}
+		}
+
+		template<typename T, SparseLayout Layout>
+		inline void SolverMultiply(const SparseMatrix<T, Layout>& mat, const T* x, T* y)
+		{
+			SparseMultiply(mat, x, y);
+		}
+
+		template<typename T>
+		inline size_t SolverSize(const DynMatrix<T>& mat) { return mat.Rows(); }
+
+		template<typename T, size_t N>
+		inline size_t SolverSize(const MatTemplate<T, N, N>&) { return N; }
+
+		template<typename T, SparseLayout Layout>
+		inline size_t SolverSize(const SparseMatrix<T, Layout>& mat) { return mat.Rows(); }
+
+		template<typename T>
+		inline T SolverDiagonal(const DynMatrix<T>& mat, size_t i) { return mat[i][i]; }
+
+		template<typename T, size_t N>
+		inline T SolverDiagonal(const MatTemplate<T, N, N>& mat, size_t i) { return mat[i][i]; }
+
+		template<typename T, SparseLayout Layout>
+		inline T SolverDiagonal(const SparseMatrix<T, Layout>& mat, size_t i) { return mat(i, i); }
+
+		//y += alpha * x
+		template<typename T>
+		inline void Axpy(T alpha, const T* x, T* y, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+				y[i] += alpha * x[i];
+		}
+
+		//r = b - mat * x
+		template<typename T, typename Matrix>
+		inline void Residual(const Matrix& mat, const T* b, const T* x, T* r, size_t n)
+		{
+			SolverMultiply(mat, x, r);
+			for (size_t i = 0; i < n; ++i)
+				r[i] = b[i] - r[i];
+		}
+
+		template<typename T>
+		inline T Norm(const T* x, size_t n)
+		{
+			return Sqrt(DotSpan(x, x, n));
+		}
+	}
+
+	//z = r, the solvers without a preconditioner
+	struct IdentityPreconditioner
+	{
+		template<typename T>
+		void Apply(const T* r, T* z, size_t count) const
+		{
+			for (size_t i = 0; i < count; ++i)
+				z[i] = r[i];
+		}
+	};
+
+	//z = r / diagonal. Cheap to build and apply, it pays off on badly scaled rows. Zero diagonal values are left
+	//unscaled
+	template<typename T>
+	struct JacobiPreconditioner
+	{
+		template<typename Matrix>
+		explicit JacobiPreconditioner(const Matrix& mat) : inverseDiagonal(Detail::SolverSize(mat))
+		{
+			for (size_t i = 0; i < inverseDiagonal.Size(); ++i)
+			{
+				T value = Detail::SolverDiagonal(mat, i);
+				inverseDiagonal[i] = value != T{} ? 1 / value : T(1);
+			}
+		}
+
+		void Apply(const T* r, T* z, size_t count) const
+		{
+			for (size_t i = 0; i < count; ++i)
+				z[i] = r[i] * inverseDiagonal[i];
+		}
+
+	private:
+		DynVector<T> inverseDiagonal;
+	};
+
+	//Zero fill incomplete Cholesky, IC(0): L keeps the non-zeros of the lower triangle of mat and z = (L L^T)^-1 r.
+	//mat must be symmetric, only its lower triangle is read. A pivot that is not positive, possible for matrices
+	//that are not diagonally dominant, is replaced by the square root of the diagonal value and counted in
+	//Breakdowns(). Dense matrices are converted to Csr first, so the factor is only sparse when they are
+	template<typename T>
+	struct IncompleteCholesky
+	{
+		explicit IncompleteCholesky(const CsrMatrix<T>& mat) { Factorize(mat); }
+		explicit IncompleteCholesky(const CscMatrix<T>& mat) { Factorize(CsrMatrix<T>(mat)); }
+		explicit IncompleteCholesky(const DynMatrix<T>& mat) { Factorize(CsrMatrix<T>(mat)); }
+
+		template<size_t N>
+		explicit IncompleteCholesky(const MatTemplate<T, N, N>& mat) { Factorize(CsrMatrix<T>(DynMatrix<T>(mat))); }
+
+		//Forward substitution with L, then backward with L^T read by rows of L
+		void Apply(const T* r, T* z, size_t count) const
+		{
+			const size_t* starts = factor.Starts();
+			const uint32_t* indices = factor.Indices();
+			const T* values = factor.Values();
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				T sum = r[i];
+				size_t diagonal = starts[i + 1] - 1;
+				for (size_t p = starts[i]; p < diagonal; ++p)
+					sum -= values[p] * z[indices[p]];
+				z[i] = sum / values[diagonal];
+			}
+
+			for (size_t i = count; i-- > 0;)
+			{
+				size_t diagonal = starts[i + 1] - 1;
+				z[i] /= values[diagonal];
+				for (size_t p = starts[i]; p < diagonal; ++p)
+					z[indices[p]] -= values[p] * z[i];
+			}
+		}
+
+		const CsrMatrix<T>& Factor() const { return factor; }
+		size_t Breakdowns() const { return breakdowns; }
+
+	private:
+		void Factorize(const CsrMatrix<T>& mat)
+		{
+			size_t n = mat.Rows();
+
+			//Lower triangle with the diagonal as the last entry of every row, stored even where mat has none
+			size_t count = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				for (size_t p = mat.Starts()[i]; p < mat.Starts()[i + 1] && mat.Indices()[p] < i; ++p)
+					++count;
+				++count;
+			}
+
+			DynVector<size_t> starts(n + 1);
+			DynVector<uint32_t> indices(count);
+			DynVector<T> values(count);
+
+			size_t q = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				for (size_t p = mat.Starts()[i]; p < mat.Starts()[i + 1] && mat.Indices()[p] < i; ++p)
+				{
+					indices[q] = mat.Indices()[p];
+					values[q++] = mat.Values()[p];
+				}
+				indices[q] = static_cast<uint32_t>(i);
+				values[q++] = mat(i, i);
+				starts[i + 1] = q;
+			}
+
+			//Row by row: L(i, k) = (A(i, k) - row i . row k) / L(k, k), both rows restricted to columns below k and
+			//merged in index order
+			breakdowns = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				size_t diagonal = starts[i + 1] - 1;
+				for (size_t p = starts[i]; p <= diagonal; ++p)
+				{
+					size_t k = indices[p];
+					size_t kDiagonal = starts[k + 1] - 1;
+
+					T sum = values[p];
+					size_t a = starts[i];
+					size_t b = starts[k];
+					while (a < p && b < kDiagonal)
+					{
+						if (indices[a] < indices[b]) ++a;
+						else if (indices[b] < indices[a]) ++b;
+						else sum -= values[a++] * values[b++];
+					}
+
+					if (p < diagonal)
+						values[p] = sum / values[kDiagonal];
+					else if (sum > T{})
+						values[p] = Sqrt(sum);
+					else
+					{
+						T original = mat(i, i);
+						values[p] = original > T{} ? Sqrt(original) : T(1);
+						++breakdowns;
+					}
+				}
+			}
+
+			factor = CsrMatrix<T>(n, n, DVTL::Move(starts), DVTL::Move(indices), DVTL::Move(values));
+		}
+
+		CsrMatrix<T> factor;
+		size_t breakdowns = 0;
+	};
+
+	namespace Detail
+	{
+		//The solvers over n values of b and x, their vectors in the scratch arena
+		template<typename T, typename Matrix, typename Preconditioner>
+		inline SolverStats<T> ConjugateGradient(const Matrix& mat, const T* b, T* x, size_t n, const Preconditioner& preconditioner,
+			const SolverOptions<T>& options)
+		{
+			SolverStats<T> stats;
+
+			T normB = Norm(b, n);
+			if (normB == T{})
+			{
+				for (size_t i = 0; i < n; ++i)
+					x[i] = T{};
+				stats.converged = true;
+				return stats;
+			}
+
+			ArenaScope scratch;
+			T* r = scratch.Allocate<T>(n);
+			Residual(mat, b, x, r, n);
+			stats.residual = Norm(r, n) / normB;
+			if (stats.residual <= options.tolerance)
+			{
+				stats.converged = true;
+				return stats;
+			}
+
+			T* z = scratch.Allocate<T>(n);
+			T* q = scratch.Allocate<T>(n);
+			T* p = scratch.Allocate<T>(n);
+			preconditioner.Apply(r, z, n);
+			for (size_t i = 0; i < n; ++i)
+				p[i] = z[i];
+			T rz = DotSpan(r, z, n);
+
+			while (stats.iterations < options.maxIterations)
+			{
+				++stats.iterations;
+
+				SolverMultiply(mat, p, q);
+				T curvature = DotSpan(p, q, n);
+				if (!(curvature > T{})) break;
+
+				T alpha = rz / curvature;
+				Axpy(alpha, p, x, n);
+				Axpy(-alpha, q, r, n);
+
+				stats.residual = Norm(r, n) / normB;
+				if (stats.residual <= options.tolerance)
+				{
+					stats.converged = true;
+					break;
+				}
+
+				preconditioner.Apply(r, z, n);
+				T rzNext = DotSpan(r, z, n);
+				T beta = rzNext / rz;
+				rz = rzNext;
+
+				for (size_t i = 0; i < n; ++i)
+					p[i] = z[i] + beta * p[i];
+			}
+
+			Residual(mat, b, x, r, n);
+			stats.residual = Norm(r, n) / normB;
+
+			DVM_INSTRUMENT_ITERATIONS(stats.iterations);
+			return stats;
+		}
+
+		template<typename T, typename Matrix, typename Preconditioner>
+		inline SolverStats<T> BiCGSTAB(const Matrix& mat, const T* b, T* x, size_t n, const Preconditioner& preconditioner,
+			const SolverOptions<T>& options)
+		{
+			SolverStats<T> stats;
+
+			T normB = Norm(b, n);
+			if (normB == T{})
+			{
+				for (size_t i = 0; i < n; ++i)
+					x[i] = T{};
+				stats.converged = true;
+				return stats;
+			}
+
+			ArenaScope scratch;
+			T* r = scratch.Allocate<T>(n);
+			Residual(mat, b, x, r, n);
+			stats.residual = Norm(r, n) / normB;
+			if (stats.residual <= options.tolerance)
+			{
+				stats.converged = true;
+				return stats;
+			}
+
+			T* shadow = scratch.Allocate<T>(n);
+			for (size_t i = 0; i < n; ++i)
+				shadow[i] = r[i];
+
+			T* p = scratch.Allocate<T>(n, T{});
+			T* v = scratch.Allocate<T>(n, T{});
+			T* preconditioned = scratch.Allocate<T>(n);
+			T* t = scratch.Allocate<T>(n);
+			T rho = 1;
+			T alpha = 1;
+			T omega = 1;
+
+			while (stats.iterations < options.maxIterations)
+			{
+				++stats.iterations;
+
+				T rhoNext = DotSpan(shadow, r, n);
+				if (rhoNext == T{}) break;
+
+				T beta = (rhoNext / rho) * (alpha / omega);
+				rho = rhoNext;
+				for (size_t i = 0; i < n; ++i)
+					p[i] = r[i] + beta * (p[i] - omega * v[i]);
+
+				preconditioner.Apply(p, preconditioned, n);
+				SolverMultiply(mat, preconditioned, v);
+				T shadowV = DotSpan(shadow, v, n);
+				if (shadowV == T{}) break;
+
+				//r becomes s = r - alpha * v
+				alpha = rho / shadowV;
+				Axpy(alpha, preconditioned, x, n);
+				Axpy(-alpha, v, r, n);
+
+				stats.residual = Norm(r, n) / normB;
+				if (stats.residual <= options.tolerance)
+				{
+					stats.converged = true;
+					break;
+				}
+
+				preconditioner.Apply(r, preconditioned, n);
+				SolverMultiply(mat, preconditioned, t);
+				T tt = DotSpan(t, t, n);
+				if (tt == T{}) break;
+
+				omega = DotSpan(t, r, n) / tt;
+				Axpy(omega, preconditioned, x, n);
+				Axpy(-omega, t, r, n);
+
+				stats.residual = Norm(r, n) / normB;
+				if (stats.residual <= options.tolerance)
+				{
+					stats.converged = true;
+					break;
+				}
+				if (omega == T{}) break;
+			}
+
+			Residual(mat, b, x, r, n);
+			stats.residual = Norm(r, n) / normB;
+
+			DVM_INSTRUMENT_ITERATIONS(stats.iterations);
+			return stats;
+		}
+	}
+
+	//Preconditioned conjugate gradient, mat must be symmetric positive definite. Stops early, not converged,
+	//if a search direction has no positive curvature. x starts at zero unless it already has b.Size() values
+	template<typename T, typename Matrix, typename Preconditioner = IdentityPreconditioner>
+	inline SolverStats<T> ConjugateGradient(const Matrix& mat, const DynVector<T>& b, DynVector<T>& x,
+		const Preconditioner& preconditioner = Preconditioner(), const SolverOptions<T>& options = SolverOptions<T>())
+	{
+		if (x.Size() != b.Size()) x = DynVector<T>(b.Size());
+		return DVM_INSTRUMENT_CALL(Detail::ConjugateGradient(mat, b.Data(), x.Data(), b.Size(), preconditioner, options));
+	}
+
+	//Right preconditioned BiCGSTAB for general square matrices. Every iteration costs two products with mat and two
+	//preconditioner applications. Stops early, not converged, on a breakdown (rho or omega reaching zero)
+	template<typename T, typename Matrix, typename Preconditioner = IdentityPreconditioner>
+	inline SolverStats<T> BiCGSTAB(const Matrix& mat, const DynVector<T>& b, DynVector<T>& x,
+		const Preconditioner& preconditioner = Preconditioner(), const SolverOptions<T>& options = SolverOptions<T>())
+	{
+		if (x.Size() != b.Size()) x = DynVector<T>(b.Size());
+		return DVM_INSTRUMENT_CALL(Detail::BiCGSTAB(mat, b.Data(), x.Data(), b.Size(), preconditioner, options));
+	}
+
+	//VecTemplate versions for MatTemplate systems, x is the starting guess
+	template<typename T, size_t N, typename Preconditioner = IdentityPreconditioner>
+	inline SolverStats<T> ConjugateGradient(const MatTemplate<T, N, N>& mat, const VecTemplate<T, N>& b, VecTemplate<T, N>& x,
+		const Preconditioner& preconditioner = Preconditioner(), const SolverOptions<T>& options = SolverOptions<T>())
+	{
+		return DVM_INSTRUMENT_CALL(Detail::ConjugateGradient(mat, b.data, x.data, N, preconditioner, options));
+	}
+
+	template<typename T, size_t N, typename Preconditioner = IdentityPreconditioner>
+	inline SolverStats<T> BiCGSTAB(const MatTemplate<T, N, N>& mat, const VecTemplate<T, N>& b, VecTemplate<T, N>& x,
+		const Preconditioner& preconditioner = Preconditioner(), const SolverOptions<T>& options = SolverOptions<T>())
+	{
+		return DVM_INSTRUMENT_CALL(Detail::BiCGSTAB(mat, b.data, x.data, N, preconditioner, options));
+	}
+}
+
+#endif // !DVM_SOLVERS_H
@@ -0,0 +1,223 @@
+#ifndef DVM_SPARSEMATRIX_H
+#define DVM_SPARSEMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Arena.h"
+#include "DynMatrix.h"
+#include "DynVector.h"
+#include "Utility.h"
+
+namespace DVM
+{
+	//Non-zero value at (row, column), the input of SparseMatrix::FromTriplets
+	template<typename T>
+	struct Triplet
+	{
+		size_t row;
+		size_t column;
+		T value;
+	};
+
+	//Csr compresses the rows of a matrix, Csc its columns
+	enum class SparseLayout { Csr, Csc };
+
+	namespace Detail
+	{
+		//Buckets the entries of a compressed structure by their index. The entries of major i are
+		//indices[starts[i]]..indices[starts[i + 1] - 1], the result is the same matrix compressed along the other
+		//dimension. Majors are scanned in order, so every output bucket comes out sorted
+		template<typename T>
+		inline void TransposeCompressed(size_t majorCount, size_t minorCount, const size_t* starts, const uint32_t* indices, const T* values,
+			size_t* outStarts, uint32_t* outIndices, T* outValues)
+		{
+			for (size_t i = 0; i <= minorCount; ++i)
+				outStarts[i] = 0;
+			for (size_t p = 0; p < starts[majorCount]; ++p)
+				++outStarts[indices[p] + 1];
+			for (size_t i = 0; i < minorCount; ++i)
+				outStarts[i + 1] += outStarts[i];
+
+			ArenaScope scratch;
+			size_t* next = scratch.Allocate<size_t>(minorCount);
+			for (size_t i = 0; i < minorCount; ++i)
+				next[i] = outStarts[i];
+
+			for (size_t i = 0; i < majorCount; ++i)
+				for (size_t p = starts[i]; p < starts[i + 1]; ++p)
+				{
+					size_t q = next[indices[p]]++;
+					outIndices[q] = static_cast<uint32_t>(i);
+					outValues[q] = values[p];
+				}
+		}
+	}
+
+	//Compressed sparse matrix of Rows() x Columns(). The entries of row i (column i for Csc) are
+	//Indices()[Starts()[i]]..Indices()[Starts()[i + 1] - 1], holding their column (row) in ascending order, with the
+	//values at the same positions of Values(). Indices are 32 bit, which halves their memory traffic in SpMV
+	template<typename T, SparseLayout Layout>
+	struct SparseMatrix
+	{
+		SparseMatrix() : SparseMatrix(0, 0) {}
+
+		//Matrix without non-zeros
+		SparseMatrix(size_t rows, size_t columns) : rows(rows), columns(columns), starts(MajorCount(rows, columns) + 1) {}
+
+		//Takes compressed arrays as described above, starts has MajorCount + 1 values
+		SparseMatrix(size_t rows, size_t columns, DynVector<size_t> starts, DynVector<uint32_t> indices, DynVector<T> values)
+			: rows(rows), columns(columns), starts(DVTL::Move(starts)), indices(DVTL::Move(indices)), values(DVTL::Move(values)) {}
+
+		//Non-zeros of a dense matrix read as linearTransformation does, dense[j][i] is (i, j)
+		explicit SparseMatrix(const DynMatrix<T>& dense) : SparseMatrix(dense.Rows(), dense.Columns())
+		{
+			size_t count = 0;
+			for (size_t i = 0; i < dense.Size(); ++i)
+				count += dense.Data()[i] != T{};
+
+			indices = DynVector<uint32_t>(count);
+			values = DynVector<T>(count);
+
+			size_t p = 0;
+			for (size_t i = 0; i < MajorCount(); ++i)
+			{
+				for (size_t j = 0; j < MinorCount(); ++j)
+				{
+					T value = Layout == SparseLayout::Csr ? dense[j][i] : dense[i][j];
+					if (value == T{}) continue;
+
+					indices[p] = static_cast<uint32_t>(j);
+					values[p++] = value;
+				}
+				starts[i + 1] = p;
+			}
+		}
+
+		//The same matrix in the other layout, one counting sort pass. The copy constructor takes the same layout
+		template<SparseLayout Other>
+		explicit SparseMatrix(const SparseMatrix<T, Other>& other) : SparseMatrix(other.Rows(), other.Columns())
+		{
+			indices = DynVector<uint32_t>(other.NonZeros());
+			values = DynVector<T>(other.NonZeros());
+			Detail::TransposeCompressed(MinorCount(), MajorCount(), other.Starts(), other.Indices(), other.Values(),
+				starts.Data(), indices.Data(), values.Data());
+		}
+
+		//Duplicate positions are summed, as finite element assembly expects. Every triplet must lie inside the matrix.
+		//O(count + rows + columns), no comparison sort
+		static SparseMatrix FromTriplets(size_t rows, size_t columns, const Triplet<T>* triplets, size_t count)
+		{
+			//Bucket by minor index first in the scratch arena, the transpose pass then sorts every major segment by index
+			size_t majorTotal = MajorCount(rows, columns);
+			size_t minorTotal = MajorCount(columns, rows);
+
+			ArenaScope scratch;
+			size_t* minorStarts = scratch.Allocate<size_t>(minorTotal + 1, 0);
+			uint32_t* minorIndices = scratch.Allocate<uint32_t>(count);
+			T* minorValues = scratch.Allocate<T>(count);
+
+			for (size_t t = 0; t < count; ++t)
+				++minorStarts[MinorOf(triplets[t]) + 1];
+			for (size_t i = 0; i < minorTotal; ++i)
+				minorStarts[i + 1] += minorStarts[i];
+
+			size_t* next = scratch.Allocate<size_t>(minorTotal);
+			for (size_t i = 0; i < minorTotal; ++i)
+				next[i] = minorStarts[i];
+
+			for (size_t t = 0; t < count; ++t)
+			{
+				size_t q = next[MinorOf(triplets[t])]++;
+				minorIndices[q] = static_cast<uint32_t>(MajorOf(triplets[t]));
+				minorValues[q] = triplets[t].value;
+			}
+
+			SparseMatrix result(rows, columns);
+			result.indices = DynVector<uint32_t>(count);
+			result.values = DynVector<T>(count);
+			Detail::TransposeCompressed(minorTotal, majorTotal, minorStarts, minorIndices, minorValues,
+				result.starts.Data(), result.indices.Data(), result.values.Data());
+
+			//Duplicates are now adjacent, merge them in place
+			size_t write = 0;
+			size_t read = 0;
+			for (size_t i = 0; i < majorTotal; ++i)
+			{
+				size_t end = result.starts[i + 1];
+				result.starts[i] = write;
+
+				for (; read < end; ++read)
+				{
+					if (write > result.starts[i] && result.indices[write - 1] == result.indices[read])
+						result.values[write - 1] += result.values[read];
+					else
+					{
+						result.indices[write] = result.indices[read];
+						result.values[write++] = result.values[read];
+					}
+				}
+			}
+			result.starts[majorTotal] = write;
+
+			result.indices.Resize(write);
+			result.values.Resize(write);
+			return result;
+		}
+
+		size_t Rows() const { return rows; }
+		size_t Columns() const { return columns; }
+		size_t NonZeros() const { return values.Size(); }
+
+		//Rows for Csr, columns for Csc
+		size_t MajorCount() const { return MajorCount(rows, columns); }
+		size_t MinorCount() const { return MajorCount(columns, rows); }
+
+		const size_t* Starts() const { return starts.Data(); }
+		const uint32_t* Indices() const { return indices.Data(); }
+
+		inline			T* Values()			{ return values.Data(); }
+		inline const	T* Values() const	{ return values.Data(); }
+
+		//Value at (row, column), zero where nothing is stored. A binary search over the segment
+		T operator()(size_t row, size_t column) const
+		{
+			size_t major = Layout == SparseLayout::Csr ? row : column;
+			uint32_t minor = static_cast<uint32_t>(Layout == SparseLayout::Csr ? column : row);
+
+			size_t first = starts[major];
+			size_t last = starts[major + 1];
+			while (first < last)
+			{
+				size_t middle = first + (last - first) / 2;
+				if (indices[middle] < minor)
+					first = middle + 1;
+				else
+					last = middle;
+			}
+
+			return first < starts[major + 1] && indices[first] == minor ? values[first] : T{};
+		}
+
+	private:
+		static size_t MajorCount(size_t rowCount, size_t columnCount) { return Layout == SparseLayout::Csr ? rowCount : columnCount; }
+		static size_t MajorOf(const Triplet<T>& triplet) { return Layout == SparseLayout::Csr ? triplet.row : triplet.column; }
+		static size_t MinorOf(const Triplet<T>& triplet) { return Layout == SparseLayout::Csr ? triplet.column : triplet.row; }
+
+		size_t rows;
+		size_t columns;
+		DynVector<size_t> starts;
+		DynVector<uint32_t> indices;
+		DynVector<T> values;
+	};
+
+	template<typename T> using CsrMatrix = SparseMatrix<T, SparseLayout::Csr>;
+	template<typename T> using CscMatrix = SparseMatrix<T, SparseLayout::Csc>;
+
+	using CsrMatrixf = CsrMatrix<float>;
+	using CsrMatrixd = CsrMatrix<double>;
+	using CscMatrixf = CscMatrix<float>;
+	using CscMatrixd = CscMatrix<double>;
+}
+
+#endif // !DVM_SPARSEMATRIX_H
@@ -0,0 +1,123 @@
+#ifndef DVM_SPARSEMATRIX_MATH_H
+#define DVM_SPARSEMATRIX_MATH_H
+
+#include "DynMatrix.h"
+#include "DynVector.h"
+#include "Matrix.h"
+#include "SparseMatrix.h"
+#include "Utility.h"
+#include "Vector.h"
+
+//Products of SparseMatrix with the dense types. Dense matrices are read as linearTransformation reads them,
+//dense[j] is column j, so linearTransformation(ToDense(mat), vec) == linearTransformation(mat, vec)
+namespace DVM
+{
+	namespace Detail
+	{
+		//y[i] = row i of the Csr matrix times x for the rows [first, last)
+		template<typename T>
+		inline void CsrMultiplyRows(const size_t* starts, const uint32_t* indices, const T* values, const T* x, T* y, size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; ++i)
+			{
+				T sum = T{};
+				for (size_t p = starts[i]; p < starts[i + 1]; ++p)
+					sum += values[p] * x[indices[p]];
+				y[i] = sum;
+			}
+		}
+
+		//y = mat * x, x has Columns() values and y Rows(). Csr gathers one row at a time, Csc scatters its columns
+		template<typename T, SparseLayout Layout>
+		inline void SparseMultiply(const SparseMatrix<T, Layout>& mat, const T* x, T* y)
+		{
+			if constexpr (Layout == SparseLayout::Csr)
+				CsrMultiplyRows(mat.Starts(), mat.Indices(), mat.Values(), x, y, 0, mat.Rows());
+			else
+			{
+				for (size_t i = 0; i < mat.Rows(); ++i)
+					y[i] = T{};
+
+				for (size_t j = 0; j < mat.Columns(); ++j)
+				{
+					T weight = x[j];
+					for (size_t p = mat.Starts()[j]; p < mat.Starts()[j + 1]; ++p)
+						y[mat.Indices()[p]] += mat.Values()[p] * weight;
+				}
+			}
+		}
+	}
+
+	//mat * vec, vec has Columns() values and the result Rows()
+	template<typename T, SparseLayout Layout>
+	inline DynVector<T> linearTransformation(const SparseMatrix<T, Layout>& mat, const DynVector<T>& vec)
+	{
+		DynVector<T> result(mat.Rows());
+		Detail::SparseMultiply(mat, vec.Data(), result.Data());
+		return result;
+	}
+
+	//N must equal Columns()
+	template<typename T, SparseLayout Layout, size_t N>
+	inline DynVector<T> linearTransformation(const SparseMatrix<T, Layout>& mat, const VecTemplate<T, N>& vec)
+	{
+		DynVector<T> result(mat.Rows());
+		Detail::SparseMultiply(mat, vec.data, result.Data());
+		return result;
+	}
+
+	//mat * dense, column j of the result is linearTransformation(mat, dense[j]). dense.Rows() must equal Columns()
+	template<typename T, SparseLayout Layout>
+	inline DynMatrix<T> matrixMultiplication(const SparseMatrix<T, Layout>& mat, const DynMatrix<T>& dense)
+	{
+		DynMatrix<T> result(dense.Columns(), mat.Rows());
+		for (size_t j = 0; j < dense.Columns(); ++j)
+			Detail::SparseMultiply(mat, dense[j], result[j]);
+		return result;
+	}
+
+	//R must equal Columns(), the result has C columns of Rows() values
+	template<typename T, SparseLayout Layout, size_t C, size_t R>
+	inline DynMatrix<T> matrixMultiplication(const SparseMatrix<T, Layout>& mat, const MatTemplate<T, C, R>& dense)
+	{
+		DynMatrix<T> result(C, mat.Rows());
+		for (size_t j = 0; j < C; ++j)
+			Detail::SparseMultiply(mat, dense[j], result[j]);
+		return result;
+	}
+
+	//Same layout, rows and columns exchanged. The compressed arrays of a Csr matrix read as Csc are its transpose,
+	//so this is the layout conversion with the dimensions swapped
+	template<typename T, SparseLayout Layout>
+	inline SparseMatrix<T, Layout> Transpose(const SparseMatrix<T, Layout>& mat)
+	{
+		DynVector<size_t> starts(mat.MinorCount() + 1);
+		DynVector<uint32_t> indices(mat.NonZeros());
+		DynVector<T> values(mat.NonZeros());
+		Detail::TransposeCompressed(mat.MajorCount(), mat.MinorCount(), mat.Starts(), mat.Indices(), mat.Values(),
+			starts.Data(), indices.Data(), values.Data());
+
+		return SparseMatrix<T, Layout>(mat.Columns(), mat.Rows(), DVTL::Move(starts), DVTL::Move(indices), DVTL::Move(values));
+	}
+
+	//Dense copy with dense[j][i] = mat(i, j), Rows() * Columns() values
+	template<typename T, SparseLayout Layout>
+	inline DynMatrix<T> ToDense(const SparseMatrix<T, Layout>& mat)
+	{
+		DynMatrix<T> result(mat.Columns(), mat.Rows());
+
+		for (size_t i = 0; i < mat.MajorCount(); ++i)
+			for (size_t p = mat.Starts()[i]; p < mat.Starts()[i + 1]; ++p)
+			{
+				size_t minor = mat.Indices()[p];
+				if constexpr (Layout == SparseLayout::Csr)
+					result[minor][i] = mat.Values()[p];
+				else
+					result[i][minor] = mat.Values()[p];
+			}
+
+		return result;
+	}
+}
+
+#endif // !DVM_SPARSEMATRIX_MATH_H
@@ -0,0 +1,47 @@
+#ifndef DVM_SPARSEMATRIX_PARALLEL_H
+#define DVM_SPARSEMATRIX_PARALLEL_H
+
+#include "DynMatrix.h"
+#include "DynMatrix_Parallel.h"
+#include "DynVector.h"
+#include "SparseMatrix.h"
+#include "SparseMatrix_Math.h"
+#include "ThreadPool.h"
+
+//SparseMatrix_Math.h products split over a ThreadPool by rows of a Csr matrix. Every row is summed by one thread
+//in the serial order, so results match the serial versions bit for bit. Csc matrices scatter every column into
+//shared rows and have no parallel version, convert them with CsrMatrix<T>(csc) first
+namespace DVM
+{
+	template<typename T>
+	inline DynVector<T> linearTransformation(ThreadPool& pool, const CsrMatrix<T>& mat, const DynVector<T>& vec)
+	{
+		if (mat.NonZeros() < Detail::ParallelMinWork) return linearTransformation(mat, vec);
+
+		DynVector<T> result(mat.Rows());
+		pool.ParallelFor(0, mat.Rows(), 1024, [&](size_t first, size_t last)
+		{
+			Detail::CsrMultiplyRows(mat.Starts(), mat.Indices(), mat.Values(), vec.Data(), result.Data(), first, last);
+		});
+
+		return result;
+	}
+
+	//Parts own a range of rows in every column of the result
+	template<typename T>
+	inline DynMatrix<T> matrixMultiplication(ThreadPool& pool, const CsrMatrix<T>& mat, const DynMatrix<T>& dense)
+	{
+		if (mat.NonZeros() * dense.Columns() < Detail::ParallelMinWork) return matrixMultiplication(mat, dense);
+
+		DynMatrix<T> result(dense.Columns(), mat.Rows());
+		pool.ParallelFor(0, mat.Rows(), 1024, [&](size_t first, size_t last)
+		{
+			for (size_t j = 0; j < dense.Columns(); ++j)
+				Detail::CsrMultiplyRows(mat.Starts(), mat.Indices(), mat.Values(), dense[j], result[j], first, last);
+		});
+
+		return result;
+	}
+}
+
+#endif // !DVM_SPARSEMATRIX_PARALLEL_H
@@ -0,0 +1,229 @@
+#ifndef DVM_THREADPOOL_H
+#define DVM_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Utility.h"
+
+namespace DVM
+{
+	//Work stealing pool. Every thread owns a queue, idle threads steal from the front of the others.
+	//The thread calling ParallelFor works on its own tasks until the whole range is done.
+	//In deterministic mode a range is cut into ThreadCount() fixed parts, part t always runs on the t-th thread
+	//after the caller and nothing is stolen, so per-thread partial results do not depend on scheduling.
+	class ThreadPool
+	{
+	public:
+		using RangeFunction = std::function<void(size_t, size_t)>;
+
+		//threadCount includes the calling thread, 0 uses every hardware thread
+		explicit ThreadPool(size_t threadCount = 0)
+		{
+			if (threadCount == 0)
+				threadCount = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+			queues.reset(new Queue[threadCount]);
+			queueCount = threadCount;
+
+			for (size_t i = 1; i < threadCount; ++i)
+				workers.emplace_back([this, i] { WorkerLoop(i); });
+		}
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex);
+				stop = true;
+			}
+			sleepCondition.notify_all();
+
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		size_t ThreadCount() const { return queueCount; }
+
+		void SetDeterministic(bool value) { deterministic = value; }
+		bool Deterministic() const { return deterministic; }
+
+		//Calls function(first, last) on disjoint sub-ranges covering [begin, end), parts have at least grain
+		//elements where possible. Returns when every part has finished. function must not throw
+		template<typename F>
+		void ParallelFor(size_t begin, size_t end, size_t grain, F&& function)
+		{
+			if (end <= begin) return;
+
+			size_t count = end - begin;
+			grain = grain ? grain : 1;
+
+			if (queueCount == 1 || count <= grain)
+			{
+				function(begin, end);
+				return;
+			}
+
+			RangeFunction range(DVTL::Forward<F>(function));
+			Batch batch;
+			bool fixed = deterministic;
+
+			//A few parts per thread leave room for stealing, fixed mode uses exactly one part per thread
+			size_t parts = fixed ? queueCount : queueCount * 4;
+			size_t maxParts = (count + grain - 1) / grain;
+			parts = parts < maxParts ? parts : maxParts;
+			batch.remaining = parts;
+
+			size_t self = CurrentIndex();
+			for (size_t part = 0; part < parts; ++part)
+			{
+				size_t first = begin + count * part / parts;
+				size_t last = begin + count * (part + 1) / parts;
+				size_t queue = (self + part) % queueCount;
+
+				std::lock_guard<std::mutex> lock(queues[queue].mutex);
+				queues[queue].tasks.push_back({ &range, first, last, &batch });
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex);
+				++epoch;
+			}
+			sleepCondition.notify_all();
+
+			//Fixed parts of other threads are never taken here, only this thread's own part
+			while (batch.remaining.load(std::memory_order_acquire) != 0)
+			{
+				Task task;
+				if (PopOwn(self, task) || (!fixed && Steal(self, task)))
+					Run(task);
+				else
+					std::this_thread::yield();
+			}
+		}
+
+	private:
+		struct Batch
+		{
+			std::atomic<size_t> remaining{ 0 };
+		};
+
+		struct Task
+		{
+			const RangeFunction* function;
+			size_t first;
+			size_t last;
+			Batch* batch;
+		};
+
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		//Workers know their queue, any other thread uses queue 0
+		size_t CurrentIndex() const
+		{
+			return CurrentOwner() == this ? CurrentWorker() : 0;
+		}
+
+		static const ThreadPool*& CurrentOwner() { static thread_local const ThreadPool* owner = nullptr; return owner; }
+		static size_t& CurrentWorker() { static thread_local size_t index = 0; return index; }
+
+		bool PopOwn(size_t index, Task& task)
+		{
+			std::lock_guard<std::mutex> lock(queues[index].mutex);
+			if (queues[index].tasks.empty()) return false;
+
+			task = queues[index].tasks.back();
+			queues[index].tasks.pop_back();
+			return true;
+		}
+
+		bool Steal(size_t index, Task& task)
+		{
+			for (size_t offset = 1; offset < queueCount; ++offset)
+			{
+				Queue& victim = queues[(index + offset) % queueCount];
+
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				if (victim.tasks.empty()) continue;
+
+				task = victim.tasks.front();
+				victim.tasks.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		static void Run(const Task& task)
+		{
+			(*task.function)(task.first, task.last);
+			task.batch->remaining.fetch_sub(1, std::memory_order_release);
+		}
+
+		void WorkerLoop(size_t index)
+		{
+			CurrentOwner() = this;
+			CurrentWorker() = index;
+
+			while (true)
+			{
+				size_t seen;
+				{
+					std::lock_guard<std::mutex> lock(sleepMutex);
+					if (stop) return;
+					seen = epoch;
+				}
+
+				Task task;
+				if (PopOwn(index, task) || (!deterministic && Steal(index, task)))
+				{
+					Run(task);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				sleepCondition.wait(lock, [&] { return stop || epoch != seen; });
+			}
+		}
+
+		std::unique_ptr<Queue[]> queues;
+		size_t queueCount = 0;
+		std::vector<std::thread> workers;
+
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+		size_t epoch = 0;
+		bool stop = false;
+		std::atomic<bool> deterministic{ false };
+	};
+
+	//Pool used by the parallel functions when none is passed
+	inline std::unique_ptr<ThreadPool>& DefaultThreadPoolStorage()
+	{
+		static std::unique_ptr<ThreadPool> pool(new ThreadPool());
+		return pool;
+	}
+
+	inline ThreadPool& DefaultThreadPool() { return *DefaultThreadPoolStorage(); }
+
+	//Replaces the default pool, must not be called while it is running work. 0 uses every hardware thread
+	inline void SetThreadCount(size_t threadCount)
+	{
+		bool deterministic = DefaultThreadPool().Deterministic();
+		DefaultThreadPoolStorage().reset(new ThreadPool(threadCount));
+		DefaultThreadPool().SetDeterministic(deterministic);
+	}
+}
+
+#endif // !DVM_THREADPOOL_H
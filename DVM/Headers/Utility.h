@@ -30,6 +30,32 @@ namespace DVTL
 
 	template <bool B, typename T = void>
 	using Enable_if_t = typename Enable_if<B, T>::type;
+
+	template <bool B, typename T, typename F>
+	struct Conditional { using type = T; };
+
+	template <typename T, typename F>
+	struct Conditional<false, T, F> { using type = F; };
+
+	template <bool B, typename T, typename F>
+	using Conditional_t = typename Conditional<B, T, F>::type;
+
+	template<typename T, typename U> constexpr bool Is_same_v = false;
+	template<typename T> constexpr bool Is_same_v<T, T> = true;
+
+	template<typename T> constexpr bool Is_floating_point_v = Is_same_v<T, float> || Is_same_v<T, double> || Is_same_v<T, long double>;
+
+	template<typename T> constexpr bool Is_integral_v =
+		Is_same_v<T, bool> || Is_same_v<T, char> || Is_same_v<T, signed char> || Is_same_v<T, unsigned char> ||
+		Is_same_v<T, wchar_t> || Is_same_v<T, char16_t> || Is_same_v<T, char32_t> ||
+		Is_same_v<T, short> || Is_same_v<T, unsigned short> || Is_same_v<T, int> || Is_same_v<T, unsigned int> ||
+		Is_same_v<T, long> || Is_same_v<T, unsigned long> || Is_same_v<T, long long> || Is_same_v<T, unsigned long long>;
+
+	template<typename T> constexpr bool Is_arithmetic_v = Is_integral_v<T> || Is_floating_point_v<T>;
+
+	//Compiler intrinsics, supported by MSVC, GCC and Clang
+	template<typename T> constexpr bool Is_trivially_copyable_v = __is_trivially_copyable(T);
+	template<typename T> constexpr bool Is_standard_layout_v = __is_standard_layout(T);
 }
 
 #endif // !DVTL_UTILITY_H
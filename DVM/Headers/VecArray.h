@@ -0,0 +1,181 @@
+#ifndef DVM_VECARRAY_H
+#define DVM_VECARRAY_H
+
+#include <cstring>
+
+#include "Memory.h"
+#include "Utility.h"
+#include "Vector.h"
+
+namespace DVM
+{
+	//Structure of arrays: component c of every vector is stored contiguously in Stream(c).
+	//Every stream starts on a cache line and is padded with zeros to a whole number of cache lines,
+	//so bulk kernels may run over PaddedSize() elements without a scalar tail.
+	template<typename T, size_t N>
+	struct VecArray
+	{
+		static_assert(N != 0, "N must not be zero");
+
+		static constexpr size_t Lanes = DVTL::CacheLineSize / sizeof(T) ? DVTL::CacheLineSize / sizeof(T) : 1;
+
+		VecArray() : streams{}, size(0), capacity(0) {}
+
+		explicit VecArray(size_t count) : VecArray() { Resize(count); }
+
+		VecArray(const VecTemplate<T, N>* values, size_t count) : VecArray() { Load(values, count); }
+
+		VecArray(const VecArray& right) : VecArray()
+		{
+			Allocate(right.capacity);
+			size = right.size;
+			if (capacity)
+				std::memcpy(streams[0], right.streams[0], N * capacity * sizeof(T));
+		}
+
+		VecArray(VecArray&& right) noexcept : VecArray() { Swap(right); }
+
+		VecArray& operator=(const VecArray& right)
+		{
+			if (this != &right)
+			{
+				VecArray temp(right);
+				Swap(temp);
+			}
+			return *this;
+		}
+
+		VecArray& operator=(VecArray&& right) noexcept
+		{
+			if (this != &right)
+			{
+				VecArray temp(DVTL::Move(right));
+				Swap(temp);
+			}
+			return *this;
+		}
+
+		~VecArray()
+		{
+			if (streams[0])
+				DVTL::AlignedFree(streams[0]);
+		}
+
+		void Swap(VecArray& right) noexcept
+		{
+			for (size_t c = 0; c < N; ++c)
+			{
+				T* stream = streams[c];
+				streams[c] = right.streams[c];
+				right.streams[c] = stream;
+			}
+
+			size_t temp = size; size = right.size; right.size = temp;
+			temp = capacity; capacity = right.capacity; right.capacity = temp;
+		}
+
+		//New elements are zero
+		void Resize(size_t count)
+		{
+			//Storage past size is always zero, only a shrink has values to clear
+			if (count > capacity)
+				Reserve(count);
+			else
+				for (size_t c = 0; c < N; ++c)
+					for (size_t i = count; i < size; ++i)
+						streams[c][i] = T{};
+
+			size = count;
+		}
+
+		void Reserve(size_t count)
+		{
+			if (count <= capacity) return;
+
+			VecArray temp;
+			temp.Allocate(count);
+			temp.size = size;
+
+			for (size_t c = 0; c < N; ++c)
+				if (size)
+					std::memcpy(temp.streams[c], streams[c], size * sizeof(T));
+
+			Swap(temp);
+		}
+
+		//Gathers an array of structures into the streams
+		void Load(const VecTemplate<T, N>* values, size_t count)
+		{
+			Resize(count);
+
+			for (size_t i = 0; i < count; ++i)
+				for (size_t c = 0; c < N; ++c)
+					streams[c][i] = values[i][c];
+		}
+
+		//Scatters the streams back into an array of structures of Size() elements
+		void Store(VecTemplate<T, N>* values) const
+		{
+			for (size_t i = 0; i < size; ++i)
+				for (size_t c = 0; c < N; ++c)
+					values[i][c] = streams[c][i];
+		}
+
+		VecTemplate<T, N> Get(size_t index) const
+		{
+			VecTemplate<T, N> result;
+			for (size_t c = 0; c < N; ++c)
+				result[c] = streams[c][index];
+			return result;
+		}
+
+		void Set(size_t index, const VecTemplate<T, N>& value)
+		{
+			for (size_t c = 0; c < N; ++c)
+				streams[c][index] = value[c];
+		}
+
+		size_t Size() const { return size; }
+		size_t Capacity() const { return capacity; }
+		size_t PaddedSize() const { return DVTL::AlignUp(size, Lanes); }
+
+		inline			T* Stream(size_t component)			{ return streams[component]; }
+		inline const	T* Stream(size_t component) const	{ return streams[component]; }
+
+		inline			T* X()			{ return streams[0]; }
+		inline const	T* X() const	{ return streams[0]; }
+		inline			T* Y()			{ static_assert(N > 1, "Y requires N > 1"); return streams[1]; }
+		inline const	T* Y() const	{ static_assert(N > 1, "Y requires N > 1"); return streams[1]; }
+		inline			T* Z()			{ static_assert(N > 2, "Z requires N > 2"); return streams[2]; }
+		inline const	T* Z() const	{ static_assert(N > 2, "Z requires N > 2"); return streams[2]; }
+		inline			T* W()			{ static_assert(N > 3, "W requires N > 3"); return streams[3]; }
+		inline const	T* W() const	{ static_assert(N > 3, "W requires N > 3"); return streams[3]; }
+
+	private:
+		void Allocate(size_t count)
+		{
+			capacity = DVTL::AlignUp(count, Lanes);
+			if (!capacity) return;
+
+			T* block = static_cast<T*>(DVTL::AlignedAlloc(N * capacity * sizeof(T)));
+			for (size_t i = 0; i < N * capacity; ++i)
+				block[i] = T{};
+
+			for (size_t c = 0; c < N; ++c)
+				streams[c] = block + c * capacity;
+		}
+
+		T* streams[N];
+		size_t size;
+		size_t capacity;
+	};
+
+	using VecArray2f = VecArray<float, 2>;
+	using VecArray2d = VecArray<double, 2>;
+	using VecArray3f = VecArray<float, 3>;
+	using VecArray3d = VecArray<double, 3>;
+	using VecArray4f = VecArray<float, 4>;
+	using VecArray4d = VecArray<double, 4>;
+}
+
+#endif // !DVM_VECARRAY_H
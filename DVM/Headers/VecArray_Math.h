@@ -0,0 +1,306 @@
+#ifndef DVM_VECARRAY_MATH_H
+#define DVM_VECARRAY_MATH_H
+
+#include "Math.h"
+#include "Math_Batch.h"
+#include "VecArray.h"
+
+//Bulk versions of Vector_Math.h over VecArray. Results are written to the last argument,
+//which is resized to the input size and may be the same object as an input.
+namespace DVM
+{
+	namespace Detail
+	{
+		//Elements processed per pass when a kernel needs per-vector scratch values
+		constexpr size_t VecArrayChunk = 256;
+
+		template<typename T, size_t N>
+		inline void DotChunk(const VecArray<T, N>& x, const VecArray<T, N>& y, size_t first, size_t count, T* result)
+		{
+			for (size_t i = 0; i < count; ++i)
+				result[i] = T{};
+
+			for (size_t c = 0; c < N; ++c)
+			{
+				const T* xs = x.Stream(c) + first;
+				const T* ys = y.Stream(c) + first;
+
+				for (size_t i = 0; i < count; ++i)
+					result[i] += xs[i] * ys[i];
+			}
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Abs(const VecArray<T, N>& vec, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Abs(in[i]);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Min(const VecArray<T, N>& vec, T val, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Min(in[i], val);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Min(const VecArray<T, N>& vec, const VecArray<T, N>& vec2, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			const T* in2 = vec2.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Min(in[i], in2[i]);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Max(const VecArray<T, N>& vec, T val, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Max(in[i], val);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Max(const VecArray<T, N>& vec, const VecArray<T, N>& vec2, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			const T* in2 = vec2.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Max(in[i], in2[i]);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Clamp(const VecArray<T, N>& vec, T min, T max, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Clamp(in[i], min, max);
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Clamp(const VecArray<T, N>& vec, const VecArray<T, N>& min, const VecArray<T, N>& max, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* in = vec.Stream(c);
+			const T* lo = min.Stream(c);
+			const T* hi = max.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < vec.Size(); ++i)
+				out[i] = Clamp(in[i], lo[i], hi[i]);
+		}
+	}
+
+	//result must hold x.Size() values
+	template<typename T, size_t N>
+	inline void Dot(const VecArray<T, N>& x, const VecArray<T, N>& y, T* result)
+	{
+		Detail::DotChunk(x, y, 0, x.Size(), result);
+	}
+
+	//result must hold vec.Size() values
+	template<typename T, size_t N>
+	inline void Length(const VecArray<T, N>& vec, T* result)
+	{
+		Detail::DotChunk(vec, vec, 0, vec.Size(), result);
+		SqrtBatch(result, result, vec.Size());
+	}
+
+	//result must hold p1.Size() values
+	template<typename T, size_t N>
+	inline void Distance(const VecArray<T, N>& p1, const VecArray<T, N>& p2, T* result)
+	{
+		for (size_t i = 0; i < p1.Size(); ++i)
+			result[i] = T{};
+
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* a = p1.Stream(c);
+			const T* b = p2.Stream(c);
+
+			for (size_t i = 0; i < p1.Size(); ++i)
+				result[i] += (a[i] - b[i]) * (a[i] - b[i]);
+		}
+
+		SqrtBatch(result, result, p1.Size());
+	}
+
+	template<typename T, size_t N>
+	inline void Normalize(const VecArray<T, N>& vec, VecArray<T, N>& result)
+	{
+		result.Resize(vec.Size());
+
+		T scale[Detail::VecArrayChunk];
+		for (size_t first = 0; first < vec.Size(); first += Detail::VecArrayChunk)
+		{
+			size_t count = Min(Detail::VecArrayChunk, vec.Size() - first);
+
+			Detail::DotChunk(vec, vec, first, count, scale);
+			SqrtBatch(scale, scale, count);
+
+			for (size_t i = 0; i < count; ++i)
+				scale[i] = scale[i] < getEpsilon<T>() ? T{} : template_cast<T>(1) / scale[i];
+
+			for (size_t c = 0; c < N; ++c)
+			{
+				const T* in = vec.Stream(c) + first;
+				T* out = result.Stream(c) + first;
+
+				for (size_t i = 0; i < count; ++i)
+					out[i] = in[i] * scale[i];
+			}
+		}
+	}
+
+	template<typename T>
+	inline void Cross(const VecArray<T, 3>& vec1, const VecArray<T, 3>& vec2, VecArray<T, 3>& result)
+	{
+		result.Resize(vec1.Size());
+
+		const T* ax = vec1.X(); const T* ay = vec1.Y(); const T* az = vec1.Z();
+		const T* bx = vec2.X(); const T* by = vec2.Y(); const T* bz = vec2.Z();
+		T* rx = result.X(); T* ry = result.Y(); T* rz = result.Z();
+
+		for (size_t i = 0; i < vec1.Size(); ++i)
+		{
+			T x = ay[i] * bz[i] - az[i] * by[i];
+			T y = az[i] * bx[i] - ax[i] * bz[i];
+			T z = ax[i] * by[i] - ay[i] * bx[i];
+
+			rx[i] = x;
+			ry[i] = y;
+			rz[i] = z;
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Reflect(const VecArray<T, N>& I, const VecArray<T, N>& vecN, VecArray<T, N>& result)
+	{
+		result.Resize(I.Size());
+
+		T scale[Detail::VecArrayChunk];
+		for (size_t first = 0; first < I.Size(); first += Detail::VecArrayChunk)
+		{
+			size_t count = Min(Detail::VecArrayChunk, I.Size() - first);
+
+			Detail::DotChunk(I, vecN, first, count, scale);
+
+			for (size_t c = 0; c < N; ++c)
+			{
+				const T* in = I.Stream(c) + first;
+				const T* normal = vecN.Stream(c) + first;
+				T* out = result.Stream(c) + first;
+
+				for (size_t i = 0; i < count; ++i)
+					out[i] = in[i] - normal[i] * (template_cast<T>(2) * scale[i]);
+			}
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Refract(const VecArray<T, N>& I, const VecArray<T, N>& vecN, T eta, VecArray<T, N>& result)
+	{
+		result.Resize(I.Size());
+
+		T dotProduct[Detail::VecArrayChunk];
+		T k[Detail::VecArrayChunk];
+		T factor[Detail::VecArrayChunk];
+		for (size_t first = 0; first < I.Size(); first += Detail::VecArrayChunk)
+		{
+			size_t count = Min(Detail::VecArrayChunk, I.Size() - first);
+
+			Detail::DotChunk(I, vecN, first, count, dotProduct);
+
+			//Total internal reflection gives a zero vector, as in the single vector Refract
+			for (size_t i = 0; i < count; ++i)
+			{
+				k[i] = template_cast<T>(1) - eta * eta * (template_cast<T>(1) - dotProduct[i] * dotProduct[i]);
+				factor[i] = k[i] < template_cast<T>(0) ? T{} : template_cast<T>(1);
+			}
+
+			SqrtBatch(k, k, count);
+
+			for (size_t i = 0; i < count; ++i)
+				dotProduct[i] = factor[i] * (eta * dotProduct[i] + k[i]);
+
+			for (size_t i = 0; i < count; ++i)
+				factor[i] *= eta;
+
+			for (size_t c = 0; c < N; ++c)
+			{
+				const T* in = I.Stream(c) + first;
+				const T* normal = vecN.Stream(c) + first;
+				T* out = result.Stream(c) + first;
+
+				for (size_t i = 0; i < count; ++i)
+					out[i] = factor[i] * in[i] - dotProduct[i] * normal[i];
+			}
+		}
+	}
+
+	template<typename T, size_t N>
+	inline void Mix(const VecArray<T, N>& x, const VecArray<T, N>& y, T a, VecArray<T, N>& result)
+	{
+		result.Resize(x.Size());
+
+		//Same edge behaviour as the scalar Mix
+		T weight = a;
+		T inv_weight = template_cast<T>(1) - a;
+		if (a < template_cast<T>(0)) { weight = template_cast<T>(1); inv_weight = template_cast<T>(0); }
+		if (a > template_cast<T>(1)) { weight = template_cast<T>(0); inv_weight = template_cast<T>(1); }
+
+		for (size_t c = 0; c < N; ++c)
+		{
+			const T* xs = x.Stream(c);
+			const T* ys = y.Stream(c);
+			T* out = result.Stream(c);
+
+			for (size_t i = 0; i < x.Size(); ++i)
+				out[i] = xs[i] * weight + ys[i] * inv_weight;
+		}
+	}
+}
+
+#endif // !DVM_VECARRAY_MATH_H
@@ -1,6 +1,7 @@
 #ifndef DVM_VECTOR_H
 #define DVM_VECTOR_H
 
+#include "Expression.h"
 #include "Utility.h"
 #include "Math.h"
 
@@ -17,8 +18,12 @@ namespace DVM
 	template<typename T1, typename T2, typename T3, typename T4>			struct Swich_N<T1, T2, T3, T4, 3> { using type = T3; };
 	template<typename T1, typename T2, typename T3, typename T4, size_t N>	using  Swich_N_type = typename Swich_N<T1, T2, T3, T4, N>::type;
 
+	template<typename T, size_t N>	struct VecAlignment { static constexpr size_t value = alignof(T); };
+	template<>						struct VecAlignment<float, 4> { static constexpr size_t value = 16; };
+	template<>						struct VecAlignment<double, 4> { static constexpr size_t value = 32; };
+
 	template<typename T, size_t N>
-	struct VecTemplate
+	struct alignas(VecAlignment<T, N>::value) VecTemplate
 	{
 		static_assert(N != 0, "N must not be zero");
 
@@ -28,19 +33,15 @@ namespace DVM
 			Swich_N_type<S_X<T>, S_XY<T>, S_XYZ<T>, S_XYZW<T>, N> Values;
 		};
 		
-		VecTemplate()
-		{
-			for (size_t i = 0; i < N; ++i)
-				data[i] = T{};
-		}
+		constexpr VecTemplate() : data{} {}
 
-		VecTemplate(T value)
+		constexpr VecTemplate(T value) : data{}
 		{
 			for (size_t i = 0; i < N; ++i)
 				data[i] = value;
 		}
 
-		VecTemplate(T value, size_t index)
+		constexpr VecTemplate(T value, size_t index) : data{}
 		{
 			static_assert(index < N, "Index out of range");
 
@@ -48,14 +49,14 @@ namespace DVM
 				data[i] = (i == index) ? value : T{};
 		}
 
-		VecTemplate(T initValues[N])
+		constexpr VecTemplate(T initValues[N]) : data{}
 		{
 			for (size_t i = 0; i < N; ++i)
 				data[i] = initValues[i];
 		}
 
 		template<typename... Args>
-		VecTemplate(Args... args)
+		constexpr VecTemplate(Args... args) : data{}
 		{
 			static_assert(sizeof...(Args) == N, "Number of arguments must match vector size");
 
@@ -65,21 +66,18 @@ namespace DVM
 				data[i] = initValues[i];
 		}
 
-		VecTemplate(const VecTemplate& right)
-		{
-			for (size_t i = 0; i < N; ++i)
-				data[i] = right[i];
-		}
+		//Defaulted copies and destructor keep the type trivially copyable, arrays of vectors copy as memcpy
+		constexpr VecTemplate(const VecTemplate& right) = default;
 
-		template<typename U>
-		VecTemplate(U value)
+		template<typename U, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<U>, int> = 0>
+		constexpr VecTemplate(U value) : data{}
 		{
 			for (size_t i = 0; i < N; ++i)
 				data[i] = static_cast<T>(value);
 		}
 
-		template<typename U>
-		VecTemplate(U value, size_t index)
+		template<typename U, DVTL::Enable_if_t<DVTL::Is_arithmetic_v<U>, int> = 0>
+		constexpr VecTemplate(U value, size_t index) : data{}
 		{
 			static_assert(index < N, "Index out of range");
 
@@ -88,14 +86,14 @@ namespace DVM
 		}
 
 		template<typename U>
-		VecTemplate(U initValues[N])
+		constexpr VecTemplate(U initValues[N]) : data{}
 		{
 			for (size_t i = 0; i < N; ++i)
 				data[i] = static_cast<T>(initValues[i]);
 		}
 
 		template<typename U, size_t M>
-		VecTemplate(const VecTemplate<U, M>& right)
+		constexpr VecTemplate(const VecTemplate<U, M>& right) : data{}
 		{
 			size_t minSize = N < M ? N : M;
 
@@ -107,7 +105,7 @@ namespace DVM
 		}
 
 		template<typename U, size_t M, typename... Args>
-		VecTemplate(const VecTemplate<U, M>& right, Args... args)
+		constexpr VecTemplate(const VecTemplate<U, M>& right, Args... args) : data{}
 		{
 			static_assert(sizeof...(Args) + M == N, "Number of arguments must match vector size");
 
@@ -120,72 +118,80 @@ namespace DVM
 				data[i] = initValues[i - M];
 		}
 
-		VecTemplate& operator=(const VecTemplate& right)
+		//Evaluates an Expression.h expression in one pass
+		template<typename E, DVTL::Enable_if_t<Detail::IsExpression_v<E>, int> = 0>
+		constexpr VecTemplate(const E& expression) : data{}
 		{
-			if (this != &right)
-				for (size_t i = 0; i < N; ++i)
-					data[i] = right[i];
-
-			return *this;
+			static_assert(DVTL::Is_same_v<typename Detail::ExpressionTraits<E>::Result, VecTemplate>, "Expression must have the vector type");
+			Detail::EvaluateExpression<N>(data, expression);
 		}
 
+		constexpr VecTemplate& operator=(const VecTemplate& right) = default;
+
 		template<typename U, size_t M>
-		VecTemplate& operator=(const VecTemplate<U, M>& right)
+		constexpr VecTemplate& operator=(const VecTemplate<U, M>& right)
 		{
-			if (this != &right)
-			{
-				size_t minSize = N < M ? N : M;
+			size_t minSize = N < M ? N : M;
+
+			for (size_t i = 0; i < minSize; ++i)
+				data[i] = static_cast<T>(right[i]);
+
+			for (size_t i = minSize; i < N; ++i)
+				data[i] = T{};
 
-				for (size_t i = 0; i < minSize; ++i)
-					data[i] = static_cast<T>(right[i]);
+			return *this;
+		}
 
-				for (size_t i = minSize; i < N; ++i)
-					data[i] = T{};
-			}
+		//Operands of an expression are only read at the index being written, so it may refer to this vector
+		template<typename E, DVTL::Enable_if_t<Detail::IsExpression_v<E>, int> = 0>
+		constexpr VecTemplate& operator=(const E& expression)
+		{
+			static_assert(DVTL::Is_same_v<typename Detail::ExpressionTraits<E>::Result, VecTemplate>, "Expression must have the vector type");
+			Detail::EvaluateExpression<N>(data, expression);
 			return *this;
 		}
 
-		~VecTemplate() {};
+		~VecTemplate() = default;
 
-		VecTemplate& operator++();
-		VecTemplate& operator--();
-		const VecTemplate operator++(int);
-		const VecTemplate operator--(int);
+		constexpr VecTemplate& operator++();
+		constexpr VecTemplate& operator--();
+		constexpr const VecTemplate operator++(int);
+		constexpr const VecTemplate operator--(int);
 
 		//Composite statements of the VecTemplate class
-		VecTemplate& operator%=(T value);
-		VecTemplate& operator%=(const VecTemplate& value);
-		VecTemplate& operator*=(T value);
-		VecTemplate& operator*=(const VecTemplate& value);
-		VecTemplate& operator/=(T value);
-		VecTemplate& operator/=(const VecTemplate& value);
-		VecTemplate& operator+=(T value);
-		VecTemplate& operator+=(const VecTemplate& value);
-		VecTemplate& operator-=(T value);
-		VecTemplate& operator-=(const VecTemplate& value);
+		constexpr VecTemplate& operator%=(T value);
+		constexpr VecTemplate& operator%=(const VecTemplate& value);
+		constexpr VecTemplate& operator*=(T value);
+		constexpr VecTemplate& operator*=(const VecTemplate& value);
+		constexpr VecTemplate& operator/=(T value);
+		constexpr VecTemplate& operator/=(const VecTemplate& value);
+		constexpr VecTemplate& operator+=(T value);
+		constexpr VecTemplate& operator+=(const VecTemplate& value);
+		constexpr VecTemplate& operator-=(T value);
+		constexpr VecTemplate& operator-=(const VecTemplate& value);
 	
-		VecTemplate& operator<<=(int shift);
-		VecTemplate& operator<<=(const VecTemplate<int, N>& shift);
-		VecTemplate& operator>>=(int shift);
-		VecTemplate& operator>>=(const VecTemplate<int, N>& shift);
-
-		VecTemplate& operator^=(T value);
-		VecTemplate& operator^=(const VecTemplate& value);
-		VecTemplate& operator|=(T value);
-		VecTemplate& operator|=(const VecTemplate& value);
-		VecTemplate& operator&=(T value);
-		VecTemplate& operator&=(const VecTemplate& value);
+		constexpr VecTemplate& operator<<=(int shift);
+		constexpr VecTemplate& operator<<=(const VecTemplate<int, N>& shift);
+		constexpr VecTemplate& operator>>=(int shift);
+		constexpr VecTemplate& operator>>=(const VecTemplate<int, N>& shift);
+
+		constexpr VecTemplate& operator^=(T value);
+		constexpr VecTemplate& operator^=(const VecTemplate& value);
+		constexpr VecTemplate& operator|=(T value);
+		constexpr VecTemplate& operator|=(const VecTemplate& value);
+		constexpr VecTemplate& operator&=(T value);
+		constexpr VecTemplate& operator&=(const VecTemplate& value);
 
 		constexpr size_t Size() const { return N; }
 
-		inline			T& operator[](size_t index)			{ return data[index]; }
-		inline const	T& operator[](size_t index) const	{ return data[index]; }
+		constexpr		T& operator[](size_t index)			{ return data[index]; }
+		constexpr const	T& operator[](size_t index) const	{ return data[index]; }
 
-		inline floatingPoint_t<T> length() const;
+		constexpr floatingPoint_t<T> length() const;
 	};
 
 	template<typename T, size_t N>
-	inline floatingPoint_t<T> VecTemplate<T, N>::length() const
+	constexpr floatingPoint_t<T> VecTemplate<T, N>::length() const
 	{
 		floatingPoint_t<T> sum_of_squares = 0;
 		for (size_t i = 0; i < N; i++)
@@ -193,6 +199,10 @@ namespace DVM
 		return Sqrt(sum_of_squares);
 	}
 
+	static_assert(DVTL::Is_trivially_copyable_v<VecTemplate<float, 3>> && DVTL::Is_trivially_copyable_v<VecTemplate<double, 4>>, "VecTemplate must be trivially copyable");
+	static_assert(DVTL::Is_standard_layout_v<VecTemplate<float, 3>> && DVTL::Is_standard_layout_v<VecTemplate<double, 4>>, "VecTemplate must be standard layout");
+	static_assert(sizeof(VecTemplate<float, 3>) == 3 * sizeof(float), "VecTemplate must not be padded");
+
 	using Vec2i		= VecTemplate<int, 2>;
 	using Vec2c		= VecTemplate<char, 2>;
 	using Vec2f		= VecTemplate<float, 2>;
@@ -230,7 +240,7 @@ namespace DVM
 	using Vec4ulli	= VecTemplate<unsigned long long int, 4>;
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator++()
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator++()
 	{
 		for (size_t i = 0; i < N; i++)
 			++data[i];
@@ -238,7 +248,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator--()
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator--()
 	{
 		for (size_t i = 0; i < N; i++)
 			--data[i];
@@ -246,7 +256,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline const VecTemplate<T, N> VecTemplate<T, N>::operator++(int)
+	constexpr const VecTemplate<T, N> VecTemplate<T, N>::operator++(int)
 	{
 		VecTemplate<T, N> result(*this);
 		++(*this);
@@ -254,7 +264,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline const VecTemplate<T, N> VecTemplate<T, N>::operator--(int)
+	constexpr const VecTemplate<T, N> VecTemplate<T, N>::operator--(int)
 	{
 		VecTemplate<T, N> result(*this);
 		--(*this);
@@ -263,7 +273,7 @@ namespace DVM
 
 	//Composite statements of the VecTemplate class
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator%=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator%=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] %= value;
@@ -271,7 +281,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator%=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator%=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] %= value[i];
@@ -279,7 +289,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator*=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator*=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] *= value;
@@ -287,7 +297,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator*=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator*=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] *= value[i];
@@ -295,7 +305,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator/=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator/=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] /= value;
@@ -303,7 +313,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator/=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator/=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] /= value[i];
@@ -311,7 +321,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator+=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator+=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] += value;
@@ -319,7 +329,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator+=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator+=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] += value[i];
@@ -327,7 +337,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator-=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator-=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] -= value;
@@ -335,7 +345,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator-=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator-=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] -= value[i];
@@ -343,7 +353,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator<<=(int shift)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator<<=(int shift)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] <<= shift;
@@ -351,7 +361,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator<<=(const VecTemplate<int, N>& shift)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator<<=(const VecTemplate<int, N>& shift)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] <<= shift[i];
@@ -359,7 +369,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator>>=(int shift)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator>>=(int shift)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] >>= shift;
@@ -367,7 +377,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator>>=(const VecTemplate<int, N>& shift)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator>>=(const VecTemplate<int, N>& shift)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] >>= shift[i];
@@ -375,7 +385,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator^=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator^=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] ^= value;
@@ -383,7 +393,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator^=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator^=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] ^= value[i];
@@ -391,7 +401,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator|=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator|=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] |= value;
@@ -399,7 +409,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator|=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator|=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] |= value[i];
@@ -407,7 +417,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator&=(T value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator&=(T value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] &= value;
@@ -415,7 +425,7 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N>& VecTemplate<T, N>::operator&=(const VecTemplate& value)
+	constexpr VecTemplate<T, N>& VecTemplate<T, N>::operator&=(const VecTemplate& value)
 	{
 		for (size_t i = 0; i < N; i++)
 			data[i] &= value[i];
@@ -424,134 +434,136 @@ namespace DVM
 
 	//External operators of the VecTemplate class
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator%(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator%(VecTemplate<T, N> lhs, T rhs) {
 		lhs %= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator%(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator%(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs %= rhs;
 		return lhs;
 	}
 
+#if !defined(DVM_EXPRESSION_TEMPLATES)
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator*(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator*(VecTemplate<T, N> lhs, T rhs) {
 		lhs *= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator*(T lhs, VecTemplate<T, N> rhs) {
+	constexpr VecTemplate<T, N> operator*(T lhs, VecTemplate<T, N> rhs) {
 		rhs *= lhs;
 		return rhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator*(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator*(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs *= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator/(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator/(VecTemplate<T, N> lhs, T rhs) {
 		lhs /= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator/(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator/(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs /= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator+(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator+(VecTemplate<T, N> lhs, T rhs) {
 		lhs += rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator+(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator+(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs += rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator-(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator-(VecTemplate<T, N> lhs, T rhs) {
 		lhs -= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator-(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator-(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs -= rhs;
 		return lhs;
 	}
+#endif
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator<<(VecTemplate<T, N> lhs, int rhs) {
+	constexpr VecTemplate<T, N> operator<<(VecTemplate<T, N> lhs, int rhs) {
 		lhs <<= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator<<(VecTemplate<T, N> lhs, const VecTemplate<int, N>& rhs) {
+	constexpr VecTemplate<T, N> operator<<(VecTemplate<T, N> lhs, const VecTemplate<int, N>& rhs) {
 		lhs <<= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator>>(VecTemplate<T, N> lhs, int rhs) {
+	constexpr VecTemplate<T, N> operator>>(VecTemplate<T, N> lhs, int rhs) {
 		lhs >>= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator>>(VecTemplate<T, N> lhs, const VecTemplate<int, N>& rhs) {
+	constexpr VecTemplate<T, N> operator>>(VecTemplate<T, N> lhs, const VecTemplate<int, N>& rhs) {
 		lhs >>= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator^(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator^(VecTemplate<T, N> lhs, T rhs) {
 		lhs ^= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator^(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator^(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs ^= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator|(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator|(VecTemplate<T, N> lhs, T rhs) {
 		lhs |= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator|(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator|(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs |= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator&(VecTemplate<T, N> lhs, T rhs) {
+	constexpr VecTemplate<T, N> operator&(VecTemplate<T, N> lhs, T rhs) {
 		lhs &= rhs;
 		return lhs;
 	}
 
 	template <typename T, size_t N>
-	VecTemplate<T, N> operator&(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
+	constexpr VecTemplate<T, N> operator&(VecTemplate<T, N> lhs, const VecTemplate<T, N>& rhs) {
 		lhs &= rhs;
 		return lhs;
 	}
 
 }
 
-
+#include "Vector_SIMD.h"
 
 #endif // !DVM_VECTOR_H
 
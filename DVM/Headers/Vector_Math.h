@@ -2,6 +2,7 @@
 #define DVM_VECTOR_FUNCTIONS_H
 
 #include "Math.h"
+#include "Math_Batch.h"
 #include "Vector.h"
 
 namespace DVM
@@ -92,8 +93,7 @@ namespace DVM
 	inline VecTemplate<T, N> Ceil(const VecTemplate<T, N>& vec)
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Ceil(vec[i]);
+		CeilBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -101,8 +101,7 @@ namespace DVM
 	inline VecTemplate<T, N> Floor(const VecTemplate<T, N>& vec)
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Floor(vec[i]);
+		FloorBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -110,8 +109,7 @@ namespace DVM
 	inline VecTemplate<T, N> Round(const VecTemplate<T, N>& vec)
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Round(vec[i]);
+		RoundBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -119,8 +117,7 @@ namespace DVM
 	inline VecTemplate<T, N> Fract(const VecTemplate<T, N>& vec)
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Fract(vec[i]);
+		FractBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -161,11 +158,18 @@ namespace DVM
 	}
 
 	template<typename T, size_t N>
-	inline VecTemplate<T, N> Mod(const VecTemplate<T, N>& vec)
+	inline VecTemplate<T, N> Mod(const VecTemplate<T, N>& vec, T mod)
 	{
-		VecTemplate<bool, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Mod(vec[i]);
+		VecTemplate<T, N> result;
+		ModBatch(vec.data, mod, result.data, N);
+		return result;
+	}
+
+	template<typename T, size_t N>
+	inline VecTemplate<T, N> Mod(const VecTemplate<T, N>& vec, const VecTemplate<T, N>& mod)
+	{
+		VecTemplate<T, N> result;
+		ModBatch(vec.data, mod.data, result.data, N);
 		return result;
 	}
 
@@ -200,8 +204,7 @@ namespace DVM
 	inline VecTemplate<T, N> Exp(const VecTemplate<T, N>& vec) 
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Exp(vec[i]);
+		ExpBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -209,8 +212,7 @@ namespace DVM
 	inline VecTemplate<T, N> Exp2(const VecTemplate<T, N>& vec) 
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Exp2(vec[i]);
+		Exp2Batch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -227,8 +229,7 @@ namespace DVM
 	inline VecTemplate<T, N> Log(const VecTemplate<T, N>& vec) 
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Log(vec[i]);
+		LogBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -236,8 +237,7 @@ namespace DVM
 	inline VecTemplate<T, N> Log2(const VecTemplate<T, N>& vec) 
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Log2(vec[i]);
+		Log2Batch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -245,17 +245,25 @@ namespace DVM
 	inline VecTemplate<T, N> Pow(const VecTemplate<T, N>& vecbase, T exp)
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Pow(vecbase[i], exp);
+		PowBatch(vecbase.data, exp, result.data, N);
 		return result;
 	}
 
 	template<typename T, size_t N>
 	inline VecTemplate<T, N> Pow(const VecTemplate<T, N>& vecbase, const VecTemplate<T, N>& vecexp) 
+	{
+		VecTemplate<T, N> result;
+		PowBatch(vecbase.data, vecexp.data, result.data, N);
+		return result;
+	}
+
+	//Exponent known at compile time, each component through the unrolled scalar Pow<Exponent>
+	template<int Exponent, typename T, size_t N>
+	inline VecTemplate<T, N> Pow(const VecTemplate<T, N>& vecbase)
 	{
 		VecTemplate<T, N> result;
 		for (size_t i = 0; i < N; i++)
-			result[i] = Pow(vecbase[i], vecexp[i]);
+			result[i] = Pow<Exponent>(vecbase[i]);
 		return result;
 	}
 
@@ -263,8 +271,7 @@ namespace DVM
 	inline VecTemplate<T, N> Sqrt(const VecTemplate<T, N>& vec) 
 	{
 		VecTemplate<T, N> result;
-		for (size_t i = 0; i < N; i++)
-			result[i] = Sqrt(vec[i]);
+		SqrtBatch(vec.data, result.data, N);
 		return result;
 	}
 
@@ -291,7 +298,7 @@ namespace DVM
 	template<typename T, size_t N>
 	inline T Distance(const VecTemplate<T, N>& p1, const VecTemplate<T, N>& p2)
 	{
-		return Length(p1-p2);
+		return Length(VecTemplate<T, N>(p1 - p2));
 	}
 
 	template<typename T, size_t N>
@@ -312,7 +319,7 @@ namespace DVM
 			size_t prev = (i + N - 1) % N;
 			size_t next = (i + 1) % N;
 
-			result.Values[i] = vec1.Values[prev] * vec2.Values[next] - vec1.Values[next] * vec2.Values[prev];
+			result[i] = vec1[next] * vec2[prev] - vec1[prev] * vec2[next];
 		}
 
 		return result;
@@ -344,6 +351,68 @@ namespace DVM
 		VecTemplate<T, N> refractedVector = eta * I - (eta * dotProduct + Sqrt(k)) * vecN;
 		return refractedVector;
 	}
+
+#if defined(DVM_SIMD_SSE2)
+	inline float Dot(const Vec4f& x, const Vec4f& y)
+	{
+		return _mm_cvtss_f32(SIMD::Dot4(_mm_load_ps(x.data), _mm_load_ps(y.data)));
+	}
+
+	inline float Dot(const Vec3f& x, const Vec3f& y)
+	{
+		return _mm_cvtss_f32(SIMD::Dot4(SIMD::Load3(x.data), SIMD::Load3(y.data)));
+	}
+
+	inline Vec4f Normalize(const Vec4f& vec)
+	{
+		__m128 value = _mm_load_ps(vec.data);
+		__m128 length = _mm_sqrt_ps(SIMD::Dot4(value, value));
+
+		if (_mm_cvtss_f32(length) < getEpsilon<float>()) return Vec4f();
+
+		Vec4f result;
+		_mm_store_ps(result.data, _mm_div_ps(value, length));
+		return result;
+	}
+
+	inline Vec3f Normalize(const Vec3f& vec)
+	{
+		__m128 value = SIMD::Load3(vec.data);
+		__m128 length = _mm_sqrt_ps(SIMD::Dot4(value, value));
+
+		if (_mm_cvtss_f32(length) < getEpsilon<float>()) return Vec3f();
+
+		Vec3f result;
+		SIMD::Store3(result.data, _mm_div_ps(value, length));
+		return result;
+	}
+
+	inline Vec3f Cross(const Vec3f& vec1, const Vec3f& vec2)
+	{
+		Vec3f result;
+		SIMD::Store3(result.data, SIMD::Cross3(SIMD::Load3(vec1.data), SIMD::Load3(vec2.data)));
+		return result;
+	}
+#endif
+
+#if defined(DVM_SIMD_AVX)
+	inline double Dot(const Vec4d& x, const Vec4d& y)
+	{
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(SIMD::Dot4(_mm256_load_pd(x.data), _mm256_load_pd(y.data))));
+	}
+
+	inline Vec4d Normalize(const Vec4d& vec)
+	{
+		__m256d value = _mm256_load_pd(vec.data);
+		__m256d length = _mm256_sqrt_pd(SIMD::Dot4(value, value));
+
+		if (_mm_cvtsd_f64(_mm256_castpd256_pd128(length)) < getEpsilon<double>()) return Vec4d();
+
+		Vec4d result;
+		_mm256_store_pd(result.data, _mm256_div_pd(value, length));
+		return result;
+	}
+#endif
 }
 
 #endif // !DVM_VECTOR_FUNCTIONS_H
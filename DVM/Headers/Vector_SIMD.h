@@ -0,0 +1,287 @@
+#ifndef DVM_VECTOR_SIMD_H
+#define DVM_VECTOR_SIMD_H
+
+#include "SIMD.h"
+#include "Vector.h"
+
+namespace DVM
+{
+#if defined(DVM_SIMD_SSE2)
+	//Vec4f
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator*=(float value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] *= value;
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_mul_ps(_mm_load_ps(data), _mm_set1_ps(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator*=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] *= value[i];
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_mul_ps(_mm_load_ps(data), _mm_load_ps(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator/=(float value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] /= value;
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_div_ps(_mm_load_ps(data), _mm_set1_ps(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator/=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] /= value[i];
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_div_ps(_mm_load_ps(data), _mm_load_ps(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator+=(float value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] += value;
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_add_ps(_mm_load_ps(data), _mm_set1_ps(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator+=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] += value[i];
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_add_ps(_mm_load_ps(data), _mm_load_ps(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator-=(float value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] -= value;
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_sub_ps(_mm_load_ps(data), _mm_set1_ps(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<float, 4>& VecTemplate<float, 4>::operator-=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] -= value[i];
+			return *this;
+		}
+
+		_mm_store_ps(data, _mm_sub_ps(_mm_load_ps(data), _mm_load_ps(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr float VecTemplate<float, 4>::length() const
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			float sum = 0;
+			for (size_t i = 0; i < 4; ++i)
+				sum += data[i] * data[i];
+			return Sqrt(sum);
+		}
+
+		__m128 vec = _mm_load_ps(data);
+		return _mm_cvtss_f32(_mm_sqrt_ss(SIMD::Dot4(vec, vec)));
+	}
+
+	//Vec3f is kept at 12 bytes, the fourth lane only exists in the register
+	template<>
+	constexpr float VecTemplate<float, 3>::length() const
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			float sum = 0;
+			for (size_t i = 0; i < 3; ++i)
+				sum += data[i] * data[i];
+			return Sqrt(sum);
+		}
+
+		__m128 vec = SIMD::Load3(data);
+		return _mm_cvtss_f32(_mm_sqrt_ss(SIMD::Dot4(vec, vec)));
+	}
+#endif
+
+#if defined(DVM_SIMD_AVX)
+	//Vec4d
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator*=(double value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] *= value;
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_mul_pd(_mm256_load_pd(data), _mm256_set1_pd(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator*=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] *= value[i];
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_mul_pd(_mm256_load_pd(data), _mm256_load_pd(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator/=(double value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] /= value;
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_div_pd(_mm256_load_pd(data), _mm256_set1_pd(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator/=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] /= value[i];
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_div_pd(_mm256_load_pd(data), _mm256_load_pd(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator+=(double value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] += value;
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_add_pd(_mm256_load_pd(data), _mm256_set1_pd(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator+=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] += value[i];
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_add_pd(_mm256_load_pd(data), _mm256_load_pd(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator-=(double value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] -= value;
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_sub_pd(_mm256_load_pd(data), _mm256_set1_pd(value)));
+		return *this;
+	}
+
+	template<>
+	constexpr VecTemplate<double, 4>& VecTemplate<double, 4>::operator-=(const VecTemplate& value)
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			for (size_t i = 0; i < 4; ++i)
+				data[i] -= value[i];
+			return *this;
+		}
+
+		_mm256_store_pd(data, _mm256_sub_pd(_mm256_load_pd(data), _mm256_load_pd(value.data)));
+		return *this;
+	}
+
+	template<>
+	constexpr double VecTemplate<double, 4>::length() const
+	{
+		if (DVM_IS_CONSTANT_EVALUATED())
+		{
+			double sum = 0;
+			for (size_t i = 0; i < 4; ++i)
+				sum += data[i] * data[i];
+			return Sqrt(sum);
+		}
+
+		__m256d vec = _mm256_load_pd(data);
+		__m128d dot = _mm256_castpd256_pd128(SIMD::Dot4(vec, vec));
+		return _mm_cvtsd_f64(_mm_sqrt_sd(dot, dot));
+	}
+#endif
+}
+
+#endif // !DVM_VECTOR_SIMD_H
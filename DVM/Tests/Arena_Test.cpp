@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <thread>
+
+#include "Test.h"
+#include "../Headers/Arena.h"
+
+//Alignment, rewinding and the block reuse that keeps a steady state free of heap allocations. Small block sizes
+//make the frames spill over block boundaries
+namespace
+{
+	bool Aligned(const void* pointer, size_t alignment) { return reinterpret_cast<uintptr_t>(pointer) % alignment == 0; }
+
+	//Three allocations that do not fit one 1024 byte block
+	void Frame(DVM::Arena& arena, void** pointers)
+	{
+		pointers[0] = arena.AllocateBytes(600);
+		pointers[1] = arena.Allocate<double>(100);
+		pointers[2] = arena.AllocateBytes(300, 256);
+	}
+}
+
+DVM_TEST(Arena_Alignment)
+{
+	DVM::Arena arena(1024);
+	DVM_CHECK(arena.HeapAllocations() == 0 && arena.Capacity() == 0);
+
+	unsigned char* byte = static_cast<unsigned char*>(arena.AllocateBytes(1, 1));
+	float* floats = arena.Allocate<float>(3);
+	void* page = arena.AllocateBytes(16, 4096);
+	DVM_CHECK(byte && Aligned(floats, DVTL::CacheLineSize) && Aligned(page, 4096));
+
+	//Larger than a block, gets a block of its own
+	unsigned char* large = static_cast<unsigned char*>(arena.AllocateBytes(10000));
+	large[9999] = 1;
+	DVM_CHECK(arena.Capacity() >= 10000 + 1024);
+
+	int* filled = arena.Allocate<int>(50, 7);
+	bool all = true;
+	for (size_t i = 0; i < 50; ++i)
+		all = all && filled[i] == 7;
+	DVM_CHECK(all && Aligned(filled, DVTL::CacheLineSize));
+}
+
+DVM_TEST(Arena_MarkRelease)
+{
+	DVM::Arena arena(1024);
+	arena.AllocateBytes(100);
+	size_t before = arena.Used();
+
+	DVM::Arena::Marker marker = arena.Mark();
+	void* first = arena.AllocateBytes(200);
+	void* spilled = arena.AllocateBytes(2000);
+	DVM_CHECK(arena.Used() >= before + 2200);
+
+	//Released memory is handed out again, from the same blocks
+	arena.Release(marker);
+	DVM_CHECK(arena.Used() == before);
+	size_t heap = arena.HeapAllocations();
+	DVM_CHECK(arena.AllocateBytes(200) == first && arena.AllocateBytes(2000) == spilled);
+	DVM_CHECK(arena.HeapAllocations() == heap);
+
+	//Scopes nest and rewind in reverse order
+	arena.Release(marker);
+	{
+		DVM::ArenaScope outer(arena);
+		double* a = outer.Allocate<double>(10);
+		size_t inside = arena.Used();
+		{
+			DVM::ArenaScope inner(arena);
+			inner.Allocate<double>(500, 1.);
+			DVM_CHECK(arena.Used() > inside);
+		}
+		DVM_CHECK(arena.Used() == inside && outer.Allocate<double>(1) != a);
+	}
+	DVM_CHECK(arena.Used() == before);
+
+	//A marker taken before the first allocation rewinds to an empty arena
+	DVM::Arena fresh(1024);
+	DVM::Arena::Marker empty = fresh.Mark();
+	void* pointer = fresh.AllocateBytes(64);
+	fresh.Release(empty);
+	DVM_CHECK(fresh.Used() == 0 && fresh.AllocateBytes(64) == pointer && fresh.HeapAllocations() == 1);
+}
+
+DVM_TEST(Arena_Statistics)
+{
+	DVM::Arena arena(1024);
+	void* pointers[3];
+
+	Frame(arena, pointers);
+	size_t frameUsed = arena.Used();
+	DVM_CHECK(frameUsed >= 600 + 800 + 300 && arena.Peak() == frameUsed);
+	DVM_CHECK(arena.HeapAllocations() >= 2);
+
+	//Reset merges the blocks of the spilled frame into one, the next frame fits in it
+	size_t capacity = arena.Capacity();
+	size_t heap = arena.HeapAllocations();
+	arena.Reset();
+	DVM_CHECK(arena.Used() == 0 && arena.Peak() == frameUsed);
+	DVM_CHECK(arena.Capacity() == capacity && arena.HeapAllocations() == heap + 1);
+
+	Frame(arena, pointers);
+	DVM_CHECK(arena.HeapAllocations() == heap + 1);
+	unsigned char* base = static_cast<unsigned char*>(pointers[0]);
+	unsigned char* last = static_cast<unsigned char*>(pointers[2]);
+	DVM_CHECK(last > base && static_cast<size_t>(last - base) < capacity);
+
+	//Steady state, frames of the same size allocate nothing
+	for (int i = 0; i < 10; ++i)
+	{
+		arena.Reset();
+		Frame(arena, pointers);
+	}
+	DVM_CHECK(arena.HeapAllocations() == heap + 1);
+
+	arena.Reset();
+	arena.AllocateBytes(10);
+	arena.ResetPeak();
+	DVM_CHECK(arena.Peak() == arena.Used() && arena.Peak() < frameUsed);
+}
+
+DVM_TEST(Arena_ThreadArena)
+{
+	DVM::Arena* main = &DVM::ThreadArena();
+	DVM::Arena* worker = nullptr;
+	std::thread thread([&] { worker = &DVM::ThreadArena(); DVM::ArenaScope scope; scope.Allocate<float>(1000); });
+	thread.join();
+	DVM_CHECK(worker && worker != main && main == &DVM::ThreadArena());
+}
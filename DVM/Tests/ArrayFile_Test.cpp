@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/ArrayFile.h"
+
+//Write, map and stream round trips. Files go to the working directory and are removed afterwards
+namespace
+{
+	template<typename E>
+	std::vector<E> RandomElements(size_t count, uint32_t seed)
+	{
+		using Scalar = typename DVM::Detail::ArrayElement<E>::Scalar;
+
+		std::vector<E> result(count);
+		for (E& element : result)
+			for (Scalar& value : element.data)
+				value = DVM::Test::Random<Scalar>(seed, -100., 100.);
+		return result;
+	}
+
+	//WriteArrayFile, then MappedArray and ArrayFileReader in uneven chunks must return the same bytes
+	template<typename E>
+	void CheckRoundTrip(DVM::Test::State& state, const char* path, size_t count, uint32_t seed)
+	{
+		std::vector<E> elements = RandomElements<E>(count, seed);
+		DVM_CHECK(DVM::WriteArrayFile(path, elements.data(), count));
+
+		{
+			DVM::MappedArray<E> mapped;
+			DVM_CHECK(mapped.Open(path));
+			DVM_CHECK(mapped.Size() == count);
+			DVM_CHECK(count == 0 || DVM::Test::BitEqual(mapped.Data(), elements.data(), count));
+		}
+
+		DVM::ArrayFileReader<E> reader;
+		DVM_CHECK(reader.Open(path));
+		DVM_CHECK(reader.Size() == count);
+
+		std::vector<E> chunk(97);
+		size_t offset = 0, read = 0;
+		bool equal = true;
+		while ((read = reader.Read(chunk.data(), chunk.size())) != 0)
+		{
+			equal = equal && offset + read <= count && DVM::Test::BitEqual(chunk.data(), elements.data() + offset, read);
+			offset += read;
+		}
+		DVM_CHECK(equal && offset == count && reader.Remaining() == 0);
+
+		reader.Close();
+		std::remove(path);
+	}
+}
+
+DVM_TEST(ArrayFile_RoundTrip)
+{
+	CheckRoundTrip<DVM::Vec3f>(state, "DVM_ArrayFile_Test_Vec3f.dvma", 10007, 1u);
+	CheckRoundTrip<DVM::Vec4d>(state, "DVM_ArrayFile_Test_Vec4d.dvma", 513, 2u);
+	CheckRoundTrip<DVM::Mat4f>(state, "DVM_ArrayFile_Test_Mat4f.dvma", 1000, 3u);
+	CheckRoundTrip<DVM::MatTemplate<double, 2, 3>>(state, "DVM_ArrayFile_Test_Mat23d.dvma", 77, 4u);
+	CheckRoundTrip<DVM::Vec2i>(state, "DVM_ArrayFile_Test_Vec2i.dvma", 4096, 5u);
+	CheckRoundTrip<DVM::Vec3f>(state, "DVM_ArrayFile_Test_Empty.dvma", 0, 6u);
+	CheckRoundTrip<DVM::Vec4h>(state, "DVM_ArrayFile_Test_Vec4h.dvma", 1001, 9u);
+	CheckRoundTrip<DVM::Mat4bf>(state, "DVM_ArrayFile_Test_Mat4bf.dvma", 300, 10u);
+}
+
+DVM_TEST(ArrayFile_Writer)
+{
+	const char* path = "DVM_ArrayFile_Test_Writer.dvma";
+	std::vector<DVM::Vec4f> elements = RandomElements<DVM::Vec4f>(1000, 7u);
+
+	DVM::ArrayFileWriter<DVM::Vec4f> writer;
+	DVM_CHECK(writer.Open(path));
+	for (size_t first = 0; first < elements.size(); first += 333)
+		DVM_CHECK(writer.Append(elements.data() + first, first + 333 < elements.size() ? 333 : elements.size() - first));
+	DVM_CHECK(writer.Size() == elements.size());
+	DVM_CHECK(writer.Close());
+
+	DVM::MappedArray<DVM::Vec4f> mapped;
+	DVM_CHECK(mapped.Open(path));
+	DVM_CHECK(mapped.Size() == elements.size() && DVM::Test::BitEqual(mapped.Data(), elements.data(), elements.size()));
+	mapped.Close();
+	std::remove(path);
+}
+
+DVM_TEST(ArrayFile_Rejects)
+{
+	const char* path = "DVM_ArrayFile_Test_Rejects.dvma";
+	std::vector<DVM::Vec3f> elements = RandomElements<DVM::Vec3f>(100, 8u);
+	DVM_CHECK(DVM::WriteArrayFile(path, elements.data(), elements.size()));
+
+	//The element type of the file must match exactly
+	DVM::MappedArray<DVM::Vec3d> wrongScalar;
+	DVM::MappedArray<DVM::Vec4f> wrongShape;
+	DVM::ArrayFileReader<DVM::MatTemplate<float, 3, 1>> wrongKind;
+	DVM_CHECK(!wrongScalar.Open(path));
+	DVM_CHECK(!wrongShape.Open(path));
+	DVM_CHECK(!wrongKind.Open(path));
+
+	//Half and BFloat16 have the same size but are different scalars
+	std::vector<DVM::Vec2h> halves = RandomElements<DVM::Vec2h>(10, 11u);
+	DVM_CHECK(DVM::WriteArrayFile(path, halves.data(), halves.size()));
+	DVM::MappedArray<DVM::Vec2bf> wrongHalf;
+	DVM::MappedArray<DVM::VecTemplate<unsigned short, 2>> wrongBits;
+	DVM_CHECK(!wrongHalf.Open(path));
+	DVM_CHECK(!wrongBits.Open(path));
+	DVM_CHECK(DVM::WriteArrayFile(path, elements.data(), elements.size()));
+
+	//Elements must start on a 64 byte boundary, dataOffset is the uint64_t at byte 32 of the header
+	{
+		std::FILE* file = std::fopen(path, "rb");
+		std::vector<unsigned char> bytes(64 + elements.size() * sizeof(DVM::Vec3f));
+		DVM_CHECK(file && std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size());
+		if (file) std::fclose(file);
+
+		uint64_t offsets[] = { 65, 128 }, count = 10;
+		for (uint64_t offset : offsets)
+		{
+			std::memcpy(bytes.data() + 32, &offset, sizeof(offset));
+			std::memcpy(bytes.data() + 24, &count, sizeof(count));
+			file = std::fopen(path, "wb");
+			DVM_CHECK(file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+			if (file) std::fclose(file);
+
+			DVM::MappedArray<DVM::Vec3f> mapped;
+			DVM::ArrayFileReader<DVM::Vec3f> reader;
+			DVM_CHECK(mapped.Open(path) == (offset == 128) && reader.Open(path) == (offset == 128));
+		}
+	}
+	DVM_CHECK(DVM::WriteArrayFile(path, elements.data(), elements.size()));
+
+	//A file cut short fails to map instead of exposing elements past its end
+	{
+		std::FILE* file = std::fopen(path, "rb");
+		std::vector<unsigned char> bytes(64 + 50 * sizeof(DVM::Vec3f));
+		DVM_CHECK(file && std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size());
+		if (file) std::fclose(file);
+
+		file = std::fopen(path, "wb");
+		DVM_CHECK(file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size());
+		if (file) std::fclose(file);
+	}
+
+	DVM::MappedArray<DVM::Vec3f> truncated;
+	DVM_CHECK(!truncated.Open(path));
+	std::remove(path);
+
+	DVM::MappedArray<DVM::Vec3f> missing;
+	DVM::ArrayFileReader<DVM::Vec3f> missingReader;
+	DVM_CHECK(!missing.Open("DVM_ArrayFile_Test_Missing.dvma"));
+	DVM_CHECK(!missingReader.Open("DVM_ArrayFile_Test_Missing.dvma"));
+}
@@ -0,0 +1,105 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "Test.h"
+#include "../Headers/Matrix_Math.h"
+#include "../Headers/Vector_Math.h"
+
+//The elementwise operators give the same values with and without DVM_EXPRESSION_TEMPLATES, both builds run
+//these tests. Expected values are written out per element; the compiler may contract a * s + b differently
+//there, so results are compared to a few ULP of the largest term
+namespace
+{
+	template<typename T>
+	void Fill(T* data, size_t count, uint32_t seed)
+	{
+		for (size_t i = 0; i < count; ++i)
+			data[i] = DVM::Test::Random<T>(seed, -100., 100.);
+	}
+
+	template<typename T>
+	double Tolerance() { return 4. * std::numeric_limits<T>::epsilon() * 1e4; }
+
+	//a * s + b * t - c, (a - b) / s and a * b / c + s for one operand type, vectors or matrices
+	template<typename Operand>
+	void CheckOperand(DVM::Test::State& state, uint32_t seed)
+	{
+		using T = typename DVM::Detail::ExpressionTraits<Operand>::Value;
+		constexpr size_t Count = sizeof(Operand) / sizeof(T);
+
+		Operand a, b, c;
+		Fill(a.data, Count, seed);
+		Fill(b.data, Count, seed + 1);
+		Fill(c.data, Count, seed + 2);
+		for (size_t i = 0; i < Count; ++i)
+			c.data[i] = std::fabs(c.data[i]) + T(1);
+		T s = T(1.5), t = T(-0.25);
+
+		Operand combined = a * s + b * t - c;
+		Operand quotient = (a - b) / s;
+		Operand product = a * b / c + s;
+		Operand left = s * a;
+		for (size_t i = 0; i < Count; ++i)
+		{
+			DVM_CHECK_NEAR(combined.data[i], a.data[i] * s + b.data[i] * t - c.data[i], Tolerance<T>());
+			DVM_CHECK_NEAR(quotient.data[i], (a.data[i] - b.data[i]) / s, Tolerance<T>());
+			DVM_CHECK_NEAR(product.data[i], a.data[i] * b.data[i] / c.data[i] + s, Tolerance<T>());
+			DVM_CHECK(left.data[i] == s * a.data[i]);
+		}
+
+		//The result may be one of the operands, each element is read before it is written
+		Operand aliased = a;
+		aliased = b - aliased * s + aliased;
+		for (size_t i = 0; i < Count; ++i)
+			DVM_CHECK_NEAR(aliased.data[i], b.data[i] - a.data[i] * s + a.data[i], Tolerance<T>());
+	}
+
+	//Evaluated by the compiler the expression is built and assigned like at runtime
+	constexpr DVM::Vec3f Combine(const DVM::Vec3f& a, const DVM::Vec3f& b)
+	{
+		DVM::Vec3f result = a * 2.f + b;
+		result = result - a / 4.f;
+		return result;
+	}
+}
+
+DVM_TEST(Expression_Vector)
+{
+	CheckOperand<DVM::Vec3f>(state, 1u);
+	CheckOperand<DVM::Vec4f>(state, 4u);
+	CheckOperand<DVM::Vec4d>(state, 7u);
+	CheckOperand<DVM::VecTemplate<double, 2>>(state, 10u);
+	CheckOperand<DVM::VecTemplate<int, 3>>(state, 13u);
+}
+
+//4x4 takes the unrolled path, 5x4 the loop past ExpressionUnrollLimit
+DVM_TEST(Expression_Matrix)
+{
+	CheckOperand<DVM::MatTemplate<float, 4, 4>>(state, 20u);
+	CheckOperand<DVM::MatTemplate<double, 3, 3>>(state, 23u);
+	CheckOperand<DVM::MatTemplate<double, 5, 4>>(state, 26u);
+}
+
+DVM_TEST(Expression_Eval)
+{
+	DVM::Vec3f a(3.f, 0.f, 0.f), b(0.f, 4.f, 0.f);
+	DVM_CHECK(DVM::Length(DVM::Eval(a + b)) == 5.f);
+	DVM_CHECK(DVM::Dot(DVM::Eval(a * 2.f), b + a) == 18.f);
+
+	auto sum = a + b;
+#if defined(DVM_EXPRESSION_TEMPLATES)
+	DVM_CHECK(DVM::Detail::IsExpression_v<decltype(sum)>);
+#else
+	DVM_CHECK((DVTL::Is_same_v<decltype(sum), DVM::Vec3f>));
+#endif
+	DVM_CHECK((DVTL::Is_same_v<decltype(DVM::Eval(sum)), DVM::Vec3f>));
+}
+
+DVM_TEST(Expression_Constexpr)
+{
+	constexpr DVM::Vec3f compiled = Combine(DVM::Vec3f(1.f, 2.f, 4.f), DVM::Vec3f(0.5f, 0.25f, -1.f));
+	DVM::Vec3f runtime = Combine(DVM::Vec3f(1.f, 2.f, 4.f), DVM::Vec3f(0.5f, 0.25f, -1.f));
+	DVM_CHECK(DVM::Test::BitEqual(compiled.data, runtime.data, 3));
+	DVM_CHECK(compiled[0] == 2.25f && compiled[1] == 3.75f && compiled[2] == 6.f);
+}
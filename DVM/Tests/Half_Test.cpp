@@ -0,0 +1,212 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/Half.h"
+#include "../Headers/Matrix_Math.h"
+
+//Half and BFloat16 conversions. Every 16 bit pattern is widened and compared with a decoding written out here,
+//narrowing is checked to pick the nearest value, ties to even, over a sample of all float bit patterns.
+//With F16C both directions are also compared with the hardware instructions
+namespace
+{
+	float FloatFromBits(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	uint32_t BitsFromFloat(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	//Decodes sign, 5 exponent and 10 mantissa bits with ldexp, independent of the header's bit tricks
+	double HalfValue(uint16_t bits)
+	{
+		int exponent = (bits >> 10) & 0x1F;
+		int mantissa = bits & 0x3FF;
+		double magnitude;
+		if (exponent == 0x1F) magnitude = mantissa ? std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::infinity();
+		else if (exponent == 0) magnitude = std::ldexp(mantissa, -24);
+		else magnitude = std::ldexp(mantissa + 1024, exponent - 25);
+		return bits & 0x8000 ? -magnitude : magnitude;
+	}
+
+	double BFloat16Value(uint16_t bits) { return FloatFromBits(static_cast<uint32_t>(bits) << 16); }
+
+	//result is the encoding nearest to value among its neighbours, on a tie the one with an even mantissa.
+	//decode turns an encoding into its value, maxFinite is the largest finite encoding
+	template<typename Decode>
+	bool IsNearest(float value, uint16_t result, Decode decode, uint16_t maxFinite)
+	{
+		uint16_t sign = BitsFromFloat(value) & 0x80000000u ? 0x8000 : 0;
+		uint16_t magnitude = result & 0x7FFF;
+
+		if (std::isnan(value)) return magnitude > maxFinite + 1;
+		if ((result & 0x8000) != sign) return false;
+
+		double target = std::fabs(static_cast<double>(value));
+		double infinityDistance = target - decode(maxFinite);
+		double ulpAtMax = decode(maxFinite) - decode(static_cast<uint16_t>(maxFinite - 1));
+
+		//Overflow: infinity once value is at least half an ULP above the largest finite value
+		if (magnitude == maxFinite + 1) return infinityDistance >= ulpAtMax / 2 && (infinityDistance > ulpAtMax / 2 || (maxFinite & 1));
+		if (magnitude > maxFinite) return false;
+
+		double distance = std::fabs(target - decode(magnitude));
+		if (magnitude > 0 && std::fabs(target - decode(static_cast<uint16_t>(magnitude - 1))) < distance) return false;
+		if (magnitude < maxFinite && std::fabs(target - decode(static_cast<uint16_t>(magnitude + 1))) < distance) return false;
+		if (magnitude == maxFinite && infinityDistance > ulpAtMax / 2) return false;
+
+		//A tie with a neighbour goes to the even encoding
+		bool tie = (magnitude > 0 && std::fabs(target - decode(static_cast<uint16_t>(magnitude - 1))) == distance) ||
+			(magnitude < maxFinite && std::fabs(target - decode(static_cast<uint16_t>(magnitude + 1))) == distance);
+		return !tie || (magnitude & 1) == 0;
+	}
+
+	//Every 97th float bit pattern, with the special values and the rounding boundaries of both formats
+	std::vector<float> FloatSample()
+	{
+		std::vector<float> result;
+		for (uint64_t bits = 0; bits < (uint64_t(1) << 32); bits += 97)
+			result.push_back(FloatFromBits(static_cast<uint32_t>(bits)));
+
+		for (float value : { 0.f, -0.f, 65504.f, 65519.f, 65520.f, -65520.f, 6.1035156e-05f, 5.9604645e-08f, 2.9802322e-08f,
+			2.9802326e-08f, 1.f + 1.f / 2048.f, 1.f + 3.f / 2048.f, std::numeric_limits<float>::infinity(),
+			-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::max(),
+			std::numeric_limits<float>::denorm_min(), 1.f + 1.f / 256.f, 1.f + 3.f / 256.f })
+			result.push_back(value);
+		return result;
+	}
+}
+
+DVM_TEST(Half_ToFloat)
+{
+	size_t mismatches = 0;
+	for (uint32_t bits = 0; bits < 0x10000; ++bits)
+	{
+		float value = DVM::Half::FromBits(static_cast<uint16_t>(bits));
+		double expected = HalfValue(static_cast<uint16_t>(bits));
+		bool equal = std::isnan(expected) ? std::isnan(value) : static_cast<double>(value) == expected && std::signbit(value) == std::signbit(expected);
+		mismatches += !equal;
+	}
+	DVM_CHECK(mismatches == 0);
+}
+
+DVM_TEST(Half_FromFloat)
+{
+	size_t mismatches = 0;
+	for (float value : FloatSample())
+		mismatches += !IsNearest(value, DVM::Half(value).bits, HalfValue, 0x7BFF);
+	DVM_CHECK(mismatches == 0);
+
+	DVM_CHECK(DVM::Half(65520.f).bits == 0x7C00);
+	DVM_CHECK(DVM::Half(65519.f).bits == 0x7BFF);
+	DVM_CHECK(DVM::Half(-0.f).bits == 0x8000);
+	DVM_CHECK(DVM::Half(2.9802322e-08f).bits == 0x0000);
+	DVM_CHECK(DVM::Half(2.9802326e-08f).bits == 0x0001);
+}
+
+DVM_TEST(Half_BFloat16)
+{
+	size_t mismatches = 0;
+	for (uint32_t bits = 0; bits < 0x10000; ++bits)
+	{
+		float value = DVM::BFloat16::FromBits(static_cast<uint16_t>(bits));
+		double expected = BFloat16Value(static_cast<uint16_t>(bits));
+		mismatches += std::isnan(expected) ? !std::isnan(value) : BitsFromFloat(value) != static_cast<uint32_t>(bits) << 16;
+	}
+	DVM_CHECK(mismatches == 0);
+
+	mismatches = 0;
+	for (float value : FloatSample())
+		mismatches += !IsNearest(value, DVM::BFloat16(value).bits, BFloat16Value, 0x7F7F);
+	DVM_CHECK(mismatches == 0);
+
+	//A NaN stays a NaN, even one whose payload lives only in the dropped bits
+	DVM_CHECK(std::isnan(static_cast<float>(DVM::BFloat16(FloatFromBits(0x7F800001u)))));
+}
+
+#if defined(DVM_SIMD_F16C)
+DVM_TEST(Half_Hardware)
+{
+	size_t mismatches = 0;
+	for (uint32_t bits = 0; bits < 0x10000; ++bits)
+	{
+		float hardware = _cvtsh_ss(static_cast<unsigned short>(bits));
+		float value = DVM::Half::FromBits(static_cast<uint16_t>(bits));
+		mismatches += std::isnan(hardware) ? !std::isnan(value) : BitsFromFloat(hardware) != BitsFromFloat(value);
+	}
+	DVM_CHECK(mismatches == 0);
+
+	mismatches = 0;
+	for (float value : FloatSample())
+	{
+		uint16_t hardware = static_cast<uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+		uint16_t bits = DVM::Half(value).bits;
+		mismatches += std::isnan(value) ? (bits & 0x7C00) != 0x7C00 || !(bits & 0x03FF) : bits != hardware;
+	}
+	DVM_CHECK(mismatches == 0);
+}
+#endif
+
+//The batch paths against the element conversions, counts that leave a tail after every vector width
+DVM_TEST(Half_Batch)
+{
+	std::vector<float> sample = FloatSample();
+	sample.resize(100003);
+	size_t count = sample.size();
+
+	std::vector<DVM::Half> halves(count);
+	std::vector<DVM::BFloat16> brains(count);
+	std::vector<float> back(count);
+
+	DVM::ToHalfBatch(sample.data(), halves.data(), count);
+	size_t mismatches = 0;
+	for (size_t i = 0; i < count; ++i)
+		mismatches += halves[i].bits != DVM::Half(sample[i]).bits && !std::isnan(sample[i]);
+	DVM_CHECK(mismatches == 0);
+
+	DVM::ToFloatBatch(halves.data(), back.data(), count);
+	mismatches = 0;
+	for (size_t i = 0; i < count; ++i)
+		mismatches += BitsFromFloat(back[i]) != BitsFromFloat(static_cast<float>(halves[i]));
+	DVM_CHECK(mismatches == 0);
+
+	DVM::ToBFloat16Batch(sample.data(), brains.data(), count);
+	mismatches = 0;
+	for (size_t i = 0; i < count; ++i)
+		mismatches += brains[i].bits != DVM::BFloat16(sample[i]).bits;
+	DVM_CHECK(mismatches == 0);
+
+	DVM::ToFloatBatch(brains.data(), back.data(), count);
+	mismatches = 0;
+	for (size_t i = 0; i < count; ++i)
+		mismatches += BitsFromFloat(back[i]) != static_cast<uint32_t>(brains[i].bits) << 16;
+	DVM_CHECK(mismatches == 0);
+}
+
+DVM_TEST(Half_Arithmetic)
+{
+	DVM::Vec4h a(DVM::Half(1.5f), DVM::Half(-2.f), DVM::Half(0.25f), DVM::Half(2048.f));
+	DVM::Vec4h b(DVM::Half(0.5f), DVM::Half(4.f), DVM::Half(-0.75f), DVM::Half(1.f));
+	DVM::Vec4h sum = a + b;
+	DVM::Vec4h product = a * DVM::Half(2.f);
+
+	DVM_CHECK(static_cast<float>(sum[0]) == 2.f && static_cast<float>(sum[1]) == 2.f && static_cast<float>(sum[2]) == -0.5f);
+	//Halves above 2048 are two apart, 2049 rounds to the even neighbour 2048
+	DVM_CHECK(static_cast<float>(sum[3]) == 2048.f);
+	DVM_CHECK(static_cast<float>(product[3]) == 4096.f);
+
+	DVM::Mat2bf mat(DVM::BFloat16(2.f));
+	DVM::Vec2bf vec(DVM::BFloat16(3.f), DVM::BFloat16(-1.f));
+	DVM::Vec2bf scaled = DVM::linearTransformation(mat, vec);
+	DVM_CHECK(static_cast<float>(scaled[0]) == 6.f && static_cast<float>(scaled[1]) == -2.f);
+}
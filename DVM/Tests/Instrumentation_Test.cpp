@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/Math.h"
+
+//The counters of Instrumentation.h when DVM_INSTRUMENTATION is defined, the macros as bare operands when it is not.
+//Math.h includes it. Records are process wide, each test resets them and only looks at functions of this file and Sqrt
+namespace
+{
+	constexpr int Inner(int value)
+	{
+		DVM_INSTRUMENT_ITERATIONS(5);
+		return value + 1;
+	}
+
+	//The call of Inner is counted against Outer together with Inner's iterations, Outer's own iterations go to
+	//the call measured in Measured
+	constexpr int Outer(int value)
+	{
+		int result = DVM_INSTRUMENT_CALL(Inner(value));
+		DVM_INSTRUMENT_ITERATIONS(2);
+		return 2 * result;
+	}
+
+	inline int Measured(int value) { return DVM_INSTRUMENT_CALL(Outer(value)); }
+
+#if defined(DVM_INSTRUMENTATION)
+	//Entry of the first function whose signature contains name, zeroes if it was not called
+	DVM::Instrumentation::Entry Find(const char* name)
+	{
+		for (const DVM::Instrumentation::Entry& entry : DVM::Instrumentation::Snapshot())
+			if (std::strstr(entry.function, name))
+				return entry;
+		return { name, 0, 0, 0 };
+	}
+#endif
+}
+
+DVM_TEST(Instrumentation_Operand)
+{
+	DVM_CHECK(Measured(3) == 8);
+	DVM_CHECK(DVM_INSTRUMENT_CALL(Inner(1) + Inner(2)) == 5);
+
+	//Not recorded in a constant expression, the functions stay constexpr
+	constexpr int compiled = Outer(10);
+	DVM_CHECK(compiled == 22);
+}
+
+#if defined(DVM_INSTRUMENTATION)
+DVM_TEST(Instrumentation_Counters)
+{
+	DVM::Instrumentation::Reset();
+	for (int i = 0; i < 10; ++i)
+		Measured(i);
+
+	DVM::Instrumentation::Entry measured = Find("Measured(");
+	DVM::Instrumentation::Entry outer = Find("Outer(");
+	DVM_CHECK(measured.calls == 10 && measured.iterations == 20);
+	DVM_CHECK(outer.calls == 10 && outer.iterations == 50);
+	DVM_CHECK(Find("Inner(").calls == 0);
+
+	//Nested calls are part of the cycles of the enclosing call
+	DVM_CHECK(measured.cycles >= outer.cycles);
+
+	//Iterations outside any measured call are dropped
+	DVM_INSTRUMENT_ITERATIONS(100);
+	DVM_CHECK(Find("Measured(").iterations == 20 && Find("Outer(").iterations == 50);
+
+	DVM::Instrumentation::Reset();
+	DVM_CHECK(Find("Outer(").calls == 0);
+	DVM_CHECK(DVM::Sqrt(2.) > 1.41 && Find("Sqrt(").calls == 1);
+}
+
+DVM_TEST(Instrumentation_Threads)
+{
+	DVM::Instrumentation::Reset();
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([] { for (int i = 0; i < 1000; ++i) Measured(i); });
+
+	//Reports may be taken while other threads count
+	std::ostringstream stream;
+	DVM::Instrumentation::Report(stream);
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	DVM_CHECK(Find("Measured(").calls == 4000 && Find("Measured(").iterations == 8000);
+	DVM_CHECK(Find("Outer(").calls == 4000 && Find("Outer(").iterations == 20000);
+
+	stream.str("");
+	DVM::Instrumentation::Report(stream);
+	std::string report = stream.str();
+	DVM_CHECK(report.find("iterations") != std::string::npos && report.find("Outer(") != std::string::npos);
+	DVM_CHECK(report.find("4000") != std::string::npos);
+}
+#endif
@@ -0,0 +1,366 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/Math.h"
+#include "../Headers/Math_Batch.h"
+#include "../Headers/Vector_Math.h"
+
+//Accuracy of the scalar and batch functions against the C library evaluated in long double, rounded once to T.
+//Where long double is double (MSVC) the reference itself can be half an ULP off, double bounds get one ULP slack
+namespace
+{
+	template<typename T>
+	constexpr double ReferenceSlack() { return sizeof(T) < sizeof(long double) ? 0. : 1.; }
+
+	template<typename T>
+	T FromBits(uint64_t bits)
+	{
+		T value;
+		if constexpr (sizeof(T) == 4) { uint32_t narrow = static_cast<uint32_t>(bits); std::memcpy(&value, &narrow, 4); }
+		else std::memcpy(&value, &bits, 8);
+		return value;
+	}
+
+	//count positive values with bit patterns spread evenly over [first, last)
+	template<typename T>
+	std::vector<T> BitRange(uint64_t first, uint64_t last, size_t count)
+	{
+		std::vector<T> result;
+		uint64_t step = (last - first) / count + 1;
+		for (uint64_t bits = first; bits < last; bits += step)
+			result.push_back(FromBits<T>(bits));
+		return result;
+	}
+
+	template<typename T>
+	std::vector<T> Uniform(uint32_t seed, double low, double high, size_t count)
+	{
+		std::vector<T> result(count);
+		for (T& value : result)
+			value = DVM::Test::Random<T>(seed, low, high);
+		return result;
+	}
+
+	template<typename T>
+	uint64_t InfinityBits() { return sizeof(T) == 4 ? 0x7F800000ull : 0x7FF0000000000000ull; }
+
+	template<typename T>
+	uint64_t NormalBits() { return sizeof(T) == 4 ? 0x00800000ull : 0x0010000000000000ull; }
+
+	template<typename T>
+	void CheckSqrt(DVM::Test::State& state, uint64_t first, uint64_t last)
+	{
+		for (T value : BitRange<T>(first, last, 100000))
+			DVM_CHECK_ULP(DVM::Sqrt(value), static_cast<T>(std::sqrt(static_cast<long double>(value))), 1. + ReferenceSlack<T>());
+	}
+
+	template<typename T>
+	void CheckExpLog(DVM::Test::State& state)
+	{
+		double expRange = sizeof(T) == 4 ? 87. : 700.;
+		for (T value : Uniform<T>(11u, -expRange, expRange, 100000))
+		{
+			DVM_CHECK_ULP(DVM::Exp(value), static_cast<T>(std::exp(static_cast<long double>(value))), 1. + ReferenceSlack<T>());
+			DVM_CHECK_ULP(DVM::Exp2(value), static_cast<T>(std::exp2(static_cast<long double>(value))), 1. + ReferenceSlack<T>());
+		}
+
+		for (T value : BitRange<T>(1, InfinityBits<T>(), 100000))
+		{
+			DVM_CHECK_ULP(DVM::Log(value), static_cast<T>(std::log(static_cast<long double>(value))), 1. + ReferenceSlack<T>());
+			DVM_CHECK_ULP(DVM::Log2(value), static_cast<T>(std::log2(static_cast<long double>(value))), 2. + ReferenceSlack<T>());
+		}
+	}
+
+	//Bases spread over the exponent range and bases next to 1, exponents chosen so that |exp * ln(base)| covers the
+	//whole range of finite results. Large exponents multiply any error in ln(base)
+	template<typename T>
+	void CheckPow(DVM::Test::State& state)
+	{
+		double logRange = sizeof(T) == 4 ? 87. : 700.;
+		uint32_t seed = 41u;
+		size_t checked = 0;
+		for (size_t i = 0; i < 100000; ++i)
+		{
+			double logBase = i % 3 == 0 ? DVM::Test::Random<double>(seed, -1e-3, 1e-3) : DVM::Test::Random<double>(seed, -logRange, logRange);
+			T base = static_cast<T>(std::exp(logBase));
+			T exp = static_cast<T>(DVM::Test::Random<double>(seed, -logRange, logRange) / std::log(static_cast<double>(base)));
+			T expected = static_cast<T>(std::pow(static_cast<long double>(base), static_cast<long double>(exp)));
+			if (!(base > T(0)) || expected < std::numeric_limits<T>::min() || std::isinf(expected) || std::isinf(exp)) continue;
+
+			DVM_CHECK_ULP(DVM::Pow(base, exp), expected, 1. + ReferenceSlack<T>());
+			++checked;
+		}
+		DVM_CHECK(checked > 90000);
+
+		DVM_CHECK(DVM::Pow(T(7), T(0)) == T(1));
+		DVM_CHECK(DVM::Pow(T(0), T(3)) == T(0));
+		DVM_CHECK(DVM::Pow(T(1), std::numeric_limits<T>::quiet_NaN()) == T(1));
+		DVM_CHECK(DVM::Pow(T(1), std::numeric_limits<T>::infinity()) == T(1));
+		DVM_CHECK(std::isnan(DVM::Pow(T(2), std::numeric_limits<T>::quiet_NaN())));
+		DVM_CHECK(DVM::Pow(T(2), T(0.5) * std::numeric_limits<T>::max()) == std::numeric_limits<T>::infinity());
+		DVM_CHECK(DVM::Pow(T(2), -T(0.5) * std::numeric_limits<T>::max()) == T(0));
+		DVM_CHECK_ULP(DVM::Pow(T(2), T(10.5)), static_cast<T>(std::pow(2.L, 10.5L)), 1);
+		DVM_CHECK_ULP(DVM::Pow(std::numeric_limits<T>::denorm_min(), T(-0.0625)), static_cast<T>(std::pow(static_cast<long double>(std::numeric_limits<T>::denorm_min()), -0.0625L)), 1);
+	}
+
+	//Halfway cases, signed zeros, values next to the integral threshold 2^(digits - 1) and far above it
+	template<typename T>
+	std::vector<T> RoundingInputs()
+	{
+		T threshold = std::ldexp(T(1), std::numeric_limits<T>::digits - 1);
+		std::vector<T> result = {
+			T(0), -T(0), T(0.5), T(-0.5), T(1.5), T(-1.5), T(2.5), T(-2.5), T(-0.25), T(-0.75), T(-1), T(-1e-30),
+			threshold, -threshold, threshold - T(0.5), -(threshold - T(0.5)), threshold + T(1), -(threshold + T(1)),
+			std::ldexp(T(1), 63), -std::ldexp(T(1), 63), std::ldexp(T(1.5), 63), -std::ldexp(T(1.5), 64), std::ldexp(T(1), 100),
+			-std::ldexp(T(1), 100), std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(),
+			std::numeric_limits<T>::denorm_min(), -std::numeric_limits<T>::denorm_min(),
+			std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity() };
+
+		std::vector<T> random = Uniform<T>(23u, -1e6, 1e6, 4096);
+		result.insert(result.end(), random.begin(), random.end());
+		return result;
+	}
+
+	template<typename T>
+	void CheckRounding(DVM::Test::State& state)
+	{
+		std::vector<T> inputs = RoundingInputs<T>();
+		for (T value : inputs)
+		{
+			DVM_CHECK_ULP(DVM::Floor(value), std::floor(value), 0);
+			DVM_CHECK_ULP(DVM::Ceil(value), std::ceil(value), 0);
+			//std::nearbyint rounds halfway cases to even in the default rounding mode
+			DVM_CHECK_ULP(DVM::Round(value), std::nearbyint(value), 0);
+			DVM_CHECK(std::signbit(DVM::Floor(value)) == std::signbit(std::floor(value)));
+			DVM_CHECK(std::signbit(DVM::Ceil(value)) == std::signbit(std::ceil(value)));
+		}
+
+		std::vector<T> output(inputs.size());
+		DVM::FloorBatch(inputs.data(), output.data(), inputs.size());
+		for (size_t i = 0; i < inputs.size(); ++i)
+			DVM_CHECK_ULP(output[i], std::floor(inputs[i]), 0);
+
+		DVM::CeilBatch(inputs.data(), output.data(), inputs.size());
+		for (size_t i = 0; i < inputs.size(); ++i)
+			DVM_CHECK_ULP(output[i], std::ceil(inputs[i]), 0);
+
+		DVM::RoundBatch(inputs.data(), output.data(), inputs.size());
+		for (size_t i = 0; i < inputs.size(); ++i)
+			DVM_CHECK_ULP(output[i], std::nearbyint(inputs[i]), 0);
+	}
+
+	//Batch results against the scalar functions, within one ULP as Math_Batch.h states
+	template<typename T>
+	void CheckBatch(DVM::Test::State& state)
+	{
+		double expRange = sizeof(T) == 4 ? 80. : 700.;
+		std::vector<T> expInputs = Uniform<T>(31u, -expRange, expRange, 4099);
+		std::vector<T> positive = BitRange<T>(1, InfinityBits<T>(), 4099);
+		std::vector<T> output(4099);
+
+		DVM::ExpBatch(expInputs.data(), output.data(), expInputs.size());
+		for (size_t i = 0; i < expInputs.size(); ++i)
+			DVM_CHECK_ULP(output[i], DVM::Exp(expInputs[i]), 1);
+
+		DVM::LogBatch(positive.data(), output.data(), positive.size());
+		for (size_t i = 0; i < positive.size(); ++i)
+			DVM_CHECK_ULP(output[i], DVM::Log(positive[i]), 1);
+
+		DVM::SqrtBatch(positive.data(), output.data(), positive.size());
+		for (size_t i = 0; i < positive.size(); ++i)
+			DVM_CHECK_ULP(output[i], DVM::Sqrt(positive[i]), 1);
+
+		//Pow inputs as in CheckPow, then the special values of the scalar Pow
+		uint32_t seed = 37u;
+		std::vector<T> bases, exps;
+		for (size_t i = 0; i < 4099; ++i)
+		{
+			double logBase = i % 3 == 0 ? DVM::Test::Random<double>(seed, -1e-3, 1e-3) : DVM::Test::Random<double>(seed, -expRange, expRange);
+			T base = static_cast<T>(std::exp(logBase));
+			bases.push_back(base);
+			exps.push_back(static_cast<T>(DVM::Test::Random<double>(seed, -expRange, expRange) / std::log(static_cast<double>(base))));
+		}
+		T nan = std::numeric_limits<T>::quiet_NaN(), infinity = std::numeric_limits<T>::infinity();
+		T specialBases[] = { T(1), T(1), T(0), T(2), T(-2), infinity, infinity, nan, T(3), std::numeric_limits<T>::denorm_min() };
+		T specialExps[] = { nan, infinity, T(3), nan, T(1.5), T(2), T(-2), T(1), T(0), T(-0.0625) };
+		bases.insert(bases.end(), std::begin(specialBases), std::end(specialBases));
+		exps.insert(exps.end(), std::begin(specialExps), std::end(specialExps));
+
+		output.resize(bases.size());
+		DVM::PowBatch(bases.data(), exps.data(), output.data(), bases.size());
+		for (size_t i = 0; i < bases.size(); ++i)
+			DVM_CHECK_ULP(output[i], DVM::Pow(bases[i], exps[i]), 1);
+
+		DVM::PowBatch(bases.data(), T(-1.75), output.data(), bases.size());
+		for (size_t i = 0; i < 4099; ++i)
+			DVM_CHECK_ULP(output[i], DVM::Pow(bases[i], T(-1.75)), 1);
+	}
+}
+
+DVM_TEST(Math_Sqrt_Normal)
+{
+	CheckSqrt<float>(state, NormalBits<float>(), InfinityBits<float>());
+	CheckSqrt<double>(state, NormalBits<double>(), InfinityBits<double>());
+}
+
+//The scalar path without SSE2 seeds Newton's method from the exponent bits, subnormals need their own scaling
+DVM_TEST(Math_Sqrt_Subnormal)
+{
+	CheckSqrt<float>(state, 1, NormalBits<float>());
+	CheckSqrt<double>(state, 1, NormalBits<double>());
+
+	DVM_CHECK_ULP(DVM::Sqrt(1e-40f), static_cast<float>(std::sqrt(static_cast<double>(1e-40f))), 1);
+	DVM_CHECK_ULP(DVM::Sqrt(5.19e-312), std::sqrt(5.19e-312), 1);
+	DVM_CHECK(DVM::Sqrt(0.f) == 0.f);
+	DVM_CHECK(DVM::Sqrt(std::numeric_limits<double>::infinity()) == std::numeric_limits<double>::infinity());
+}
+
+DVM_TEST(Math_Sqrt_Constexpr)
+{
+	constexpr double root = DVM::Sqrt(2.);
+	DVM_CHECK_ULP(root, std::sqrt(2.), 1);
+	DVM_CHECK_ULP(DVM::Detail::SqrtNewton(1e-310), std::sqrt(1e-310), 1);
+}
+
+DVM_TEST(Math_ExpLog_float)
+{
+	CheckExpLog<float>(state);
+}
+
+DVM_TEST(Math_ExpLog_double)
+{
+	CheckExpLog<double>(state);
+}
+
+DVM_TEST(Math_ExpLog_Limits)
+{
+	DVM_CHECK(DVM::Exp(1000.) == std::numeric_limits<double>::infinity());
+	DVM_CHECK(DVM::Exp(-1000.) == 0.);
+	DVM_CHECK(DVM::Exp(0.f) == 1.f);
+	DVM_CHECK(DVM::Log(1.) == 0.);
+	DVM_CHECK(std::isnan(DVM::Exp(std::numeric_limits<float>::quiet_NaN())));
+	DVM_CHECK(DVM::Log(std::numeric_limits<double>::infinity()) == std::numeric_limits<double>::infinity());
+}
+
+DVM_TEST(Math_Pow_float)
+{
+	CheckPow<float>(state);
+}
+
+DVM_TEST(Math_Pow_double)
+{
+	CheckPow<double>(state);
+
+	//The rounding error of ln(1.0001) alone would be multiplied by 5e6
+	constexpr double compiled = DVM::Pow(1.0001, 5e6);
+	DVM_CHECK_ULP(compiled, static_cast<double>(std::pow(static_cast<long double>(1.0001), 5e6L)), 1. + ReferenceSlack<double>());
+	DVM_CHECK_ULP(DVM::Pow(1.0001, 5e6), compiled, 0);
+}
+
+//Powers of 3 stay exact in double up to 3^33 and in 64 bit integers up to 3^40, so the squaring chain must give
+//the same value as repeated multiplication
+DVM_TEST(Math_Pow_Integer)
+{
+	double power = 1.;
+	long long integer = 1;
+	for (int k = 0; k <= 33; ++k, power *= 3., integer *= 3)
+	{
+		DVM_CHECK(DVM::Pow(3., k) == power);
+		DVM_CHECK(DVM::Pow(3., -k) == 1. / power);
+		DVM_CHECK(DVM::Pow(3ll, k) == integer);
+		DVM_CHECK(DVM::Pow(-3ll, k) == (k % 2 ? -integer : integer));
+	}
+	DVM_CHECK(DVM::Pow(3ull, 40u) == 12157665459056928801ull);
+	DVM_CHECK(DVM::Pow(2.f, -126) == std::numeric_limits<float>::min());
+
+	//The minimum of a signed exponent has no positive counterpart
+	DVM_CHECK(DVM::Pow(2., std::numeric_limits<int>::min()) == 0.);
+	DVM_CHECK(DVM::Pow(-1., std::numeric_limits<int>::min()) == 1.);
+	DVM_CHECK(DVM::Pow(-1., std::numeric_limits<long long>::max()) == -1.);
+	DVM_CHECK(DVM::Pow(0.5, std::numeric_limits<long long>::min()) == std::numeric_limits<double>::infinity());
+	DVM_CHECK(DVM::Pow(7., 0) == 1. && DVM::Pow(0., 0) == 1.);
+
+	//The relative error grows at most with the exponent, one rounding per multiply doubled by each later squaring
+	uint32_t seed = 61u;
+	for (int i = 0; i < 10000; ++i)
+	{
+		double base = DVM::Test::Random<double>(seed, 0.5, 2.);
+		int exp = DVM::Test::RandomInteger<int>(seed, -300, 300);
+		DVM_CHECK_ULP(DVM::Pow(base, exp), static_cast<double>(std::pow(static_cast<long double>(base), exp)), 2 * std::abs(exp) + 2);
+	}
+
+	constexpr double compiled = DVM::Pow(1.5, -7);
+	DVM_CHECK(compiled == 1. / (1.5 * 1.5 * 1.5 * 1.5 * 1.5 * 1.5 * 1.5));
+}
+
+DVM_TEST(Math_Pow_Static)
+{
+	constexpr double five = DVM::Pow<5>(2.);
+	constexpr double negative = DVM::Pow<-2>(4.);
+	constexpr int integer = DVM::Pow<7>(3);
+	DVM_CHECK(five == 32. && negative == 0.0625 && integer == 2187);
+	DVM_CHECK(DVM::Pow<0>(7.f) == 1.f && DVM::Pow<1>(7.f) == 7.f);
+	DVM_CHECK(DVM::Pow<33>(3.) == DVM::Pow(3., 33));
+	DVM_CHECK(DVM::Pow<-33>(3.) == DVM::Pow(3., -33));
+
+	uint32_t seed = 67u;
+	for (int i = 0; i < 1000; ++i)
+	{
+		double base = DVM::Test::Random<double>(seed, 0.5, 2.);
+		DVM_CHECK_ULP(DVM::Pow<13>(base), static_cast<double>(std::pow(static_cast<long double>(base), 13)), 28);
+		DVM_CHECK_ULP(DVM::Pow<-6>(base), static_cast<double>(std::pow(static_cast<long double>(base), -6)), 14);
+	}
+
+	DVM::Vec3d cube = DVM::Pow<3>(DVM::Vec3d(2., -1., 0.5));
+	DVM_CHECK(cube[0] == 8. && cube[1] == -1. && cube[2] == 0.125);
+}
+
+//One shift, exponents outside [0, digits) give 0 instead of shifting past the width
+DVM_TEST(Math_Exp2_Integral)
+{
+	DVM_CHECK(DVM::Exp2(0) == 1 && DVM::Exp2(10) == 1024 && DVM::Exp2(30) == (1 << 30));
+	DVM_CHECK(DVM::Exp2(31) == 0 && DVM::Exp2(-1) == 0 && DVM::Exp2(1000) == 0);
+	DVM_CHECK(DVM::Exp2(63ull) == (1ull << 63) && DVM::Exp2(64ull) == 0ull);
+	DVM_CHECK(DVM::Exp2(62ll) == (1ll << 62) && DVM::Exp2(63ll) == 0ll);
+	DVM_CHECK(DVM::Exp2(static_cast<uint8_t>(7)) == 128 && DVM::Exp2(static_cast<uint8_t>(8)) == 0);
+
+	constexpr unsigned compiled = DVM::Exp2(31u);
+	DVM_CHECK(compiled == 0x80000000u);
+}
+
+DVM_TEST(Math_Rounding_float)
+{
+	CheckRounding<float>(state);
+}
+
+DVM_TEST(Math_Rounding_double)
+{
+	CheckRounding<double>(state);
+}
+
+DVM_TEST(Math_Rounding_Constexpr)
+{
+	constexpr double floor = DVM::Floor(-2.5);
+	constexpr double ceil = DVM::Ceil(-0.5);
+	constexpr double round = DVM::Round(-2.5);
+	constexpr double large = DVM::Floor(-9.3e18);
+	DVM_CHECK(floor == -3.);
+	DVM_CHECK(ceil == 0. && std::signbit(ceil));
+	DVM_CHECK(round == -2.);
+	DVM_CHECK(large == -9.3e18);
+}
+
+DVM_TEST(Math_Batch_float)
+{
+	CheckBatch<float>(state);
+}
+
+DVM_TEST(Math_Batch_double)
+{
+	CheckBatch<double>(state);
+}
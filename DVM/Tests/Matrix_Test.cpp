@@ -0,0 +1,362 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/DynMatrix_Math.h"
+#include "../Headers/Matrix_Math.h"
+
+//Inverse, Solve, Determinant, the blocked product and the decompositions against references computed here.
+//Operands with small integer entries make products and sums exact, so those compare bit for bit
+namespace
+{
+	//c = a * b for row major a (m x n) and b (n x k), the order of the textbook triple loop
+	template<typename T>
+	std::vector<T> NaiveProduct(const T* a, const T* b, size_t m, size_t n, size_t k)
+	{
+		std::vector<T> c(m * k);
+		for (size_t i = 0; i < m; ++i)
+			for (size_t j = 0; j < k; ++j)
+			{
+				T sum = 0;
+				for (size_t l = 0; l < n; ++l)
+					sum += a[i * n + l] * b[l * k + j];
+				c[i * k + j] = sum;
+			}
+		return c;
+	}
+
+	double RowDot(const double* a, const double* b, size_t n)
+	{
+		double sum = 0.;
+		for (size_t i = 0; i < n; ++i)
+			sum += a[i] * b[i];
+		return sum;
+	}
+
+	//Largest |a * b - I| over the entries of the n x n product
+	template<typename T>
+	double IdentityError(const T* a, const T* b, size_t n)
+	{
+		std::vector<T> product = NaiveProduct(a, b, n, n, n);
+		double error = 0.;
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				error = std::fmax(error, std::fabs(static_cast<double>(product[i * n + j]) - (i == j ? 1. : 0.)));
+		return error;
+	}
+
+	//Diagonally dominant, so every LU step is well conditioned
+	template<typename T>
+	void FillDominant(T* data, size_t n, uint32_t seed)
+	{
+		for (size_t i = 0; i < n * n; ++i)
+			data[i] = DVM::Test::Random<T>(seed, -1., 1.);
+		for (size_t i = 0; i < n; ++i)
+			data[i * n + i] += static_cast<T>(n);
+	}
+
+	//Laplace expansion along the first row, exact for the small integer matrices used here
+	long long ExactDeterminant(const std::vector<long long>& mat, size_t n)
+	{
+		if (n == 1) return mat[0];
+
+		long long result = 0;
+		for (size_t j = 0; j < n; ++j)
+		{
+			std::vector<long long> minor;
+			for (size_t r = 1; r < n; ++r)
+				for (size_t c = 0; c < n; ++c)
+					if (c != j) minor.push_back(mat[r * n + c]);
+
+			long long term = mat[j] * ExactDeterminant(minor, n - 1);
+			result += j % 2 ? -term : term;
+		}
+		return result;
+	}
+
+	template<size_t N>
+	void CheckFixedInverse(DVM::Test::State& state, uint32_t seed)
+	{
+		DVM::MatTemplate<double, N, N> mat;
+		FillDominant(mat.data, N, seed);
+
+		DVM::MatTemplate<double, N, N> inverse = DVM::Inverse(mat);
+		DVM_CHECK_NEAR(IdentityError(mat.data, inverse.data, N), 0., 1e-13);
+		DVM_CHECK_NEAR(IdentityError(inverse.data, mat.data, N), 0., 1e-13);
+
+		//Solve reads mat[j] as column j
+		DVM::VecTemplate<double, N> b;
+		for (size_t i = 0; i < N; ++i)
+			b[i] = DVM::Test::Random<double>(seed, -10., 10.);
+
+		DVM::VecTemplate<double, N> x = DVM::Solve(mat, b);
+		for (size_t i = 0; i < N; ++i)
+		{
+			double sum = 0.;
+			for (size_t j = 0; j < N; ++j)
+				sum += mat[j][i] * x[j];
+			DVM_CHECK_NEAR(sum, b[i], 1e-12);
+		}
+	}
+
+	template<size_t N>
+	void CheckFixedDeterminant(DVM::Test::State& state, uint32_t seed)
+	{
+		DVM::MatTemplate<double, N, N> mat;
+		DVM::MatTemplate<long long, N, N> integral;
+		std::vector<long long> exact(N * N);
+		for (size_t i = 0; i < N * N; ++i)
+		{
+			exact[i] = DVM::Test::RandomInteger<long long>(seed, -5, 5);
+			mat.data[i] = static_cast<double>(exact[i]);
+			integral.data[i] = exact[i];
+		}
+
+		long long expected = ExactDeterminant(exact, N);
+		DVM_CHECK(DVM::Determinant(integral) == expected);
+		DVM_CHECK_NEAR(DVM::Determinant(mat), static_cast<double>(expected), 1e-9 * (1. + std::fabs(static_cast<double>(expected))));
+		DVM_CHECK_NEAR(DVM::Determinant(DVM::DynMatrix<double>(mat)), static_cast<double>(expected), 1e-9 * (1. + std::fabs(static_cast<double>(expected))));
+	}
+
+	template<typename T, size_t M, size_t N, size_t K>
+	void CheckFixedProduct(DVM::Test::State& state, uint32_t seed)
+	{
+		DVM::MatTemplate<T, M, N> a;
+		DVM::MatTemplate<T, N, K> b;
+		for (T& value : a.data) value = DVM::Test::RandomInteger<T>(seed, -8, 8);
+		for (T& value : b.data) value = DVM::Test::RandomInteger<T>(seed, -8, 8);
+
+		DVM::MatTemplate<T, M, K> c = DVM::matrixMultiplication(a, b);
+		DVM_CHECK(DVM::Test::BitEqual(c.data, NaiveProduct(a.data, b.data, M, N, K).data(), M * K));
+	}
+
+	template<typename T>
+	void CheckDynamicProduct(DVM::Test::State& state, size_t m, size_t n, size_t k, uint32_t seed)
+	{
+		DVM::DynMatrix<T> a(m, n);
+		DVM::DynMatrix<T> b(n, k);
+		for (size_t i = 0; i < a.Size(); ++i) a.Data()[i] = DVM::Test::RandomInteger<T>(seed, -8, 8);
+		for (size_t i = 0; i < b.Size(); ++i) b.Data()[i] = DVM::Test::RandomInteger<T>(seed, -8, 8);
+
+		DVM::DynMatrix<T> c = DVM::matrixMultiplication(a, b);
+		DVM_CHECK(c.Columns() == m && c.Rows() == k);
+		DVM_CHECK(DVM::Test::BitEqual(c.Data(), NaiveProduct(a.Data(), b.Data(), m, n, k).data(), m * k));
+	}
+}
+
+DVM_TEST(Matrix_Inverse_Fixed)
+{
+	CheckFixedInverse<2>(state, 1u);
+	CheckFixedInverse<3>(state, 2u);
+	CheckFixedInverse<4>(state, 3u);
+	CheckFixedInverse<5>(state, 4u);
+	CheckFixedInverse<8>(state, 5u);
+}
+
+DVM_TEST(Matrix_Inverse_Singular)
+{
+	DVM::Mat4d fixed;
+	for (size_t i = 0; i < 4; ++i)
+		for (size_t j = 0; j < 4; ++j)
+			fixed[i][j] = static_cast<double>(i + j);
+
+	DVM::MatTemplate<double, 6, 6> large;
+	DVM::DynMatrixd dynamic(6, 6);
+	for (size_t i = 0; i < 6; ++i)
+		for (size_t j = 0; j < 6; ++j)
+			large[i][j] = dynamic[i][j] = static_cast<double>(i * j);
+
+	DVM_CHECK(DVM::Determinant(fixed) == 0.);
+	DVM_CHECK(DVM::Determinant(large) == 0.);
+	DVM_CHECK(DVM::Determinant(dynamic) == 0.);
+
+	DVM::MatTemplate<double, 6, 6> inverse = DVM::Inverse(large);
+	DVM::DynMatrixd dynamicInverse = DVM::Inverse(dynamic);
+	bool zero = true;
+	for (size_t i = 0; i < 36; ++i)
+		zero = zero && inverse.data[i] == 0. && dynamicInverse.Data()[i] == 0.;
+	DVM_CHECK(zero);
+}
+
+DVM_TEST(Matrix_Inverse_Dynamic)
+{
+	for (size_t n : { 1, 3, 17, 64, 100 })
+	{
+		DVM::DynMatrixd mat(n, n);
+		FillDominant(mat.Data(), n, static_cast<uint32_t>(n));
+
+		DVM::DynMatrixd inverse = DVM::Inverse(mat);
+		DVM_CHECK_NEAR(IdentityError(mat.Data(), inverse.Data(), n), 0., 1e-12);
+
+		DVM::DynVectord b(n);
+		uint32_t seed = 77u;
+		for (size_t i = 0; i < n; ++i)
+			b[i] = DVM::Test::Random<double>(seed, -10., 10.);
+
+		DVM::DynVectord x = DVM::Solve(mat, b);
+		DVM::DynVectord product = DVM::linearTransformation(mat, x);
+		double error = 0.;
+		for (size_t i = 0; i < n; ++i)
+			error = std::fmax(error, std::fabs(product[i] - b[i]));
+		DVM_CHECK_NEAR(error, 0., 1e-11);
+	}
+}
+
+DVM_TEST(Matrix_Inverse_float)
+{
+	DVM::DynMatrixf mat(24, 24);
+	FillDominant(mat.Data(), 24, 9u);
+	DVM_CHECK_NEAR(IdentityError(mat.Data(), DVM::Inverse(mat).Data(), 24), 0., 1e-5);
+
+	DVM::MatTemplate<float, 6, 6> fixed;
+	FillDominant(fixed.data, 6, 10u);
+	DVM_CHECK_NEAR(IdentityError(fixed.data, DVM::Inverse(fixed).data, 6), 0., 1e-5);
+}
+
+DVM_TEST(Matrix_Determinant)
+{
+	CheckFixedDeterminant<2>(state, 11u);
+	CheckFixedDeterminant<3>(state, 12u);
+	CheckFixedDeterminant<4>(state, 13u);
+	CheckFixedDeterminant<5>(state, 14u);
+	CheckFixedDeterminant<6>(state, 15u);
+
+	//Unit lower times upper triangular with known diagonal, the determinant is the product of that diagonal.
+	//Off diagonal entries are small multiples of 1/4, exact in binary and well conditioned
+	constexpr size_t n = 40;
+	DVM::DynMatrixd lower(n, n), upper(n, n);
+	uint32_t seed = 16u;
+	double expected = 1.;
+	for (size_t i = 0; i < n; ++i)
+	{
+		lower[i][i] = 1.;
+		upper[i][i] = i % 3 ? 2. : -1.;
+		expected *= upper[i][i];
+		for (size_t j = 0; j < i; ++j)
+			lower[i][j] = DVM::Test::RandomInteger<double>(seed, -1, 1) * 0.25;
+		for (size_t j = i + 1; j < n; ++j)
+			upper[i][j] = DVM::Test::RandomInteger<double>(seed, -1, 1) * 0.25;
+	}
+
+	DVM::DynMatrixd mat = DVM::matrixMultiplication(lower, upper);
+	DVM_CHECK_NEAR(DVM::Determinant(mat), expected, 1e-10 * std::fabs(expected));
+}
+
+DVM_TEST(Matrix_Gemm_Fixed)
+{
+	CheckFixedProduct<double, 7, 5, 9>(state, 21u);
+	CheckFixedProduct<double, 3, 11, 2>(state, 22u);
+	CheckFixedProduct<float, 9, 6, 13>(state, 23u);
+	CheckFixedProduct<int, 5, 8, 7>(state, 24u);
+	CheckFixedProduct<double, 4, 4, 4>(state, 25u);
+}
+
+DVM_TEST(Matrix_Gemm_Dynamic)
+{
+	CheckDynamicProduct<double>(state, 1, 1, 1, 31u);
+	CheckDynamicProduct<double>(state, 37, 53, 29, 32u);
+	CheckDynamicProduct<double>(state, 130, 70, 150, 33u);
+	CheckDynamicProduct<float>(state, 65, 257, 33, 34u);
+	CheckDynamicProduct<float>(state, 3, 300, 5, 35u);
+}
+
+DVM_TEST(Matrix_Cholesky)
+{
+	//a * Transpose(a) + 6I is symmetric positive definite
+	constexpr size_t n = 6;
+	DVM::MatTemplate<double, n, n> a, mat;
+	FillDominant(a.data, n, 41u);
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+		{
+			double sum = i == j ? 6. : 0.;
+			for (size_t k = 0; k < n; ++k)
+				sum += a[i][k] * a[j][k];
+			mat[i][j] = sum;
+		}
+
+	DVM::MatTemplate<double, n, n> lower;
+	DVM_CHECK(DVM::Cholesky(mat, lower));
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+		{
+			double sum = 0.;
+			for (size_t k = 0; k < n; ++k)
+				sum += lower[i][k] * lower[j][k];
+			DVM_CHECK_NEAR(sum, mat[i][j], 1e-10);
+			if (j > i) DVM_CHECK(lower[i][j] == 0.);
+		}
+
+	DVM::VecTemplate<double, n> b(1.);
+	DVM::VecTemplate<double, n> x = DVM::CholeskySolve(mat, b);
+	for (size_t i = 0; i < n; ++i)
+		DVM_CHECK_NEAR(RowDot(mat[i], x.data, n), 1., 1e-12);
+
+	DVM::MatTemplate<double, n, n> indefinite(mat);
+	indefinite[2][2] = -1.;
+	DVM_CHECK(!DVM::Cholesky(indefinite, lower));
+}
+
+DVM_TEST(Matrix_QR)
+{
+	constexpr size_t rows = 7, columns = 4;
+	DVM::MatTemplate<double, rows, columns> mat;
+	uint32_t seed = 51u;
+	for (double& value : mat.data)
+		value = DVM::Test::Random<double>(seed, -1., 1.);
+
+	DVM::MatTemplate<double, rows, rows> q;
+	DVM::MatTemplate<double, rows, columns> r;
+	DVM::QRDecompose(mat, q, r);
+
+	std::vector<double> product = NaiveProduct(q.data, r.data, rows, rows, columns);
+	for (size_t i = 0; i < rows * columns; ++i)
+		DVM_CHECK_NEAR(product[i], mat.data[i], 1e-13);
+
+	for (size_t i = 0; i < rows; ++i)
+		for (size_t j = 0; j < rows; ++j)
+		{
+			double sum = 0.;
+			for (size_t k = 0; k < rows; ++k)
+				sum += q[k][i] * q[k][j];
+			DVM_CHECK_NEAR(sum, i == j ? 1. : 0., 1e-13);
+		}
+
+	for (size_t i = 1; i < rows; ++i)
+		for (size_t j = 0; j < i && j < columns; ++j)
+			DVM_CHECK(r[i][j] == 0.);
+
+	//Consistent system: the least squares solution reproduces it exactly
+	DVM::VecTemplate<double, columns> expected(1., -2., 3., 0.5);
+	DVM::VecTemplate<double, rows> b;
+	for (size_t i = 0; i < rows; ++i)
+		b[i] = RowDot(mat[i], expected.data, columns);
+
+	DVM::VecTemplate<double, columns> x = DVM::LeastSquares(mat, b);
+	for (size_t i = 0; i < columns; ++i)
+		DVM_CHECK_NEAR(x[i], expected[i], 1e-12);
+}
+
+DVM_TEST(Matrix_SymmetricEigen)
+{
+	constexpr size_t n = 5;
+	DVM::MatTemplate<double, n, n> mat;
+	uint32_t seed = 61u;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j <= i; ++j)
+			mat[i][j] = mat[j][i] = DVM::Test::Random<double>(seed, -1., 1.);
+
+	DVM::VecTemplate<double, n> values;
+	DVM::MatTemplate<double, n, n> vectors;
+	DVM_CHECK(DVM::SymmetricEigen(mat, values, vectors));
+
+	for (size_t k = 0; k < n; ++k)
+	{
+		if (k) DVM_CHECK(values[k - 1] <= values[k]);
+		DVM_CHECK_NEAR(RowDot(vectors[k], vectors[k], n), 1., 1e-12);
+
+		for (size_t i = 0; i < n; ++i)
+			DVM_CHECK_NEAR(RowDot(mat[i], vectors[k], n), values[k] * vectors[k][i], 1e-10);
+	}
+}
@@ -0,0 +1,169 @@
+#include <cstdint>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/DynMatrix_Parallel.h"
+#include "../Headers/Matrix_Batch.h"
+#include "../Headers/SparseMatrix_Parallel.h"
+
+//The ThreadPool overloads against their serial versions. Every output element is computed by one thread in the
+//serial order, so results must match bit for bit for any thread count, stealing on or off
+namespace
+{
+	const size_t ThreadCounts[] = { 1, 2, 3, 8 };
+
+	DVM::DynMatrixd RandomMatrix(size_t columns, size_t rows, uint32_t seed, double diagonal = 0.)
+	{
+		DVM::DynMatrixd result(columns, rows);
+		for (size_t i = 0; i < result.Size(); ++i)
+			result.Data()[i] = DVM::Test::Random<double>(seed, -1., 1.);
+		for (size_t i = 0; i < columns && i < rows; ++i)
+			result[i][i] += diagonal;
+		return result;
+	}
+
+	DVM::DynVectord RandomVector(size_t size, uint32_t seed)
+	{
+		DVM::DynVectord result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = DVM::Test::Random<double>(seed, -1., 1.);
+		return result;
+	}
+
+	template<typename F>
+	void ForEachPool(F function)
+	{
+		for (size_t threads : ThreadCounts)
+			for (bool deterministic : { false, true })
+			{
+				DVM::ThreadPool pool(threads);
+				pool.SetDeterministic(deterministic);
+				function(pool);
+			}
+	}
+}
+
+DVM_TEST(Parallel_MatrixMultiplication)
+{
+	//Above ParallelMinWork and not a multiple of the kernel block sizes
+	DVM::DynMatrixd a = RandomMatrix(131, 77, 1u);
+	DVM::DynMatrixd b = RandomMatrix(77, 93, 2u);
+	DVM::DynMatrixd serial = DVM::matrixMultiplication(a, b);
+
+	ForEachPool([&](DVM::ThreadPool& pool)
+	{
+		DVM::DynMatrixd parallel = DVM::matrixMultiplication(pool, a, b);
+		DVM_CHECK(DVM::Test::BitEqual(parallel.Data(), serial.Data(), serial.Size()));
+	});
+}
+
+DVM_TEST(Parallel_InverseSolve)
+{
+	//Above LUBlock, so the blocked factorization runs
+	DVM::DynMatrixd mat = RandomMatrix(150, 150, 3u, 150.);
+	DVM::DynVectord vec = RandomVector(150, 4u);
+
+	DVM::ThreadPool single(1);
+	DVM::DynMatrixd inverse = DVM::Inverse(single, mat);
+	DVM::DynVectord solution = DVM::Solve(single, mat, vec);
+
+	ForEachPool([&](DVM::ThreadPool& pool)
+	{
+		DVM::DynMatrixd parallelInverse = DVM::Inverse(pool, mat);
+		DVM::DynVectord parallelSolution = DVM::Solve(pool, mat, vec);
+		DVM_CHECK(DVM::Test::BitEqual(parallelInverse.Data(), inverse.Data(), inverse.Size()));
+		DVM_CHECK(DVM::Test::BitEqual(parallelSolution.Data(), solution.Data(), solution.Size()));
+	});
+
+	//The blocked factorization rounds differently from the unblocked serial one, but solves the same system
+	DVM::DynVectord serial = DVM::Solve(mat, vec);
+	for (size_t i = 0; i < serial.Size(); ++i)
+		DVM_CHECK_NEAR(solution[i], serial[i], 1e-14);
+}
+
+DVM_TEST(Parallel_TransposeTransform)
+{
+	DVM::DynMatrixd mat = RandomMatrix(300, 517, 5u);
+	DVM::DynVectord vec = RandomVector(300, 6u);
+	DVM::DynMatrixd transpose = DVM::Transpose(mat);
+	DVM::DynVectord transformed = DVM::linearTransformation(mat, vec);
+
+	ForEachPool([&](DVM::ThreadPool& pool)
+	{
+		DVM::DynMatrixd parallelTranspose = DVM::Transpose(pool, mat);
+		DVM::DynVectord parallelTransformed = DVM::linearTransformation(pool, mat, vec);
+		DVM_CHECK(DVM::Test::BitEqual(parallelTranspose.Data(), transpose.Data(), transpose.Size()));
+		DVM_CHECK(DVM::Test::BitEqual(parallelTransformed.Data(), transformed.Data(), transformed.Size()));
+	});
+}
+
+DVM_TEST(Parallel_Batch)
+{
+	constexpr size_t count = 100003;
+	uint32_t seed = 7u;
+	DVM::Mat4f mat;
+	for (float& value : mat.data)
+		value = DVM::Test::Random<float>(seed, -1., 1.);
+
+	std::vector<DVM::Vec4f> in(count);
+	std::vector<DVM::Vec3f> points(count);
+	for (size_t i = 0; i < count; ++i)
+		for (size_t c = 0; c < 4; ++c)
+			in[i][c] = points[i][c % 3] = DVM::Test::Random<float>(seed, -10., 10.);
+
+	std::vector<DVM::Vec4f> serial(count), parallel(count);
+	std::vector<DVM::Vec3f> serialPoints(count), parallelPoints(count);
+	DVM::linearTransformationBatch(mat, in.data(), serial.data(), count);
+	DVM::TransformPointBatch(mat, points.data(), serialPoints.data(), count);
+
+	DVM::VecArray<float, 3> stream(points.data(), count), serialStream, parallelStream;
+	DVM::ProjectPoint(mat, stream, serialStream);
+
+	ForEachPool([&](DVM::ThreadPool& pool)
+	{
+		DVM::linearTransformationBatch(pool, mat, in.data(), parallel.data(), count);
+		DVM::TransformPointBatch(pool, mat, points.data(), parallelPoints.data(), count);
+		DVM::ProjectPoint(pool, mat, stream, parallelStream);
+		DVM_CHECK(DVM::Test::BitEqual(parallel.data(), serial.data(), count));
+		DVM_CHECK(DVM::Test::BitEqual(parallelPoints.data(), serialPoints.data(), count));
+
+		bool equal = parallelStream.Size() == count;
+		for (size_t i = 0; equal && i < count; ++i)
+		{
+			DVM::Vec3f a = parallelStream.Get(i), b = serialStream.Get(i);
+			equal = DVM::Test::BitEqual(a.data, b.data, 3);
+		}
+		DVM_CHECK(equal);
+	});
+}
+
+DVM_TEST(Parallel_Sparse)
+{
+	//Five point Laplacian of a 200 x 200 grid, 200000 non-zeros
+	constexpr size_t side = 200, n = side * side;
+	std::vector<DVM::Triplet<double>> triplets;
+	for (size_t y = 0; y < side; ++y)
+		for (size_t x = 0; x < side; ++x)
+		{
+			size_t i = y * side + x;
+			triplets.push_back({ i, i, 4. });
+			if (x > 0) triplets.push_back({ i, i - 1, -1. });
+			if (x + 1 < side) triplets.push_back({ i, i + 1, -1. });
+			if (y > 0) triplets.push_back({ i, i - side, -1. });
+			if (y + 1 < side) triplets.push_back({ i, i + side, -1. });
+		}
+
+	DVM::CsrMatrixd mat = DVM::CsrMatrixd::FromTriplets(n, n, triplets.data(), triplets.size());
+	DVM::DynVectord vec = RandomVector(n, 8u);
+	DVM::DynMatrixd dense = RandomMatrix(3, n, 9u);
+	DVM::DynVectord serial = DVM::linearTransformation(mat, vec);
+	DVM::DynMatrixd serialProduct = DVM::matrixMultiplication(mat, dense);
+
+	ForEachPool([&](DVM::ThreadPool& pool)
+	{
+		DVM::DynVectord parallel = DVM::linearTransformation(pool, mat, vec);
+		DVM::DynMatrixd parallelProduct = DVM::matrixMultiplication(pool, mat, dense);
+		DVM_CHECK(DVM::Test::BitEqual(parallel.Data(), serial.Data(), n));
+		DVM_CHECK(DVM::Test::BitEqual(parallelProduct.Data(), serialProduct.Data(), serialProduct.Size()));
+	});
+}
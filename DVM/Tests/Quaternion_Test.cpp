@@ -0,0 +1,199 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/Quaternion_Math.h"
+#include "../Headers/Vector_Math.h"
+
+//Products, matrix casts, Slerp and the batch rotations of Quaternion_Math.h. Rotations are compared to a few
+//ULP of the vector length, casts and interpolations to a few ULP of one
+namespace
+{
+	template<typename T>
+	DVM::Quat<T> RandomRotation(uint32_t& seed)
+	{
+		DVM::Quat<T> quat;
+		for (size_t i = 0; i < 4; ++i)
+			quat[i] = DVM::Test::Random<T>(seed, -1., 1.);
+		return DVM::Normalize(quat);
+	}
+
+	template<typename T>
+	DVM::VecTemplate<T, 3> RandomVector(uint32_t& seed)
+	{
+		return DVM::VecTemplate<T, 3>(DVM::Test::Random<T>(seed, -10., 10.), DVM::Test::Random<T>(seed, -10., 10.), DVM::Test::Random<T>(seed, -10., 10.));
+	}
+
+	template<typename T>
+	double Tolerance(double scale) { return 16. * std::numeric_limits<T>::epsilon() * scale; }
+
+	//q and -q are the same rotation
+	template<typename T>
+	bool SameRotation(const DVM::Quat<T>& a, const DVM::Quat<T>& b, double tolerance)
+	{
+		T sign = DVM::Dot(a, b) < T{} ? T(-1) : T(1);
+		for (size_t i = 0; i < 4; ++i)
+			if (!(std::fabs(static_cast<double>(a[i] - sign * b[i])) <= tolerance)) return false;
+		return true;
+	}
+
+	template<typename T>
+	void CheckProduct(DVM::Test::State& state, uint32_t seed)
+	{
+		for (size_t n = 0; n < 1000; ++n)
+		{
+			DVM::Quat<T> a = RandomRotation<T>(seed), b = RandomRotation<T>(seed);
+			DVM::VecTemplate<T, 3> vec = RandomVector<T>(seed);
+
+			//The product rotates by b, then by a
+			DVM::VecTemplate<T, 3> expected = DVM::Rotate(a, DVM::Rotate(b, vec));
+			DVM::VecTemplate<T, 3> actual = DVM::Rotate(a * b, vec);
+			for (size_t i = 0; i < 3; ++i)
+				DVM_CHECK_NEAR(actual[i], expected[i], Tolerance<T>(20.));
+
+			//right aliasing this gives the same as a copy of it
+			DVM::Quat<T> copy = a;
+			DVM::Quat<T> square = a;
+			square *= copy;
+			a *= a;
+			DVM_CHECK(a == square);
+		}
+
+		//Squaring a rotation doubles its angle
+		DVM::VecTemplate<T, 3> axis = DVM::Normalize(DVM::VecTemplate<T, 3>(T(1), T(-2), T(2)));
+		DVM::Quat<T> rotation = DVM::AngleAxis(T(0.7), axis);
+		rotation *= rotation;
+		DVM_CHECK(SameRotation(rotation, DVM::AngleAxis(T(1.4), axis), Tolerance<T>(1.)));
+	}
+
+	template<typename T>
+	void CheckCasts(DVM::Test::State& state, uint32_t seed)
+	{
+		using Vec3 = DVM::VecTemplate<T, 3>;
+
+		//Random rotations mostly have a positive trace, half turns around each axis take the other branches
+		std::vector<DVM::Quat<T>> rotations;
+		for (size_t n = 0; n < 1000; ++n)
+			rotations.push_back(RandomRotation<T>(seed));
+		rotations.push_back(DVM::AngleAxis(T(3.1), Vec3(T(1), T(0), T(0))));
+		rotations.push_back(DVM::AngleAxis(T(3.1), Vec3(T(0), T(1), T(0))));
+		rotations.push_back(DVM::AngleAxis(T(3.1), Vec3(T(0), T(0), T(1))));
+		rotations.push_back(DVM::Quat<T>());
+
+		for (const DVM::Quat<T>& quat : rotations)
+		{
+			DVM::MatTemplate<T, 3, 3> mat = DVM::Mat3Cast(quat);
+			DVM_CHECK(SameRotation(DVM::QuatCast(mat), quat, Tolerance<T>(1.)));
+			DVM_CHECK(SameRotation(DVM::QuatCast(DVM::Mat4Cast(quat)), quat, Tolerance<T>(1.)));
+
+			//mat[j] is column j
+			Vec3 vec = RandomVector<T>(seed);
+			Vec3 expected = DVM::Rotate(quat, vec);
+			for (size_t j = 0; j < 3; ++j)
+				DVM_CHECK_NEAR(mat[0][j] * vec[0] + mat[1][j] * vec[1] + mat[2][j] * vec[2], expected[j], Tolerance<T>(20.));
+		}
+	}
+
+	template<typename T>
+	void CheckSlerp(DVM::Test::State& state, uint32_t seed)
+	{
+		for (size_t n = 0; n < 1000; ++n)
+		{
+			DVM::Quat<T> from = RandomRotation<T>(seed), to = RandomRotation<T>(seed);
+			//Every fourth pair is close enough for the Nlerp branch
+			if (n % 4 == 0)
+				to = DVM::Normalize(from + DVM::Quat<T>(T(1e-3), T(0), T(-1e-3), T(0)));
+
+			DVM_CHECK(SameRotation(DVM::Slerp(from, to, T(0)), from, Tolerance<T>(1.)));
+			DVM_CHECK(SameRotation(DVM::Slerp(from, to, T(1)), to, Tolerance<T>(1.)));
+			DVM_CHECK_NEAR(DVM::Length(DVM::Slerp(from, to, T(0.3))), T(1), Tolerance<T>(1.));
+		}
+
+		//Constant speed along the arc
+		DVM::VecTemplate<T, 3> axis(T(0), T(0.6), T(0.8));
+		DVM_CHECK(SameRotation(DVM::Slerp(DVM::Quat<T>(), DVM::AngleAxis(T(2), axis), T(0.25)), DVM::AngleAxis(T(0.5), axis), Tolerance<T>(1.)));
+
+		std::vector<DVM::Quat<T>> from, to, out(37);
+		std::vector<T> t;
+		for (size_t i = 0; i < out.size(); ++i)
+		{
+			from.push_back(RandomRotation<T>(seed));
+			to.push_back(RandomRotation<T>(seed));
+			t.push_back(DVM::Test::Random<T>(seed, 0., 1.));
+		}
+		DVM::SlerpBatch(from.data(), to.data(), t.data(), out.data(), out.size());
+		for (size_t i = 0; i < out.size(); ++i)
+			DVM_CHECK(out[i] == DVM::Slerp(from[i], to[i], t[i]));
+	}
+
+	//Sizes with a tail after the four-wide SIMD loop, and the rotation done in place
+	template<typename T>
+	void CheckRotateBatch(DVM::Test::State& state, uint32_t seed)
+	{
+		using Vec3 = DVM::VecTemplate<T, 3>;
+		constexpr size_t Count = 1003;
+
+		DVM::Quat<T> single = RandomRotation<T>(seed);
+		std::vector<DVM::Quat<T>> quats;
+		std::vector<Vec3> in, out(Count);
+		for (size_t i = 0; i < Count; ++i)
+		{
+			quats.push_back(RandomRotation<T>(seed));
+			in.push_back(RandomVector<T>(seed));
+		}
+
+		DVM::RotateBatch(single, in.data(), out.data(), Count);
+		for (size_t i = 0; i < Count; ++i)
+		{
+			Vec3 expected = DVM::Rotate(single, in[i]);
+			for (size_t j = 0; j < 3; ++j)
+				DVM_CHECK_NEAR(out[i][j], expected[j], Tolerance<T>(20.));
+		}
+
+		DVM::RotateBatch(quats.data(), in.data(), out.data(), Count);
+		for (size_t i = 0; i < Count; ++i)
+		{
+			Vec3 expected = DVM::Rotate(quats[i], in[i]);
+			for (size_t j = 0; j < 3; ++j)
+				DVM_CHECK_NEAR(out[i][j], expected[j], Tolerance<T>(20.));
+		}
+
+		std::vector<Vec3> inPlace = in;
+		DVM::RotateBatch(quats.data(), inPlace.data(), inPlace.data(), Count);
+		DVM_CHECK(DVM::Test::BitEqual(inPlace[0].data, out[0].data, 3 * Count));
+	}
+}
+
+DVM_TEST(Quaternion_Product)
+{
+	CheckProduct<float>(state, 1u);
+	CheckProduct<double>(state, 2u);
+}
+
+DVM_TEST(Quaternion_Casts)
+{
+	CheckCasts<float>(state, 3u);
+	CheckCasts<double>(state, 4u);
+}
+
+DVM_TEST(Quaternion_Slerp)
+{
+	CheckSlerp<float>(state, 5u);
+	CheckSlerp<double>(state, 6u);
+}
+
+DVM_TEST(Quaternion_RotateBatch)
+{
+	CheckRotateBatch<float>(state, 7u);
+	CheckRotateBatch<double>(state, 8u);
+}
+
+//Also a constant expression
+DVM_TEST(Quaternion_Constexpr)
+{
+	constexpr DVM::Quatf square = [] { DVM::Quatf quat(0.f, 0.6f, 0.f, 0.8f); quat *= quat; return quat; }();
+	constexpr DVM::Quatf expected(0.f, 0.8f * 0.6f + 0.6f * 0.8f, 0.f, 0.8f * 0.8f - 0.6f * 0.6f);
+	DVM_CHECK(square == expected);
+}
@@ -0,0 +1,171 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/DynMatrix_Math.h"
+#include "../Headers/Matrix_Math.h"
+#include "../Headers/Solvers.h"
+
+//Iterative solvers on sparse, dense and fixed size systems. The returned residual is checked against
+//Length(b - mat * x) / Length(b) recomputed here
+namespace
+{
+	//Five point Laplacian of a side x side grid plus shift on the diagonal, symmetric positive definite.
+	//skew adds an antisymmetric part along x, which makes the system nonsymmetric
+	DVM::CsrMatrixd GridMatrix(size_t side, double shift, double skew)
+	{
+		std::vector<DVM::Triplet<double>> triplets;
+		for (size_t y = 0; y < side; ++y)
+			for (size_t x = 0; x < side; ++x)
+			{
+				size_t i = y * side + x;
+				triplets.push_back({ i, i, 4. + shift });
+				if (x > 0) triplets.push_back({ i, i - 1, -1. - skew });
+				if (x + 1 < side) triplets.push_back({ i, i + 1, -1. + skew });
+				if (y > 0) triplets.push_back({ i, i - side, -1. });
+				if (y + 1 < side) triplets.push_back({ i, i + side, -1. });
+			}
+
+		return DVM::CsrMatrixd::FromTriplets(side * side, side * side, triplets.data(), triplets.size());
+	}
+
+	template<typename Matrix>
+	double RelativeResidual(const Matrix& mat, const DVM::DynVectord& b, const DVM::DynVectord& x)
+	{
+		DVM::DynVectord product = DVM::linearTransformation(mat, x);
+		double residual = 0., norm = 0.;
+		for (size_t i = 0; i < b.Size(); ++i)
+		{
+			residual += (b[i] - product[i]) * (b[i] - product[i]);
+			norm += b[i] * b[i];
+		}
+		return std::sqrt(residual / norm);
+	}
+
+	DVM::DynVectord RandomVector(size_t size, uint32_t seed)
+	{
+		DVM::DynVectord result(size);
+		for (size_t i = 0; i < size; ++i)
+			result[i] = DVM::Test::Random<double>(seed, -1., 1.);
+		return result;
+	}
+
+	template<typename Matrix, typename Preconditioner>
+	size_t CheckConjugateGradient(DVM::Test::State& state, const Matrix& mat, const DVM::DynVectord& b, const Preconditioner& preconditioner)
+	{
+		DVM::DynVectord x;
+		DVM::SolverStats<double> stats = DVM::ConjugateGradient(mat, b, x, preconditioner);
+		DVM_CHECK(stats.converged);
+		DVM_CHECK(stats.residual <= 2e-8);
+		DVM_CHECK_NEAR(stats.residual, RelativeResidual(mat, b, x), 1e-12);
+		return stats.iterations;
+	}
+
+	template<typename Matrix, typename Preconditioner>
+	size_t CheckBiCGSTAB(DVM::Test::State& state, const Matrix& mat, const DVM::DynVectord& b, const Preconditioner& preconditioner)
+	{
+		DVM::DynVectord x;
+		DVM::SolverStats<double> stats = DVM::BiCGSTAB(mat, b, x, preconditioner);
+		DVM_CHECK(stats.converged);
+		DVM_CHECK(stats.residual <= 2e-8);
+		DVM_CHECK_NEAR(stats.residual, RelativeResidual(mat, b, x), 1e-12);
+		return stats.iterations;
+	}
+}
+
+DVM_TEST(Solver_ConjugateGradient)
+{
+	DVM::CsrMatrixd mat = GridMatrix(40, 0.01, 0.);
+	DVM::DynVectord b = RandomVector(mat.Rows(), 1u);
+
+	size_t plain = CheckConjugateGradient(state, mat, b, DVM::IdentityPreconditioner());
+	size_t jacobi = CheckConjugateGradient(state, mat, b, DVM::JacobiPreconditioner<double>(mat));
+	size_t cholesky = CheckConjugateGradient(state, mat, b, DVM::IncompleteCholesky<double>(mat));
+
+	//IC(0) is the stronger preconditioner and must save iterations on a Laplacian
+	DVM_CHECK(cholesky < plain);
+	DVM_CHECK(jacobi <= plain);
+
+	//CSC and dense storage of the same matrix
+	CheckConjugateGradient(state, DVM::CscMatrixd(mat), b, DVM::JacobiPreconditioner<double>(mat));
+	DVM::CsrMatrixd small = GridMatrix(8, 0.1, 0.);
+	CheckConjugateGradient(state, DVM::ToDense(small), RandomVector(small.Rows(), 2u), DVM::IncompleteCholesky<double>(small));
+}
+
+DVM_TEST(Solver_BiCGSTAB)
+{
+	DVM::CsrMatrixd mat = GridMatrix(40, 0.01, 0.4);
+	DVM::DynVectord b = RandomVector(mat.Rows(), 3u);
+
+	CheckBiCGSTAB(state, mat, b, DVM::IdentityPreconditioner());
+	CheckBiCGSTAB(state, mat, b, DVM::JacobiPreconditioner<double>(mat));
+	CheckBiCGSTAB(state, DVM::ToDense(mat), b, DVM::JacobiPreconditioner<double>(mat));
+}
+
+DVM_TEST(Solver_WarmStart)
+{
+	DVM::CsrMatrixd mat = GridMatrix(20, 0.01, 0.);
+	DVM::DynVectord b = RandomVector(mat.Rows(), 4u);
+
+	DVM::DynVectord x;
+	DVM::SolverStats<double> cold = DVM::ConjugateGradient(mat, b, x);
+	DVM::SolverStats<double> warm = DVM::ConjugateGradient(mat, b, x);
+	DVM_CHECK(cold.converged && warm.converged);
+	DVM_CHECK(warm.iterations == 0);
+
+	DVM::SolverOptions<double> options;
+	options.maxIterations = 3;
+	DVM::DynVectord limited;
+	DVM::SolverStats<double> stopped = DVM::ConjugateGradient(mat, b, limited, DVM::IdentityPreconditioner(), options);
+	DVM_CHECK(!stopped.converged);
+	DVM_CHECK(stopped.iterations <= 3);
+	DVM_CHECK_NEAR(stopped.residual, RelativeResidual(mat, b, limited), 1e-12);
+}
+
+DVM_TEST(Solver_Fixed)
+{
+	DVM::Mat4d mat;
+	uint32_t seed = 5u;
+	for (size_t i = 0; i < 4; ++i)
+		for (size_t j = 0; j <= i; ++j)
+			mat[i][j] = mat[j][i] = DVM::Test::Random<double>(seed, -0.5, 0.5) + (i == j ? 4. : 0.);
+
+	DVM::Vec4d b(1., -2., 3., -4.);
+	DVM::Vec4d x;
+	DVM::SolverStats<double> stats = DVM::ConjugateGradient(mat, b, x);
+	DVM_CHECK(stats.converged);
+
+	DVM::Vec4d y;
+	DVM_CHECK(DVM::BiCGSTAB(mat, b, y).converged);
+
+	DVM::Vec4d exact = DVM::Solve(mat, b);
+	for (size_t i = 0; i < 4; ++i)
+	{
+		DVM_CHECK_NEAR(x[i], exact[i], 1e-7);
+		DVM_CHECK_NEAR(y[i], exact[i], 1e-7);
+	}
+}
+
+#if defined(DVM_INSTRUMENTATION)
+//The iterations of a solve are counted against the solver, not against whatever call happens to be measured
+DVM_TEST(Solver_Instrumentation)
+{
+	DVM::CsrMatrixd mat = GridMatrix(20, 0.01, 0.4);
+	DVM::DynVectord b = RandomVector(mat.Rows(), 6u);
+
+	DVM::Instrumentation::Reset();
+	DVM::DynVectord x, y;
+	size_t iterations = DVM::ConjugateGradient(mat, b, x).iterations + DVM::BiCGSTAB(mat, b, y).iterations;
+
+	size_t calls = 0, counted = 0;
+	for (const DVM::Instrumentation::Entry& entry : DVM::Instrumentation::Snapshot())
+		if (std::strstr(entry.function, "ConjugateGradient(") || std::strstr(entry.function, "BiCGSTAB("))
+		{
+			calls += entry.calls;
+			counted += entry.iterations;
+		}
+	DVM_CHECK(calls == 2 && counted == iterations);
+}
+#endif
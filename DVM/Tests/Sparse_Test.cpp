@@ -0,0 +1,131 @@
+#include <cstdint>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/DynMatrix_Math.h"
+#include "../Headers/SparseMatrix_Math.h"
+
+//Assembly from triplets, layout conversions and products against the same matrix held dense.
+//Values are small integers, so every sum is exact and results compare bit for bit
+namespace
+{
+	constexpr size_t Rows = 37;
+	constexpr size_t Columns = 23;
+
+	//Random entries with repeated coordinates and explicit zeros, in no particular order
+	std::vector<DVM::Triplet<double>> RandomTriplets(uint32_t seed)
+	{
+		std::vector<DVM::Triplet<double>> triplets;
+		for (size_t t = 0; t < 300; ++t)
+		{
+			size_t row = static_cast<size_t>(DVM::Test::RandomInteger<int>(seed, 0, Rows - 1));
+			size_t column = static_cast<size_t>(DVM::Test::RandomInteger<int>(seed, 0, Columns - 1));
+			triplets.push_back({ row, column, DVM::Test::RandomInteger<double>(seed, -4, 4) });
+		}
+		return triplets;
+	}
+
+	//dense[j][i] is (i, j), as linearTransformation reads it
+	DVM::DynMatrixd DenseFromTriplets(const std::vector<DVM::Triplet<double>>& triplets)
+	{
+		DVM::DynMatrixd dense(Columns, Rows);
+		for (const DVM::Triplet<double>& triplet : triplets)
+			dense[triplet.column][triplet.row] += triplet.value;
+		return dense;
+	}
+
+	template<DVM::SparseLayout Layout>
+	bool SortedUnique(const DVM::SparseMatrix<double, Layout>& mat)
+	{
+		for (size_t i = 0; i < mat.MajorCount(); ++i)
+			for (size_t p = mat.Starts()[i] + 1; p < mat.Starts()[i + 1]; ++p)
+				if (mat.Indices()[p - 1] >= mat.Indices()[p]) return false;
+		return mat.Starts()[mat.MajorCount()] == mat.NonZeros();
+	}
+
+	template<DVM::SparseLayout Layout>
+	void CheckLayout(DVM::Test::State& state)
+	{
+		std::vector<DVM::Triplet<double>> triplets = RandomTriplets(Layout == DVM::SparseLayout::Csr ? 1u : 2u);
+		DVM::DynMatrixd dense = DenseFromTriplets(triplets);
+		DVM::SparseMatrix<double, Layout> mat = DVM::SparseMatrix<double, Layout>::FromTriplets(Rows, Columns, triplets.data(), triplets.size());
+
+		DVM_CHECK(mat.Rows() == Rows && mat.Columns() == Columns);
+		DVM_CHECK(SortedUnique(mat));
+
+		DVM::DynMatrixd back = DVM::ToDense(mat);
+		DVM_CHECK(DVM::Test::BitEqual(back.Data(), dense.Data(), dense.Size()));
+
+		bool lookup = true;
+		for (size_t i = 0; i < Rows; ++i)
+			for (size_t j = 0; j < Columns; ++j)
+				lookup = lookup && mat(i, j) == dense[j][i];
+		DVM_CHECK(lookup);
+
+		//Duplicates summing to zero may stay stored, the dense constructor keeps only non-zeros
+		DVM::SparseMatrix<double, Layout> fromDense(dense);
+		DVM_CHECK(fromDense.NonZeros() <= mat.NonZeros());
+		DVM_CHECK(DVM::Test::BitEqual(DVM::ToDense(fromDense).Data(), dense.Data(), dense.Size()));
+
+		DVM::DynVectord vec(Columns);
+		uint32_t seed = 3u;
+		for (size_t j = 0; j < Columns; ++j)
+			vec[j] = DVM::Test::RandomInteger<double>(seed, -9, 9);
+
+		DVM::DynVectord expected = DVM::linearTransformation(dense, vec);
+		DVM_CHECK(DVM::Test::BitEqual(DVM::linearTransformation(mat, vec).Data(), expected.Data(), Rows));
+
+		DVM::DynMatrixd operand(4, Columns);
+		for (size_t i = 0; i < operand.Size(); ++i)
+			operand.Data()[i] = DVM::Test::RandomInteger<double>(seed, -9, 9);
+
+		DVM::DynMatrixd product = DVM::matrixMultiplication(mat, operand);
+		bool columns = product.Columns() == 4 && product.Rows() == Rows;
+		for (size_t j = 0; columns && j < 4; ++j)
+		{
+			DVM::DynVectord column(operand[j], Columns);
+			columns = DVM::Test::BitEqual(product[j], DVM::linearTransformation(dense, column).Data(), Rows);
+		}
+		DVM_CHECK(columns);
+
+		DVM::SparseMatrix<double, Layout> transpose = DVM::Transpose(mat);
+		DVM_CHECK(transpose.Rows() == Columns && transpose.Columns() == Rows);
+		DVM_CHECK(SortedUnique(transpose));
+		DVM_CHECK(DVM::Test::BitEqual(DVM::ToDense(transpose).Data(), DVM::Transpose(dense).Data(), dense.Size()));
+	}
+}
+
+DVM_TEST(Sparse_Csr)
+{
+	CheckLayout<DVM::SparseLayout::Csr>(state);
+}
+
+DVM_TEST(Sparse_Csc)
+{
+	CheckLayout<DVM::SparseLayout::Csc>(state);
+}
+
+DVM_TEST(Sparse_Conversion)
+{
+	std::vector<DVM::Triplet<double>> triplets = RandomTriplets(4u);
+	DVM::CsrMatrixd csr = DVM::CsrMatrixd::FromTriplets(Rows, Columns, triplets.data(), triplets.size());
+	DVM::CscMatrixd csc(csr);
+	DVM::CsrMatrixd back(csc);
+
+	DVM_CHECK(csc.NonZeros() == csr.NonZeros() && back.NonZeros() == csr.NonZeros());
+	DVM_CHECK(SortedUnique(csc) && SortedUnique(back));
+	DVM_CHECK(DVM::Test::BitEqual(back.Starts(), csr.Starts(), Rows + 1));
+	DVM_CHECK(DVM::Test::BitEqual(back.Indices(), csr.Indices(), csr.NonZeros()));
+	DVM_CHECK(DVM::Test::BitEqual(back.Values(), csr.Values(), csr.NonZeros()));
+	DVM_CHECK(DVM::Test::BitEqual(DVM::ToDense(csc).Data(), DVM::ToDense(csr).Data(), Rows * Columns));
+}
+
+DVM_TEST(Sparse_Empty)
+{
+	DVM::CsrMatrixd mat = DVM::CsrMatrixd::FromTriplets(5, 3, nullptr, 0);
+	DVM_CHECK(mat.NonZeros() == 0 && mat.Rows() == 5 && mat.Columns() == 3);
+
+	DVM::DynVectord result = DVM::linearTransformation(mat, DVM::DynVectord(3, 1.));
+	DVM_CHECK(result.Size() == 5 && result[0] == 0. && result[4] == 0.);
+	DVM_CHECK(mat(4, 2) == 0.);
+}
@@ -0,0 +1,127 @@
+#ifndef DVM_TEST_H
+#define DVM_TEST_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace DVM
+{
+	namespace Test
+	{
+		struct State
+		{
+			size_t checks = 0;
+			size_t failures = 0;
+			//The first few failures, a broken loop over a million inputs reports ten
+			std::vector<std::string> messages;
+
+			void Fail(const char* file, int line, const std::string& message)
+			{
+				if (failures++ < 10)
+					messages.push_back(std::string(file) + ":" + std::to_string(line) + ": " + message);
+			}
+		};
+
+		using Function = std::function<void(State&)>;
+
+		struct TestCase
+		{
+			std::string name;
+			Function function;
+		};
+
+		inline std::vector<TestCase>& Registry()
+		{
+			static std::vector<TestCase> tests;
+			return tests;
+		}
+
+		struct Registrar
+		{
+			Registrar(const char* name, Function function) { Registry().push_back({ name, function }); }
+		};
+
+		//Uniform value in [low, high) from a linear congruential generator, so inputs are the same on every run
+		template<typename T>
+		inline T Random(uint32_t& seed, double low, double high)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			return static_cast<T>(low + (high - low) * (seed / 4294967296.));
+		}
+
+		//Integer in [low, high] as T, products and sums of small integers are exact in floating point
+		template<typename T>
+		inline T RandomInteger(uint32_t& seed, int low, int high)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			return static_cast<T>(low + static_cast<int>((seed >> 8) % static_cast<uint32_t>(high - low + 1)));
+		}
+
+		//Bit patterns ordered like the values they encode, negative values mirrored below zero
+		inline int64_t OrderedBits(float value)
+		{
+			int32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? -static_cast<int64_t>(bits & 0x7FFFFFFF) : bits;
+		}
+
+		inline int64_t OrderedBits(double value)
+		{
+			int64_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits < 0 ? -(bits & 0x7FFFFFFFFFFFFFFFLL) : bits;
+		}
+
+		//Distance in units in the last place, 0 for equal values and for two NaNs
+		template<typename T>
+		inline double UlpDistance(T a, T b)
+		{
+			if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b) ? 0. : 1e300;
+			return std::fabs(static_cast<double>(OrderedBits(a) - OrderedBits(b)));
+		}
+
+		template<typename T>
+		inline bool BitEqual(const T* a, const T* b, size_t count) { return std::memcmp(a, b, count * sizeof(T)) == 0; }
+
+		inline std::string Format(const char* format, double a, double b)
+		{
+			char buffer[256];
+			std::snprintf(buffer, sizeof(buffer), format, a, b);
+			return buffer;
+		}
+	}
+}
+
+#define DVM_TEST(name)																	\
+	static void name(DVM::Test::State& state);											\
+	static DVM::Test::Registrar name##_registrar(#name, name);							\
+	static void name(DVM::Test::State& state)
+
+#define DVM_CHECK(condition)															\
+	do { ++state.checks; if (!(condition)) state.Fail(__FILE__, __LINE__, #condition); } while (false)
+
+//|actual - expected| <= tolerance, both values are printed on failure
+#define DVM_CHECK_NEAR(actual, expected, tolerance)										\
+	do {																				\
+		++state.checks;																	\
+		double dvmActual = static_cast<double>(actual), dvmExpected = static_cast<double>(expected);	\
+		if (!(std::fabs(dvmActual - dvmExpected) <= static_cast<double>(tolerance)))	\
+			state.Fail(__FILE__, __LINE__, DVM::Test::Format(#actual " = %.17g, expected %.17g", dvmActual, dvmExpected));	\
+	} while (false)
+
+//actual is at most ulps units in the last place away from expected
+#define DVM_CHECK_ULP(actual, expected, ulps)											\
+	do {																				\
+		++state.checks;																	\
+		auto dvmActual = (actual);														\
+		decltype(dvmActual) dvmExpected = (expected);									\
+		if (!(DVM::Test::UlpDistance(dvmActual, dvmExpected) <= static_cast<double>(ulps)))	\
+			state.Fail(__FILE__, __LINE__, DVM::Test::Format(#actual " = %.17g, expected %.17g", static_cast<double>(dvmActual), static_cast<double>(dvmExpected)));	\
+	} while (false)
+
+#endif // !DVM_TEST_H
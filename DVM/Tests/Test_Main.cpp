@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "Test.h"
+
+//Build: the DVM_Tests target of the CMake project, or g++ -std=c++17 -O2 -pthread Tests/*.cpp -o DVM_Tests (from the DVM directory)
+//Usage: DVM_Tests [--filter=prefix] [--list]
+//Runs every test whose name starts with prefix, prints the failed checks and exits with 1 if any failed.
+//CTest runs one prefix per test file, see CMakeLists.txt
+int main(int argc, char** argv)
+{
+	const char* filter = "";
+	bool list = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!std::strncmp(argv[i], "--filter=", 9)) filter = argv[i] + 9;
+		else if (!std::strcmp(argv[i], "--list")) list = true;
+		else
+		{
+			std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	size_t run = 0;
+	size_t failed = 0;
+
+	for (const DVM::Test::TestCase& test : DVM::Test::Registry())
+	{
+		if (std::strncmp(test.name.c_str(), filter, std::strlen(filter))) continue;
+
+		if (list)
+		{
+			std::printf("%s\n", test.name.c_str());
+			continue;
+		}
+
+		std::printf("%-56s", test.name.c_str());
+		std::fflush(stdout);
+
+		DVM::Test::State state;
+		test.function(state);
+		++run;
+
+		if (state.failures)
+		{
+			++failed;
+			std::printf("FAILED %zu of %zu checks\n", state.failures, state.checks);
+			for (const std::string& message : state.messages)
+				std::printf("  %s\n", message.c_str());
+		}
+		else
+			std::printf("ok %zu checks\n", state.checks);
+	}
+
+	if (list) return 0;
+
+	if (run == 0)
+	{
+		std::fprintf(stderr, "no test matches %s\n", filter);
+		return 1;
+	}
+
+	std::printf("%zu of %zu tests passed\n", run - failed, run);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/VecArray_Math.h"
+#include "../Headers/Vector_Math.h"
+
+//Storage invariants of VecArray and every kernel of VecArray_Math.h against the single vector function applied
+//element by element. Sizes leave a tail after both the cache line and the kernels' chunk of 256, and each kernel
+//is also run with the result aliasing an input. Compilers may contract a * b + c differently in the two loops,
+//so arithmetic results are compared to a few ULP of their magnitude
+namespace
+{
+	constexpr size_t Count = 1000;
+
+	template<typename T, size_t N>
+	std::vector<DVM::VecTemplate<T, N>> RandomVectors(size_t count, uint32_t seed, double low, double high)
+	{
+		std::vector<DVM::VecTemplate<T, N>> result(count);
+		for (DVM::VecTemplate<T, N>& vec : result)
+			for (size_t c = 0; c < N; ++c)
+				vec[c] = DVM::Test::Random<T>(seed, low, high);
+		return result;
+	}
+
+	template<typename T, size_t N>
+	void CheckVectors(DVM::Test::State& state, const DVM::VecArray<T, N>& actual, const std::vector<DVM::VecTemplate<T, N>>& expected, double scale)
+	{
+		DVM_CHECK(actual.Size() == expected.size());
+		double tolerance = 8. * std::numeric_limits<T>::epsilon() * scale;
+		size_t mismatches = 0;
+		for (size_t i = 0; i < expected.size() && actual.Size() == expected.size(); ++i)
+			for (size_t c = 0; c < N; ++c)
+				mismatches += !(std::fabs(static_cast<double>(actual.Stream(c)[i]) - expected[i][c]) <= tolerance);
+		DVM_CHECK(mismatches == 0);
+	}
+
+	template<typename T, size_t N>
+	void CheckStorage(DVM::Test::State& state)
+	{
+		using Array = DVM::VecArray<T, N>;
+		std::vector<DVM::VecTemplate<T, N>> values = RandomVectors<T, N>(Count, 1u, -10., 10.);
+
+		Array array(values.data(), values.size());
+		DVM_CHECK(array.Size() == Count && array.PaddedSize() % Array::Lanes == 0 && array.PaddedSize() >= Count);
+
+		bool aligned = true, padded = true;
+		for (size_t c = 0; c < N; ++c)
+		{
+			aligned = aligned && reinterpret_cast<uintptr_t>(array.Stream(c)) % DVTL::CacheLineSize == 0;
+			for (size_t i = Count; i < array.PaddedSize(); ++i)
+				padded = padded && array.Stream(c)[i] == T{};
+		}
+		DVM_CHECK(aligned && padded);
+
+		std::vector<DVM::VecTemplate<T, N>> back(Count);
+		array.Store(back.data());
+		DVM_CHECK(DVM::Test::BitEqual(back.data(), values.data(), Count));
+		DVM_CHECK(DVM::Test::BitEqual(array.Get(Count - 1).data, values.back().data, N));
+
+		array.Set(3, values[7]);
+		DVM_CHECK(DVM::Test::BitEqual(array.Get(3).data, values[7].data, N));
+		array.Set(3, values[3]);
+
+		//Copies are deep, moves leave the source empty
+		Array copy(array);
+		copy.Set(0, DVM::VecTemplate<T, N>(T(99)));
+		DVM_CHECK(DVM::Test::BitEqual(array.Get(0).data, values[0].data, N));
+
+		Array moved(DVTL::Move(copy));
+		DVM_CHECK(moved.Size() == Count && copy.Size() == 0 && moved.Get(0)[0] == T(99));
+
+		Array& self = moved;
+		moved = self;
+		DVM_CHECK(moved.Size() == Count && moved.Get(0)[0] == T(99));
+
+		//Growing keeps the values, elements past the old size are zero even after a shrink
+		array.Resize(10);
+		array.Reserve(5000);
+		array.Resize(Count + 100);
+		bool kept = DVM::Test::BitEqual(array.Get(9).data, values[9].data, N);
+		bool zero = true;
+		for (size_t i = 10; i < array.PaddedSize(); ++i)
+			for (size_t c = 0; c < N; ++c)
+				zero = zero && array.Stream(c)[i] == T{};
+		DVM_CHECK(kept && zero && array.Capacity() >= 5000);
+
+		Array empty(0);
+		DVM_CHECK(empty.Size() == 0 && empty.PaddedSize() == 0);
+	}
+
+	template<typename T, size_t N>
+	void CheckKernels(DVM::Test::State& state, uint32_t seed)
+	{
+		using Vec = DVM::VecTemplate<T, N>;
+		using Array = DVM::VecArray<T, N>;
+
+		std::vector<Vec> a = RandomVectors<T, N>(Count, seed, -10., 10.);
+		std::vector<Vec> b = RandomVectors<T, N>(Count, seed + 1, -10., 10.);
+		std::vector<Vec> normals = RandomVectors<T, N>(Count, seed + 2, -1., 1.);
+		for (Vec& normal : normals)
+			normal = DVM::Normalize(normal);
+		a[5] = Vec();
+
+		Array x(a.data(), Count), y(b.data(), Count), n(normals.data(), Count), result;
+		std::vector<Vec> expected(Count);
+
+		DVM::Abs(x, result);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Abs(a[i]);
+		CheckVectors(state, result, expected, 0.);
+
+		DVM::Min(x, T(1), result);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Min(a[i], T(1));
+		CheckVectors(state, result, expected, 0.);
+
+		DVM::Max(x, y, result);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Max(a[i], b[i]);
+		CheckVectors(state, result, expected, 0.);
+
+		DVM::Clamp(x, T(-2), T(3), result);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Clamp(a[i], T(-2), T(3));
+		CheckVectors(state, result, expected, 0.);
+
+		DVM::Mix(x, y, T(0.25), result);
+		for (size_t i = 0; i < Count; ++i)
+			for (size_t c = 0; c < N; ++c)
+				expected[i][c] = DVM::Mix(a[i][c], b[i][c], T(0.25));
+		CheckVectors(state, result, expected, 10.);
+
+		std::vector<T> scalars(Count);
+		DVM::Dot(x, y, scalars.data());
+		for (size_t i = 0; i < Count; ++i)
+			DVM_CHECK_NEAR(scalars[i], DVM::Dot(a[i], b[i]), 8. * std::numeric_limits<T>::epsilon() * 100. * N);
+
+		DVM::Length(x, scalars.data());
+		for (size_t i = 0; i < Count; ++i)
+			DVM_CHECK_NEAR(scalars[i], DVM::Length(a[i]), 8. * std::numeric_limits<T>::epsilon() * 10. * N);
+
+		DVM::Distance(x, y, scalars.data());
+		for (size_t i = 0; i < Count; ++i)
+			DVM_CHECK_NEAR(scalars[i], DVM::Distance(a[i], b[i]), 8. * std::numeric_limits<T>::epsilon() * 20. * N);
+
+		DVM::Normalize(x, result);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Normalize(a[i]);
+		CheckVectors(state, result, expected, 1.);
+
+		DVM::Reflect(x, n, result);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Reflect(a[i], normals[i]);
+		CheckVectors(state, result, expected, 10. * N);
+
+		//eta above 1 leaves part of the inputs in total internal reflection
+		Array unit;
+		DVM::Normalize(x, unit);
+		std::vector<Vec> units(Count);
+		unit.Store(units.data());
+		DVM::Refract(unit, n, T(1.3), result);
+		size_t reflected = 0;
+		for (size_t i = 0; i < Count; ++i)
+		{
+			expected[i] = DVM::Refract(units[i], normals[i], T(1.3));
+			reflected += DVM::Dot(expected[i], expected[i]) == T(0);
+		}
+		CheckVectors(state, result, expected, 4.);
+		DVM_CHECK(reflected > 0 && reflected < Count);
+
+		//The result may be an input
+		Array inPlace(x);
+		DVM::Normalize(inPlace, inPlace);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Normalize(a[i]);
+		CheckVectors(state, inPlace, expected, 1.);
+
+		inPlace = x;
+		DVM::Reflect(inPlace, n, inPlace);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Reflect(a[i], normals[i]);
+		CheckVectors(state, inPlace, expected, 10. * N);
+	}
+
+	template<typename T>
+	void CheckCross(DVM::Test::State& state, uint32_t seed)
+	{
+		std::vector<DVM::VecTemplate<T, 3>> a = RandomVectors<T, 3>(Count, seed, -10., 10.);
+		std::vector<DVM::VecTemplate<T, 3>> b = RandomVectors<T, 3>(Count, seed + 1, -10., 10.);
+		std::vector<DVM::VecTemplate<T, 3>> expected(Count);
+		for (size_t i = 0; i < Count; ++i) expected[i] = DVM::Cross(a[i], b[i]);
+
+		DVM::VecArray<T, 3> x(a.data(), Count), y(b.data(), Count), result;
+		DVM::Cross(x, y, result);
+		CheckVectors(state, result, expected, 200.);
+
+		DVM::Cross(x, y, x);
+		CheckVectors(state, x, expected, 200.);
+	}
+}
+
+DVM_TEST(VecArray_Storage)
+{
+	CheckStorage<float, 3>(state);
+	CheckStorage<double, 4>(state);
+	CheckStorage<float, 2>(state);
+}
+
+DVM_TEST(VecArray_Kernels)
+{
+	CheckKernels<float, 3>(state, 10u);
+	CheckKernels<float, 4>(state, 20u);
+	CheckKernels<double, 2>(state, 30u);
+	CheckKernels<double, 3>(state, 40u);
+}
+
+DVM_TEST(VecArray_Cross)
+{
+	CheckCross<float>(state, 50u);
+	CheckCross<double>(state, 60u);
+}
@@ -0,0 +1,156 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Test.h"
+#include "../Headers/Vector_Math.h"
+
+//The SSE/AVX specializations of Vec4f, Vec4d and Vec3f against the same operations written out per component.
+//Every lane is one IEEE operation either way, so compound operators compare bit for bit; Dot, length and
+//Normalize sum in a different order and are checked to a few ULP of the sum of the absolute products
+namespace
+{
+	template<typename T, size_t N>
+	DVM::VecTemplate<T, N> RandomVector(uint32_t& seed, double low, double high)
+	{
+		DVM::VecTemplate<T, N> result;
+		for (size_t i = 0; i < N; ++i)
+			result[i] = DVM::Test::Random<T>(seed, low, high);
+		return result;
+	}
+
+	template<typename T, size_t N>
+	bool Same(const DVM::VecTemplate<T, N>& a, const DVM::VecTemplate<T, N>& b) { return DVM::Test::BitEqual(a.data, b.data, N); }
+
+	template<typename T, size_t N, typename Operation>
+	bool Componentwise(const DVM::VecTemplate<T, N>& result, const DVM::VecTemplate<T, N>& a, const DVM::VecTemplate<T, N>& b, Operation operation)
+	{
+		for (size_t i = 0; i < N; ++i)
+		{
+			volatile T expected = operation(a[i], b[i]);
+			if (!DVM::Test::BitEqual(&result[i], const_cast<const T*>(&expected), 1)) return false;
+		}
+		return true;
+	}
+
+	template<typename T, size_t N>
+	void CheckOperators(DVM::Test::State& state, uint32_t seed)
+	{
+		using Vec = DVM::VecTemplate<T, N>;
+		size_t mismatches = 0;
+		for (size_t n = 0; n < 1000; ++n)
+		{
+			Vec a = RandomVector<T, N>(seed, -1e3, 1e3);
+			Vec b = RandomVector<T, N>(seed, 0.5, 1e3);
+			T s = DVM::Test::Random<T>(seed, -1e2, 1e2);
+			Vec scalar(s);
+
+			Vec r = a; r += b;	mismatches += !Componentwise(r, a, b, [](T x, T y) { return x + y; });
+			r = a; r -= b;		mismatches += !Componentwise(r, a, b, [](T x, T y) { return x - y; });
+			r = a; r *= b;		mismatches += !Componentwise(r, a, b, [](T x, T y) { return x * y; });
+			r = a; r /= b;		mismatches += !Componentwise(r, a, b, [](T x, T y) { return x / y; });
+			r = a; r += s;		mismatches += !Componentwise(r, a, scalar, [](T x, T y) { return x + y; });
+			r = a; r -= s;		mismatches += !Componentwise(r, a, scalar, [](T x, T y) { return x - y; });
+			r = a; r *= s;		mismatches += !Componentwise(r, a, scalar, [](T x, T y) { return x * y; });
+			r = a; r /= s;		mismatches += !Componentwise(r, a, scalar, [](T x, T y) { return x / y; });
+
+			r = a + b;			mismatches += !Componentwise(r, a, b, [](T x, T y) { return x + y; });
+			r = a * s;			mismatches += !Componentwise(r, a, scalar, [](T x, T y) { return x * y; });
+		}
+		DVM_CHECK(mismatches == 0);
+	}
+
+	template<typename T, size_t N>
+	void CheckReductions(DVM::Test::State& state, uint32_t seed)
+	{
+		using Vec = DVM::VecTemplate<T, N>;
+		T epsilon = std::numeric_limits<T>::epsilon();
+		for (size_t n = 0; n < 1000; ++n)
+		{
+			Vec a = RandomVector<T, N>(seed, -1e3, 1e3);
+			Vec b = RandomVector<T, N>(seed, -1e3, 1e3);
+
+			double dot = 0., magnitude = 0., square = 0.;
+			for (size_t i = 0; i < N; ++i)
+			{
+				dot += static_cast<double>(a[i]) * b[i];
+				magnitude += std::fabs(static_cast<double>(a[i]) * b[i]);
+				square += static_cast<double>(a[i]) * a[i];
+			}
+
+			DVM_CHECK_NEAR(DVM::Dot(a, b), dot, 4. * epsilon * magnitude);
+			DVM_CHECK_NEAR(a.length(), std::sqrt(square), 4. * epsilon * std::sqrt(square));
+			DVM_CHECK_NEAR(DVM::Length(a), std::sqrt(square), 4. * epsilon * std::sqrt(square));
+
+			Vec unit = DVM::Normalize(a);
+			for (size_t i = 0; i < N; ++i)
+				DVM_CHECK_NEAR(unit[i], a[i] / std::sqrt(square), 4. * epsilon);
+		}
+
+		DVM_CHECK(Same(DVM::Normalize(Vec()), Vec()));
+	}
+
+	//Evaluated by the compiler this takes the loops, at runtime the intrinsics
+	template<typename Vec>
+	constexpr Vec Sequence()
+	{
+		Vec result;
+		for (size_t i = 0; i < sizeof(Vec) / sizeof(result[0]); ++i)
+			result[i] = static_cast<decltype(result[0] + 0)>(i + 1);
+		result *= Vec(3);
+		result += 0.5f;
+		result -= Vec(1);
+		result /= 2.f;
+		return result;
+	}
+}
+
+DVM_TEST(Vector_Layout)
+{
+	DVM_CHECK(alignof(DVM::Vec4f) == 16 && sizeof(DVM::Vec4f) == 16);
+	DVM_CHECK(alignof(DVM::Vec4d) == 32 && sizeof(DVM::Vec4d) == 32);
+	DVM_CHECK(sizeof(DVM::Vec3f) == 12);
+}
+
+DVM_TEST(Vector_Operators)
+{
+	CheckOperators<float, 4>(state, 1u);
+	CheckOperators<double, 4>(state, 2u);
+	CheckOperators<float, 3>(state, 3u);
+	CheckOperators<double, 3>(state, 4u);
+}
+
+DVM_TEST(Vector_Reductions)
+{
+	CheckReductions<float, 4>(state, 5u);
+	CheckReductions<double, 4>(state, 6u);
+	CheckReductions<float, 3>(state, 7u);
+
+	DVM::Vec3f cross = DVM::Cross(DVM::Vec3f(1.f, 2.f, 3.f), DVM::Vec3f(-4.f, 5.f, 0.5f));
+	DVM_CHECK(Same(cross, DVM::Vec3f(2.f * 0.5f - 3.f * 5.f, 3.f * -4.f - 1.f * 0.5f, 1.f * 5.f - 2.f * -4.f)));
+}
+
+//Vec3f loads three lanes, the last vector of an array must not read past its end (checked under ASan)
+DVM_TEST(Vector_Vec3f_Tail)
+{
+	std::vector<DVM::Vec3f> points(7, DVM::Vec3f(2.f, 3.f, 6.f));
+	DVM_CHECK(points.back().length() == 7.f);
+	DVM_CHECK(DVM::Dot(points.back(), points.front()) == 49.f);
+	DVM_CHECK(Same(DVM::Normalize(points.back()), DVM::Vec3f(2.f / 7.f, 3.f / 7.f, 6.f / 7.f)));
+}
+
+DVM_TEST(Vector_Constexpr)
+{
+	constexpr DVM::Vec4f compiled = Sequence<DVM::Vec4f>();
+	constexpr DVM::Vec4d compiledDouble = Sequence<DVM::Vec4d>();
+	DVM::Vec4f runtime = Sequence<DVM::Vec4f>();
+	DVM::Vec4d runtimeDouble = Sequence<DVM::Vec4d>();
+
+	DVM_CHECK(DVM::Test::BitEqual(compiled.data, runtime.data, 4));
+	DVM_CHECK(DVM::Test::BitEqual(compiledDouble.data, runtimeDouble.data, 4));
+	DVM_CHECK(Same(compiled, DVM::Vec4f(1.25f, 2.75f, 4.25f, 5.75f)));
+
+	constexpr float length = DVM::Vec4f(1.f, 2.f, 2.f, 4.f).length();
+	DVM_CHECK(length == 5.f);
+}